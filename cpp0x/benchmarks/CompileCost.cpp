@@ -0,0 +1,234 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+//compile-time cost of expression templates: generated translation units by algebra dimension, operand density and expression depth,
+//compiled by the compiler of the build, with wall time, peak memory of the compiler and number of instantiated gaalet class templates
+//usage: CompileCost [--filter text] [--max-dimension n] [--max-depth n] [--timeout s] [--flags "compiler flags"] [--dir path] [--csv file]
+
+#ifndef GAALET_CXX_COMPILER
+#define GAALET_CXX_COMPILER "c++"
+#endif
+#ifndef GAALET_INCLUDE_DIR
+#define GAALET_INCLUDE_DIR "../../include/cpp0x"
+#endif
+
+struct case_t
+{
+   std::string name;
+   unsigned int p;
+   unsigned int q;
+   std::string density;
+   unsigned int depth;
+   std::string source;
+};
+
+struct result_t
+{
+   std::string status;
+   double wall;
+   long peak_rss;
+   long instantiations;
+};
+
+//blades of operands: vector (grade 1), even (even grades) or full multivector
+std::vector<unsigned int> blades(unsigned int dimension, const std::string& density)
+{
+   std::vector<unsigned int> b;
+   for(unsigned int bitmap = 0; bitmap < (1u<<dimension); ++bitmap) {
+      const unsigned int grade = __builtin_popcount(bitmap);
+      if((density=="vector" && grade==1) || (density=="even" && grade%2==0) || density=="full") {
+         b.push_back(bitmap);
+      }
+   }
+   return b;
+}
+
+//translation unit: operands a, b and depth geometric products a*b*a*..., evaluated to a multivector
+std::string source(unsigned int p, unsigned int q, const std::string& density, unsigned int depth)
+{
+   std::ostringstream os;
+   os << "#include \"gaalet.h\"\n";
+   if(depth==0) {
+      return os.str();
+   }
+   os << "typedef gaalet::algebra<gaalet::signature<" << p << "," << q << ">> alg;\n";
+   os << "typedef alg::mv<";
+   const std::vector<unsigned int> b = blades(p+q, density);
+   for(std::size_t i = 0; i < b.size(); ++i) {
+      os << ((i==0) ? "" : ", ") << "0x" << std::hex << b[i] << std::dec;
+   }
+   os << ">::type operand_t;\n";
+   os << "void f(const operand_t& a, const operand_t& b, double* out) {\n";
+   os << "   auto r = eval(a";
+   for(unsigned int i = 0; i < depth; ++i) {
+      os << ((i%2==0) ? "*b" : "*a");
+   }
+   os << ");\n";
+   os << "   out[0] = r.element<0x00>();\n";
+   os << "}\n";
+   return os.str();
+}
+
+//gaalet class templates laid out by the compiler (class hierarchy dump of GCC, -1 otherwise)
+long count_instantiations(const std::string& dump)
+{
+   std::ifstream in(dump.c_str());
+   if(!in) {
+      return -1;
+   }
+   long count = 0;
+   std::string line;
+   while(std::getline(in, line)) {
+      if(line.compare(0, 14, "Class gaalet::")==0 && line.find('<')!=std::string::npos) {
+         ++count;
+      }
+   }
+   return count;
+}
+
+//compiler run of argument list with timeout in seconds: wall time, peak resident set size in kilobytes
+result_t compile(const std::vector<std::string>& args, double timeout)
+{
+   result_t r = { "error", 0.0, 0, -1 };
+   std::vector<char*> argv;
+   for(std::size_t i = 0; i < args.size(); ++i) {
+      argv.push_back(const_cast<char*>(args[i].c_str()));
+   }
+   argv.push_back(0);
+
+   const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   const pid_t pid = fork();
+   if(pid < 0) {
+      return r;
+   }
+   if(pid == 0) {
+      //diagnostics of failing cases not of interest
+      if(!std::freopen("/dev/null", "w", stderr)) _exit(127);
+      execvp(argv[0], &argv[0]);
+      _exit(127);
+   }
+
+   int status = 0;
+   struct rusage usage;
+   for(;;) {
+      const pid_t w = wait4(pid, &status, WNOHANG, &usage);
+      r.wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if(w == pid) {
+         break;
+      }
+      if(w < 0) {
+         return r;
+      }
+      if(r.wall > timeout) {
+         kill(pid, SIGKILL);
+         wait4(pid, &status, 0, &usage);
+         r.status = "timeout";
+         r.peak_rss = usage.ru_maxrss;
+         return r;
+      }
+      usleep(5000);
+   }
+   r.peak_rss = usage.ru_maxrss;
+   r.status = (WIFEXITED(status) && WEXITSTATUS(status)==0) ? "ok" : "error";
+   return r;
+}
+
+int main(int argc, char** argv)
+{
+   std::string filter;
+   unsigned int max_dimension = 7;
+   unsigned int max_depth = 3;
+   double timeout = 120.0;
+   std::string flags;
+   std::string dir = "compile_cost";
+   const char* csv = 0;
+   for(int i = 1; i < argc; ++i) {
+      if(!std::strcmp(argv[i], "--filter") && i+1 < argc) filter = argv[++i];
+      else if(!std::strcmp(argv[i], "--max-dimension") && i+1 < argc) max_dimension = std::strtoul(argv[++i], 0, 10);
+      else if(!std::strcmp(argv[i], "--max-depth") && i+1 < argc) max_depth = std::strtoul(argv[++i], 0, 10);
+      else if(!std::strcmp(argv[i], "--timeout") && i+1 < argc) timeout = std::atof(argv[++i]);
+      else if(!std::strcmp(argv[i], "--flags") && i+1 < argc) flags = argv[++i];
+      else if(!std::strcmp(argv[i], "--dir") && i+1 < argc) dir = argv[++i];
+      else if(!std::strcmp(argv[i], "--csv") && i+1 < argc) csv = argv[++i];
+      else {
+         std::cerr << "usage: " << argv[0] << " [--filter text] [--max-dimension n] [--max-depth n] [--timeout s] [--flags \"compiler flags\"] [--dir path] [--csv file]" << std::endl;
+         return 1;
+      }
+   }
+
+   //reference: header only, then signatures by dimension, densities and depths
+   std::vector<case_t> cases;
+   cases.push_back(case_t{ "header", 0, 0, "-", 0, source(0, 0, "", 0) });
+   const unsigned int signatures[][2] = { {3, 0}, {4, 0}, {4, 1}, {5, 1}, {6, 1} };
+   const char* densities[] = { "vector", "even", "full" };
+   for(std::size_t s = 0; s < sizeof(signatures)/sizeof(signatures[0]); ++s) {
+      const unsigned int p = signatures[s][0];
+      const unsigned int q = signatures[s][1];
+      if(p+q > max_dimension) continue;
+      for(std::size_t d = 0; d < sizeof(densities)/sizeof(densities[0]); ++d) {
+         for(unsigned int depth = 1; depth <= max_depth; ++depth) {
+            std::ostringstream name;
+            name << "sig" << p << q << "_" << densities[d] << "_depth" << depth;
+            cases.push_back(case_t{ name.str(), p, q, densities[d], depth, source(p, q, densities[d], depth) });
+         }
+      }
+   }
+
+   if(system(("mkdir -p '" + dir + "'").c_str()) != 0) {
+      std::cerr << "cannot create " << dir << std::endl;
+      return 1;
+   }
+
+   std::FILE* f = csv ? std::fopen(csv, "w") : 0;
+   if(csv && !f) { std::cerr << "cannot write " << csv << std::endl; return 1; }
+   if(f) std::fprintf(f, "case,p,q,density,depth,status,wall_s,peak_rss_kb,instantiations\n");
+
+   std::printf("%-24s %-8s %10s %14s %16s\n", "case", "status", "wall/s", "peak rss/kB", "instantiations");
+   for(std::size_t i = 0; i < cases.size(); ++i) {
+      const case_t& c = cases[i];
+      if(!filter.empty() && c.name.find(filter)==std::string::npos) continue;
+
+      const std::string base = dir + "/" + c.name;
+      std::ofstream(base + ".cpp") << c.source;
+
+      std::vector<std::string> args;
+      args.push_back(GAALET_CXX_COMPILER);
+      args.push_back("-std=c++0x");
+      args.push_back("-I" GAALET_INCLUDE_DIR);
+      std::istringstream extra(flags);
+      for(std::string flag; extra >> flag; ) {
+         args.push_back(flag);
+      }
+#if defined(__GNUC__) && !defined(__clang__)
+      std::remove((base + ".class").c_str());
+      args.push_back("-fdump-lang-class=" + base + ".class");
+#endif
+      args.push_back("-c");
+      args.push_back(base + ".cpp");
+      args.push_back("-o");
+      args.push_back(base + ".o");
+
+      result_t r = compile(args, timeout);
+      r.instantiations = (r.status=="ok") ? count_instantiations(base + ".class") : -1;
+
+      std::printf("%-24s %-8s %10.3f %14ld %16ld\n", c.name.c_str(), r.status.c_str(), r.wall, r.peak_rss, r.instantiations);
+      std::fflush(stdout);
+      if(f) std::fprintf(f, "%s,%u,%u,%s,%u,%s,%.4f,%ld,%ld\n", c.name.c_str(), c.p, c.q, c.density.c_str(), c.depth,
+                         r.status.c_str(), r.wall, r.peak_rss, r.instantiations);
+   }
+   if(f) std::fclose(f);
+   return 0;
+}
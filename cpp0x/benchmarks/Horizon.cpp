@@ -1,8 +1,9 @@
 #include "gaalet.h"
+#include "benchmark.h"
+#include "generated_kernels.h"
 #include <iostream>
-#include <sys/time.h>
 
-int main()
+int main(int argc, char** argv)
 {
    gaalet::cm::mv<0x01>::type e1 = {1.0};
    gaalet::cm::mv<0x02>::type e2 = {1.0};
@@ -10,8 +11,6 @@ int main()
    gaalet::cm::mv<0x08>::type ep = {1.0};
    gaalet::cm::mv<0x10>::type em = {1.0};
 
-   gaalet::cm::mv<0x00>::type one = {1.0};
-
    gaalet::cm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
    //auto e0 = 0.5*(em-ep);
    gaalet::cm::mv<0x08, 0x10>::type einf = em+ep;
@@ -25,23 +24,20 @@ int main()
 
    gaalet::cm::mv<0x08, 0x10>::type S;
    gaalet::mv<0x09, 0x0a, 0x0c, 0x11, 0x12, 0x14, 0x18>::type C;
-
-   timeval start, end;
-
    double r = 0.5;
-   gettimeofday(&start, 0);
-   for(int i=0; i<100000000; ++i, r+=0.000001) {
+
+   bench::add("CGA", "horizon", "gaalet", [=]() mutable {
+      r += 0.000001;
       S = e0 - einf*0.5*r*r;
       C = (S^(P+(P&S)*einf));
-   }
-   gettimeofday(&end, 0);
-   std::cout << "Time: " << (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6 << ", circle C: " << C << std::endl;
+      bench::do_not_optimize(C);
+   });
 
    double C_opt[17];
 
-   r = 0.5;
-   gettimeofday(&start, 0);
-   for(int i=0; i<100000000; ++i, r+=0.000001) {
+   bench::add("CGA", "horizon", "baseline", [=]() mutable {
+      r += 0.000001;
+      bench::do_not_optimize(x);
       C_opt[9]=0.5*x*r*r;
       C_opt[10]=-1*x;
       C_opt[12]=0.5*y*r*r;
@@ -49,8 +45,18 @@ int main()
       C_opt[14]=0.5*z*r*r;
       C_opt[15]=-1*z;
       C_opt[16]=-1*r*r;
-   }
-   gettimeofday(&end, 0);
+      bench::do_not_optimize(C_opt);
+   });
+
+   //kernel generated from S^(P+(P&S)*einf) by symbolic evaluation, see kernels/GenerateKernels.cpp
+   double C_gen[7];
+
+   bench::add("CGA", "horizon", "codegen", [=]() mutable {
+      r += 0.000001;
+      bench::do_not_optimize(x);
+      horizon(x, y, z, r, C_gen);
+      bench::do_not_optimize(C_gen);
+   });
 
-   std::cout << "Time: " << (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6 << ", C: [" << C_opt[9] << ", " << C_opt[10] << ", " << C_opt[12] << ", " << C_opt[13] << ", " << C_opt[14] << ", " << C_opt[15] << ", " << C_opt[16] << "]" << std::endl;
+   return bench::run(argc, argv);
 }
@@ -0,0 +1,75 @@
+#include "gaalet.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+//bandwidth-bound batch operations on conformal points: double storage (baseline) against float storage with double computation (mixed) and float
+//usage: MixedPrecision [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+typedef gaalet::algebra<gaalet::signature<4,1>, double> cmd;
+typedef gaalet::algebra<gaalet::signature<4,1>, gaalet::precision<float, double>> cmx;
+typedef gaalet::algebra<gaalet::signature<4,1>, float> cmf;
+
+const std::size_t n = 1<<19;
+
+template<class A>
+struct batch
+{
+   typedef typename A::template mv<1, 2, 4, 8, 0x10>::array_type P_array;
+   typedef typename A::template mv<0x00>::array_type S_array;
+
+   batch()
+      :  X(n), Z(n), Y(n), S(n)
+   {
+      //same values representable in float for all variants
+      for(std::size_t i = 0; i < n; ++i) {
+         const double x = std::sin(0.001*i), y = std::cos(0.003*i), z = 1e-3*(i%1000);
+         const double h = 0.5*(x*x+y*y+z*z);
+         X.set(i, cmd::mv<1, 2, 4, 8, 0x10>::type({float(x), float(y), float(z), float(h - 0.5), float(h + 0.5)}));
+         Z.set(i, cmd::mv<1, 2, 4, 8, 0x10>::type({float(y), float(z), float(x), float(h - 0.5), float(h + 0.5)}));
+      }
+   }
+
+   P_array X, Z, Y;
+   S_array S;
+};
+
+template<class A>
+void register_batch(batch<A>& b, const char* variant)
+{
+   bench::add("CGA points 2^19", "Y = 0.5*X + Z", variant, [&b]() {
+      b.Y = 0.5*b.X + b.Z;
+      bench::do_not_optimize(*b.Y.blade(0));
+   });
+   bench::add("CGA points 2^19", "S = X&Z", variant, [&b]() {
+      b.S = b.X & b.Z;
+      bench::do_not_optimize(*b.S.blade(0));
+   });
+}
+
+int main(int argc, char** argv)
+{
+   batch<cmd> b_d;
+   batch<cmx> b_x;
+   batch<cmf> b_f;
+
+   //inner products (squared distances -2*(X&Z)) against double: relative error of rounding once (mixed) or of float computation
+   b_d.S = b_d.X & b_d.Z;
+   b_x.S = b_x.X & b_x.Z;
+   b_f.S = b_f.X & b_f.Z;
+   double e_x = 0.0, e_f = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      const double s = b_d.S.blade(0)[i];
+      const double scale = std::max(std::fabs(s), 1e-3);
+      e_x = std::max(e_x, std::fabs(b_x.S.blade(0)[i] - s)/scale);
+      e_f = std::max(e_f, std::fabs(b_f.S.blade(0)[i] - s)/scale);
+   }
+   std::cout << "maximum relative error of X&Z, mixed: " << e_x << ", float: " << e_f << std::endl;
+
+   register_batch(b_d, "baseline");
+   register_batch(b_x, "mixed");
+   register_batch(b_f, "float");
+
+   return bench::run(argc, argv);
+}
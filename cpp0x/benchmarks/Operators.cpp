@@ -0,0 +1,812 @@
+#include "gaalet.h"
+#include "benchmark.h"
+#include <cmath>
+
+//operators of E3, CGA and PGA, each with hand-coded baseline on element arrays
+//usage: Operators [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+//E3: euclidean space, signature<3,0,0>
+void register_e3()
+{
+   typedef gaalet::algebra<gaalet::signature<3,0,0>> alg;
+
+   //vectors a, b, even multivector M, bivector B, rotor R
+   const alg::mv<0x01, 0x02, 0x04>::type a = {0.15, 0.25, -0.25};
+   const alg::mv<0x01, 0x02, 0x04>::type b = {0.2, -0.1, 0.4};
+   const alg::mv<0x00, 0x03, 0x05, 0x06>::type M = {0.05, 0.35, 0.45, -0.25};
+   const alg::mv<0x03, 0x05, 0x06>::type B = {0.3, 0.4, -0.1};
+   const alg::mv<0x00, 0x03, 0x05, 0x06>::type R = {0.9, 0.2, -0.3, 0.25};
+
+   //hand-coded baselines on element arrays of a (x), b (y), M (m), B (c), R (s)
+   const double x[3] = {0.15, 0.25, -0.25};
+   const double y[3] = {0.2, -0.1, 0.4};
+   const double m[4] = {0.05, 0.35, 0.45, -0.25};
+   const double c[3] = {0.3, 0.4, -0.1};
+   const double s[4] = {0.9, 0.2, -0.3, 0.25};
+
+   {
+      auto r = eval(M*a);
+      bench::add("E3", "*", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = M*a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("E3", "*", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2];
+         r[3] = m[3]*x[0] - m[2]*x[1] + m[1]*x[2];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(B&a);
+      bench::add("E3", "&", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         bench::do_not_optimize(a);
+         r = B&a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("E3", "&", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         bench::do_not_optimize(x);
+         r[0] = c[0]*x[1] + c[1]*x[2];
+         r[1] = -c[0]*x[0] + c[2]*x[2];
+         r[2] = -c[1]*x[0] - c[2]*x[1];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(a^b);
+      bench::add("E3", "^", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         bench::do_not_optimize(b);
+         r = a^b;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("E3", "^", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         bench::do_not_optimize(y);
+         r[0] = -x[1]*y[0] + x[0]*y[1];
+         r[1] = -x[2]*y[0] + x[0]*y[2];
+         r[2] = -x[2]*y[1] + x[1]*y[2];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(~M);
+      bench::add("E3", "~", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = ~M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("E3", "~", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         r[0] = m[0];
+         r[1] = -m[1];
+         r[2] = -m[2];
+         r[3] = -m[3];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(!M);
+      bench::add("E3", "!", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = !M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("E3", "!", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         const double div = 1.0/(m[0]*m[0] + m[1]*m[1] + m[2]*m[2] + m[3]*m[3]);
+         r[0] = m[0]*div;
+         r[1] = -m[1]*div;
+         r[2] = -m[2]*div;
+         r[3] = -m[3]*div;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(exp(B));
+      bench::add("E3", "exp", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         r = exp(B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("E3", "exp", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         const double alpha_square = -c[0]*c[0] - c[1]*c[1] - c[2]*c[2];
+         double ca, sada;
+         if(alpha_square < 0.0) {
+            const double alpha = sqrt(-alpha_square);
+            ca = cos(alpha);
+            sada = sin(alpha)/alpha;
+         }
+         else if(alpha_square == 0.0) {
+            ca = 1.0;
+            sada = 1.0;
+         }
+         else {
+            const double alpha = sqrt(alpha_square);
+            ca = cosh(alpha);
+            sada = sinh(alpha)/alpha;
+         }
+         r[0] = ca;
+         r[1] = c[0]*sada;
+         r[2] = c[1]*sada;
+         r[3] = c[2]*sada;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(log(R));
+      bench::add("E3", "log", "gaalet", [=]() mutable {
+         bench::do_not_optimize(R);
+         r = log(R);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("E3", "log", "baseline", [=]() mutable {
+         bench::do_not_optimize(s);
+         const double b_square = s[1]*s[1] + s[2]*s[2] + s[3]*s[3];
+         const double mag_s = sqrt(s[0]*s[0] + b_square);
+         const double b_acos_r_s = acos(s[0]/mag_s)/sqrt(b_square);
+         r[0] = log(mag_s);
+         r[1] = s[1]*b_acos_r_s;
+         r[2] = s[2]*b_acos_r_s;
+         r[3] = s[3]*b_acos_r_s;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(dual(a));
+      bench::add("E3", "dual", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         r = dual(a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("E3", "dual", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         r[0] = -x[2];
+         r[1] = x[1];
+         r[2] = -x[0];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(grade<2>(M*B));
+      bench::add("E3", "grade", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(B);
+         r = grade<2>(M*B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("E3", "grade", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(c);
+         r[0] = m[0]*c[0] + m[3]*c[1] - m[2]*c[2];
+         r[1] = -m[3]*c[0] + m[0]*c[1] + m[1]*c[2];
+         r[2] = m[2]*c[0] - m[1]*c[1] + m[0]*c[2];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(part<0x01, 0x02, 0x04>(M*a));
+      bench::add("E3", "part", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = part<0x01, 0x02, 0x04>(M*a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("E3", "part", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2];
+         bench::do_not_optimize(r);
+      });
+   }
+}
+
+//CGA: conformal model, signature<4,1,0>
+void register_cga()
+{
+   typedef gaalet::algebra<gaalet::signature<4,1,0>> alg;
+
+   //vectors a, b, even multivector M, bivector B, rotor R
+   const alg::mv<0x01, 0x02, 0x04, 0x08, 0x10>::type a = {0.15, 0.25, -0.25, 0.45, 0.55};
+   const alg::mv<0x01, 0x02, 0x04, 0x08, 0x10>::type b = {0.2, -0.1, 0.4, 0.5, -0.4};
+   const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type M = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95, 1.05, -0.85, 1.25, 1.35};
+   const alg::mv<0x03, 0x05, 0x06>::type B = {0.3, 0.4, -0.1};
+   const alg::mv<0x00, 0x03, 0x05, 0x06>::type R = {0.9, 0.2, -0.3, 0.25};
+
+   //hand-coded baselines on element arrays of a (x), b (y), M (m), B (c), R (s)
+   const double x[5] = {0.15, 0.25, -0.25, 0.45, 0.55};
+   const double y[5] = {0.2, -0.1, 0.4, 0.5, -0.4};
+   const double m[12] = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95, 1.05, -0.85, 1.25, 1.35};
+   const double c[3] = {0.3, 0.4, -0.1};
+   const double s[4] = {0.9, 0.2, -0.3, 0.25};
+
+   {
+      auto r = eval(M*a);
+      bench::add("CGA", "*", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = M*a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[16];
+      bench::add("CGA", "*", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2] + m[4]*x[3] - m[8]*x[4];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2] + m[5]*x[3] - m[9]*x[4];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2] + m[6]*x[3] - m[10]*x[4];
+         r[3] = m[3]*x[0] - m[2]*x[1] + m[1]*x[2] + m[7]*x[3] - m[11]*x[4];
+         r[4] = -m[4]*x[0] - m[5]*x[1] - m[6]*x[2] + m[0]*x[3];
+         r[5] = m[5]*x[0] - m[4]*x[1] - m[7]*x[2] + m[1]*x[3];
+         r[6] = m[6]*x[0] + m[7]*x[1] - m[4]*x[2] + m[2]*x[3];
+         r[7] = -m[7]*x[0] + m[6]*x[1] - m[5]*x[2] + m[3]*x[3];
+         r[8] = -m[8]*x[0] - m[9]*x[1] - m[10]*x[2] + m[0]*x[4];
+         r[9] = m[9]*x[0] - m[8]*x[1] - m[11]*x[2] + m[1]*x[4];
+         r[10] = m[10]*x[0] + m[11]*x[1] - m[8]*x[2] + m[2]*x[4];
+         r[11] = -m[11]*x[0] + m[10]*x[1] - m[9]*x[2] + m[3]*x[4];
+         r[12] = -m[8]*x[3] + m[4]*x[4];
+         r[13] = -m[9]*x[3] + m[5]*x[4];
+         r[14] = -m[10]*x[3] + m[6]*x[4];
+         r[15] = -m[11]*x[3] + m[7]*x[4];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(B&a);
+      bench::add("CGA", "&", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         bench::do_not_optimize(a);
+         r = B&a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("CGA", "&", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         bench::do_not_optimize(x);
+         r[0] = c[0]*x[1] + c[1]*x[2];
+         r[1] = -c[0]*x[0] + c[2]*x[2];
+         r[2] = -c[1]*x[0] - c[2]*x[1];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(a^b);
+      bench::add("CGA", "^", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         bench::do_not_optimize(b);
+         r = a^b;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[10];
+      bench::add("CGA", "^", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         bench::do_not_optimize(y);
+         r[0] = -x[1]*y[0] + x[0]*y[1];
+         r[1] = -x[2]*y[0] + x[0]*y[2];
+         r[2] = -x[2]*y[1] + x[1]*y[2];
+         r[3] = -x[3]*y[0] + x[0]*y[3];
+         r[4] = -x[3]*y[1] + x[1]*y[3];
+         r[5] = -x[3]*y[2] + x[2]*y[3];
+         r[6] = -x[4]*y[0] + x[0]*y[4];
+         r[7] = -x[4]*y[1] + x[1]*y[4];
+         r[8] = -x[4]*y[2] + x[2]*y[4];
+         r[9] = -x[4]*y[3] + x[3]*y[4];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(~M);
+      bench::add("CGA", "~", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = ~M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[12];
+      bench::add("CGA", "~", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         r[0] = m[0];
+         r[1] = -m[1];
+         r[2] = -m[2];
+         r[3] = -m[3];
+         r[4] = -m[4];
+         r[5] = -m[5];
+         r[6] = -m[6];
+         r[7] = m[7];
+         r[8] = -m[8];
+         r[9] = -m[9];
+         r[10] = -m[10];
+         r[11] = m[11];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(!M);
+      bench::add("CGA", "!", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = !M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[12];
+      bench::add("CGA", "!", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         const double div = 1.0/(m[0]*m[0] + m[1]*m[1] + m[2]*m[2] + m[3]*m[3] + m[4]*m[4] + m[5]*m[5] + m[6]*m[6] + m[7]*m[7] - m[8]*m[8] - m[9]*m[9] - m[10]*m[10] - m[11]*m[11]);
+         r[0] = m[0]*div;
+         r[1] = -m[1]*div;
+         r[2] = -m[2]*div;
+         r[3] = -m[3]*div;
+         r[4] = -m[4]*div;
+         r[5] = -m[5]*div;
+         r[6] = -m[6]*div;
+         r[7] = m[7]*div;
+         r[8] = -m[8]*div;
+         r[9] = -m[9]*div;
+         r[10] = -m[10]*div;
+         r[11] = m[11]*div;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(exp(B));
+      bench::add("CGA", "exp", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         r = exp(B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("CGA", "exp", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         const double alpha_square = -c[0]*c[0] - c[1]*c[1] - c[2]*c[2];
+         double ca, sada;
+         if(alpha_square < 0.0) {
+            const double alpha = sqrt(-alpha_square);
+            ca = cos(alpha);
+            sada = sin(alpha)/alpha;
+         }
+         else if(alpha_square == 0.0) {
+            ca = 1.0;
+            sada = 1.0;
+         }
+         else {
+            const double alpha = sqrt(alpha_square);
+            ca = cosh(alpha);
+            sada = sinh(alpha)/alpha;
+         }
+         r[0] = ca;
+         r[1] = c[0]*sada;
+         r[2] = c[1]*sada;
+         r[3] = c[2]*sada;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(log(R));
+      bench::add("CGA", "log", "gaalet", [=]() mutable {
+         bench::do_not_optimize(R);
+         r = log(R);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("CGA", "log", "baseline", [=]() mutable {
+         bench::do_not_optimize(s);
+         const double b_square = s[1]*s[1] + s[2]*s[2] + s[3]*s[3];
+         const double mag_s = sqrt(s[0]*s[0] + b_square);
+         const double b_acos_r_s = acos(s[0]/mag_s)/sqrt(b_square);
+         r[0] = log(mag_s);
+         r[1] = s[1]*b_acos_r_s;
+         r[2] = s[2]*b_acos_r_s;
+         r[3] = s[3]*b_acos_r_s;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(dual(a));
+      bench::add("CGA", "dual", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         r = dual(a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[5];
+      bench::add("CGA", "dual", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         r[0] = -x[4];
+         r[1] = -x[3];
+         r[2] = x[2];
+         r[3] = -x[1];
+         r[4] = x[0];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(grade<2>(M*B));
+      bench::add("CGA", "grade", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(B);
+         r = grade<2>(M*B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[9];
+      bench::add("CGA", "grade", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(c);
+         r[0] = m[0]*c[0] + m[3]*c[1] - m[2]*c[2];
+         r[1] = -m[3]*c[0] + m[0]*c[1] + m[1]*c[2];
+         r[2] = m[2]*c[0] - m[1]*c[1] + m[0]*c[2];
+         r[3] = -m[5]*c[0] - m[6]*c[1] - m[7]*c[2];
+         r[4] = m[4]*c[0] + m[7]*c[1] - m[6]*c[2];
+         r[5] = -m[7]*c[0] + m[4]*c[1] + m[5]*c[2];
+         r[6] = -m[9]*c[0] - m[10]*c[1] - m[11]*c[2];
+         r[7] = m[8]*c[0] + m[11]*c[1] - m[10]*c[2];
+         r[8] = -m[11]*c[0] + m[8]*c[1] + m[9]*c[2];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(part<0x01, 0x02, 0x04>(M*a));
+      bench::add("CGA", "part", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = part<0x01, 0x02, 0x04>(M*a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("CGA", "part", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2] + m[4]*x[3] - m[8]*x[4];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2] + m[5]*x[3] - m[9]*x[4];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2] + m[6]*x[3] - m[10]*x[4];
+         bench::do_not_optimize(r);
+      });
+   }
+}
+
+//PGA: projective model, signature<3,0,1>
+void register_pga()
+{
+   typedef gaalet::algebra<gaalet::signature<3,0,1>> alg;
+
+   //vectors a, b, even multivector M, bivector B, rotor R
+   const alg::mv<0x01, 0x02, 0x04, 0x08>::type a = {0.15, 0.25, -0.25, 0.45};
+   const alg::mv<0x01, 0x02, 0x04, 0x08>::type b = {0.2, -0.1, 0.4, 0.5};
+   const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f>::type M = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95};
+   const alg::mv<0x03, 0x05, 0x06>::type B = {0.3, 0.4, -0.1};
+   const alg::mv<0x00, 0x03, 0x05, 0x06>::type R = {0.9, 0.2, -0.3, 0.25};
+
+   //hand-coded baselines on element arrays of a (x), b (y), M (m), B (c), R (s)
+   const double x[4] = {0.15, 0.25, -0.25, 0.45};
+   const double y[4] = {0.2, -0.1, 0.4, 0.5};
+   const double m[8] = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95};
+   const double c[3] = {0.3, 0.4, -0.1};
+   const double s[4] = {0.9, 0.2, -0.3, 0.25};
+
+   {
+      auto r = eval(M*a);
+      bench::add("PGA", "*", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = M*a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[8];
+      bench::add("PGA", "*", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2];
+         r[3] = m[3]*x[0] - m[2]*x[1] + m[1]*x[2];
+         r[4] = -m[4]*x[0] - m[5]*x[1] - m[6]*x[2] + m[0]*x[3];
+         r[5] = m[5]*x[0] - m[4]*x[1] - m[7]*x[2] + m[1]*x[3];
+         r[6] = m[6]*x[0] + m[7]*x[1] - m[4]*x[2] + m[2]*x[3];
+         r[7] = -m[7]*x[0] + m[6]*x[1] - m[5]*x[2] + m[3]*x[3];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(B&a);
+      bench::add("PGA", "&", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         bench::do_not_optimize(a);
+         r = B&a;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("PGA", "&", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         bench::do_not_optimize(x);
+         r[0] = c[0]*x[1] + c[1]*x[2];
+         r[1] = -c[0]*x[0] + c[2]*x[2];
+         r[2] = -c[1]*x[0] - c[2]*x[1];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(a^b);
+      bench::add("PGA", "^", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         bench::do_not_optimize(b);
+         r = a^b;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[6];
+      bench::add("PGA", "^", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         bench::do_not_optimize(y);
+         r[0] = -x[1]*y[0] + x[0]*y[1];
+         r[1] = -x[2]*y[0] + x[0]*y[2];
+         r[2] = -x[2]*y[1] + x[1]*y[2];
+         r[3] = -x[3]*y[0] + x[0]*y[3];
+         r[4] = -x[3]*y[1] + x[1]*y[3];
+         r[5] = -x[3]*y[2] + x[2]*y[3];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(~M);
+      bench::add("PGA", "~", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = ~M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[8];
+      bench::add("PGA", "~", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         r[0] = m[0];
+         r[1] = -m[1];
+         r[2] = -m[2];
+         r[3] = -m[3];
+         r[4] = -m[4];
+         r[5] = -m[5];
+         r[6] = -m[6];
+         r[7] = m[7];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(!M);
+      bench::add("PGA", "!", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         r = !M;
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[8];
+      bench::add("PGA", "!", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         const double div = 1.0/(m[0]*m[0] + m[1]*m[1] + m[2]*m[2] + m[3]*m[3]);
+         r[0] = m[0]*div;
+         r[1] = -m[1]*div;
+         r[2] = -m[2]*div;
+         r[3] = -m[3]*div;
+         r[4] = -m[4]*div;
+         r[5] = -m[5]*div;
+         r[6] = -m[6]*div;
+         r[7] = m[7]*div;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(exp(B));
+      bench::add("PGA", "exp", "gaalet", [=]() mutable {
+         bench::do_not_optimize(B);
+         r = exp(B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("PGA", "exp", "baseline", [=]() mutable {
+         bench::do_not_optimize(c);
+         const double alpha_square = -c[0]*c[0] - c[1]*c[1] - c[2]*c[2];
+         double ca, sada;
+         if(alpha_square < 0.0) {
+            const double alpha = sqrt(-alpha_square);
+            ca = cos(alpha);
+            sada = sin(alpha)/alpha;
+         }
+         else if(alpha_square == 0.0) {
+            ca = 1.0;
+            sada = 1.0;
+         }
+         else {
+            const double alpha = sqrt(alpha_square);
+            ca = cosh(alpha);
+            sada = sinh(alpha)/alpha;
+         }
+         r[0] = ca;
+         r[1] = c[0]*sada;
+         r[2] = c[1]*sada;
+         r[3] = c[2]*sada;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(log(R));
+      bench::add("PGA", "log", "gaalet", [=]() mutable {
+         bench::do_not_optimize(R);
+         r = log(R);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("PGA", "log", "baseline", [=]() mutable {
+         bench::do_not_optimize(s);
+         const double b_square = s[1]*s[1] + s[2]*s[2] + s[3]*s[3];
+         const double mag_s = sqrt(s[0]*s[0] + b_square);
+         const double b_acos_r_s = acos(s[0]/mag_s)/sqrt(b_square);
+         r[0] = log(mag_s);
+         r[1] = s[1]*b_acos_r_s;
+         r[2] = s[2]*b_acos_r_s;
+         r[3] = s[3]*b_acos_r_s;
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(dual(a));
+      bench::add("PGA", "dual", "gaalet", [=]() mutable {
+         bench::do_not_optimize(a);
+         r = dual(a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[4];
+      bench::add("PGA", "dual", "baseline", [=]() mutable {
+         bench::do_not_optimize(x);
+         r[0] = -x[3];
+         r[1] = x[2];
+         r[2] = -x[1];
+         r[3] = x[0];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(grade<2>(M*B));
+      bench::add("PGA", "grade", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(B);
+         r = grade<2>(M*B);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[6];
+      bench::add("PGA", "grade", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(c);
+         r[0] = m[0]*c[0] + m[3]*c[1] - m[2]*c[2];
+         r[1] = -m[3]*c[0] + m[0]*c[1] + m[1]*c[2];
+         r[2] = m[2]*c[0] - m[1]*c[1] + m[0]*c[2];
+         r[3] = -m[5]*c[0] - m[6]*c[1] - m[7]*c[2];
+         r[4] = m[4]*c[0] + m[7]*c[1] - m[6]*c[2];
+         r[5] = -m[7]*c[0] + m[4]*c[1] + m[5]*c[2];
+         bench::do_not_optimize(r);
+      });
+   }
+
+   {
+      auto r = eval(part<0x01, 0x02, 0x04>(M*a));
+      bench::add("PGA", "part", "gaalet", [=]() mutable {
+         bench::do_not_optimize(M);
+         bench::do_not_optimize(a);
+         r = part<0x01, 0x02, 0x04>(M*a);
+         bench::do_not_optimize(r);
+      });
+   }
+   {
+      double r[3];
+      bench::add("PGA", "part", "baseline", [=]() mutable {
+         bench::do_not_optimize(m);
+         bench::do_not_optimize(x);
+         r[0] = m[0]*x[0] + m[1]*x[1] + m[2]*x[2];
+         r[1] = -m[1]*x[0] + m[0]*x[1] + m[3]*x[2];
+         r[2] = -m[2]*x[0] - m[3]*x[1] + m[0]*x[2];
+         bench::do_not_optimize(r);
+      });
+   }
+}
+
+int main(int argc, char** argv)
+{
+   register_e3();
+   register_cga();
+   register_pga();
+
+   return bench::run(argc, argv);
+}
@@ -0,0 +1,54 @@
+#include "gaalet.h"
+#include "parallel.h"
+#include "benchmark.h"
+#include <memory>
+#include <vector>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+typedef cm::mv<1, 2, 4, 8, 0x10>::array_type P_array;
+
+//serial array assignment (baseline) against parallel_assign on pools of 1, 2, 4, ... threads up to the hardware concurrency
+//usage: ParallelSandwich [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+int main(int argc, char** argv)
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   const std::size_t n = 1000000;
+
+   P_array points(n);
+   for(std::size_t i = 0; i<n; ++i) {
+      double x = double(i)/double(n);
+      points.set(i, x*e1 + (1.0-x)*e2 + e0 + 0.5*(x*x + (1.0-x)*(1.0-x))*einf);
+   }
+   P_array moved(n);
+
+   cm::mv<0x03>::type B = {0.01};
+   D_type D = exp(-0.5*B)*(gaalet::cga::one + 0.5*einf*(0.01*e3));
+
+   //one iteration: whole array of points mapped
+   bench::add("CGA", "sandwich(D,P)", "baseline", [&]() {
+      moved = gaalet::sw::apply(D, points);
+      bench::do_not_optimize(moved);
+   });
+
+   //pools alive until all cases are measured
+   std::vector<std::unique_ptr<gaalet::thread_pool>> pools;
+   const unsigned int hardware = std::max(1u, std::thread::hardware_concurrency());
+   for(unsigned int threads = 1; ; threads = std::min(2*threads, hardware)) {
+      pools.push_back(std::unique_ptr<gaalet::thread_pool>(new gaalet::thread_pool(threads)));
+      gaalet::thread_pool& pool = *pools.back();
+      bench::add("CGA", "sandwich(D,P)", "threads " + std::to_string(threads), [&moved, &D, &points, &pool]() {
+         gaalet::parallel_assign(moved, gaalet::sw::apply(D, points), pool);
+         bench::do_not_optimize(moved);
+      });
+      if(threads == hardware) break;
+   }
+
+   return bench::run(argc, argv);
+}
@@ -0,0 +1,109 @@
+#include "gaalet.h"
+#include "pipeline.h"
+#include "benchmark.h"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//motor transformation of a point cloud of 2^20 points between interleaved x, y, z buffers in memory (endpoints without disk):
+//lift, versor application and projection evaluated block by block on the calling thread (baseline) against the pipeline of stage threads
+//usage: PointPipeline [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+typedef gaalet::point_pipeline<D_type> pipeline_t;
+
+const std::size_t n = 1<<20;
+
+//endpoints on interleaved buffers
+struct memory_source
+{
+   template<class X>
+   std::size_t operator()(const X& x) {
+      const std::size_t m = std::min(x.length(), n - position);
+      for(std::size_t i = 0; i < m; ++i) {
+         for(unsigned int k = 0; k < 3; ++k) {
+            x.blade(k)[i] = (*in)[3*(position + i) + k];
+         }
+      }
+      position += m;
+      return m;
+   }
+   const std::vector<double>* in;
+   std::size_t position;
+};
+struct memory_sink
+{
+   template<class X>
+   void operator()(const X& x) {
+      for(std::size_t i = 0; i < x.length(); ++i) {
+         for(unsigned int k = 0; k < 3; ++k) {
+            (*out)[3*(position + i) + k] = x.blade(k)[i];
+         }
+      }
+      position += x.length();
+   }
+   std::vector<double>* out;
+   std::size_t position;
+};
+
+int main(int argc, char** argv)
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   cm::mv<0x03>::type B = {0.4};
+   D_type D = (gaalet::cga::one - 0.5*einf*(1.0*e1 - 2.0*e2 + 0.5*e3))*exp(-0.5*B);
+
+   std::vector<double> in(3*n), out(3*n), out_pipeline(3*n);
+   for(std::size_t i = 0; i < n; ++i) {
+      in[3*i] = std::sin(0.001*i);
+      in[3*i+1] = std::cos(0.003*i);
+      in[3*i+2] = 1e-3*(i%1000);
+   }
+
+   //stages evaluated in sequence on one block
+   const std::size_t lanes = 4096;
+   gaalet::versor_map<D_type, cm::mv<1, 2, 4, 8, 0x10>::type> D_map(D);
+   cm::mv<1, 2, 4>::array_type x(lanes);
+   cm::mv<1, 2, 4, 8, 0x10>::array_type p(lanes);
+   auto sequential = [&]() {
+      memory_source source = { &in, 0 };
+      memory_sink sink = { &out, 0 };
+      for(std::size_t m; (m = source(x)) > 0; ) {
+         auto x_m = x.view(0, m);
+         auto p_m = p.view(0, m);
+         p_m.assign(x_m + 0.5*(x_m&x_m)*einf + e0);
+         p_m = D_map(p_m);
+         x_m.assign(part<1, 2, 4>(p_m)*(-1.0)*!(p_m&einf));
+         sink(x_m);
+      }
+   };
+
+   pipeline_t pipeline(D, lanes, 8);
+   auto pipelined = [&]() {
+      memory_source source = { &in, 0 };
+      memory_sink sink = { &out_pipeline, 0 };
+      pipeline.run(source, sink);
+   };
+
+   sequential();
+   pipelined();
+   std::cout << "pipeline output equal to sequential evaluation: " << (std::memcmp(out.data(), out_pipeline.data(), out.size()*sizeof(double))==0)
+             << ", stage threads: 5, hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+   bench::add("Motor on 2^20 points", "lift, apply, project", "baseline", [&]() {
+      sequential();
+      bench::do_not_optimize(out[0]);
+   });
+   bench::add("Motor on 2^20 points", "lift, apply, project", "pipeline", [&]() {
+      pipelined();
+      bench::do_not_optimize(out_pipeline[0]);
+   });
+
+   return bench::run(argc, argv);
+}
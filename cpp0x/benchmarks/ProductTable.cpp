@@ -0,0 +1,85 @@
+#include "gaalet.h"
+#include "benchmark.h"
+
+//guard of table-driven product kernels: each product evaluated by its kernel and element-wise (baseline),
+//fails if a kernel is slower than element-wise evaluation by more than the tolerance of max_ratio
+//usage: ProductTable [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file] [--max-ratio r]
+
+//operands and result of a case on own cache lines: timings independent of the placement of the case closure on the heap
+template<typename M, class L, class R>
+struct product_operands
+{
+   alignas(64) L l;
+   alignas(64) R r;
+   alignas(64) std::array<typename M::element_t, M::size> data;
+};
+
+//evaluation of product l op r into multivector of type M, by kernel (Evaluation) and by element-wise evaluation
+template<typename M, class L, class R, class F>
+void add_product(const std::string& group, const std::string& operation, const L& l, const R& r, F op)
+{
+   typedef decltype(op(l, r)) E;
+   static_assert(gaalet::evaluation_kernel<E>::value, "product without table-driven kernel");
+
+   //static storage of alignment 64, one case per instantiation
+   static product_operands<M, L, R> o;
+   o.l = l;
+   o.r = r;
+   product_operands<M, L, R>* p = &o;
+   bench::add(group, operation, "table", [p, op]() {
+      bench::do_not_optimize(p->l);
+      bench::do_not_optimize(p->r);
+      M::template Evaluation<E>::eval(p->data, op(p->l, p->r));
+      bench::do_not_optimize(p->data);
+   });
+   bench::add(group, operation, "baseline", [p, op]() {
+      bench::do_not_optimize(p->l);
+      bench::do_not_optimize(p->r);
+      M::template ElementEvaluation<E>::eval(p->data, op(p->l, p->r));
+      bench::do_not_optimize(p->data);
+   });
+}
+
+struct geometric { template<class L, class R> auto operator()(const L& l, const R& r) const -> decltype(l*r) { return l*r; } };
+struct inner { template<class L, class R> auto operator()(const L& l, const R& r) const -> decltype(l&r) { return l&r; } };
+struct outer { template<class L, class R> auto operator()(const L& l, const R& r) const -> decltype(l^r) { return l^r; } };
+
+template<class L, class R>
+void add_products(const std::string& group, const L& M, const L& N, const R& a, const R& b)
+{
+   add_product<decltype(eval(M*a))>(group, "M*a", M, a, geometric());
+   add_product<decltype(eval(M*N))>(group, "M*N", M, N, geometric());
+   add_product<decltype(eval(M&a))>(group, "M&a", M, a, inner());
+   add_product<decltype(eval(a^b))>(group, "a^b", a, b, outer());
+}
+
+int main(int argc, char** argv)
+{
+   {
+      typedef gaalet::algebra<gaalet::signature<3,0,0>> alg;
+      const alg::mv<0x00, 0x03, 0x05, 0x06>::type M = {0.05, 0.35, 0.45, -0.25};
+      const alg::mv<0x00, 0x03, 0x05, 0x06>::type N = {0.9, 0.2, -0.3, 0.25};
+      const alg::mv<0x01, 0x02, 0x04>::type a = {0.15, 0.25, -0.25};
+      const alg::mv<0x01, 0x02, 0x04>::type b = {0.2, -0.1, 0.4};
+      add_products("E3", M, N, a, b);
+   }
+   {
+      typedef gaalet::algebra<gaalet::signature<4,1,0>> alg;
+      const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type M = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95, 1.05, -0.85, 1.25, 1.35};
+      const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type N = {0.9, 0.2, -0.3, 0.25, 0.1, -0.15, 0.05, 0.3, -0.2, 0.4, 0.15, -0.1};
+      const alg::mv<0x01, 0x02, 0x04, 0x08, 0x10>::type a = {0.15, 0.25, -0.25, 0.45, 0.55};
+      const alg::mv<0x01, 0x02, 0x04, 0x08, 0x10>::type b = {0.2, -0.1, 0.4, 0.5, -0.4};
+      add_products("CGA", M, N, a, b);
+   }
+   {
+      typedef gaalet::algebra<gaalet::signature<3,0,1>> alg;
+      const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f>::type M = {0.05, 0.35, 0.45, -0.25, 0.65, 0.75, -0.55, 0.95};
+      const alg::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f>::type N = {0.9, 0.2, -0.3, 0.25, 0.1, -0.15, 0.05, 0.3};
+      const alg::mv<0x01, 0x02, 0x04, 0x08>::type a = {0.15, 0.25, -0.25, 0.45};
+      const alg::mv<0x01, 0x02, 0x04, 0x08>::type b = {0.2, -0.1, 0.4, 0.5};
+      add_products("PGA", M, N, a, b);
+   }
+
+   //kernel may not be slower than element-wise evaluation, 20% tolerance for timing noise
+   return bench::run(argc, argv, 1.2);
+}
@@ -0,0 +1,91 @@
+#include "gaalet.h"
+#include "benchmark.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+//gradient of the GradientSearch objective scaled to n rotors, U = sum of |R_i*t_0*~R_i - t_i|^2 with R_i = exp(-0.5*m_i), by all 3n bivector parameters m_i
+//forward mode as baseline (one evaluation of U per rotor, derivatives by its three parameters), reverse mode from one recording and sweep
+//usage: RotorGradient [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::ad::fvar<double, 3> f3;
+typedef gaalet::ad::rvar<double> rd;
+typedef gaalet::algebra<gaalet::signature<3,0>, f3> fm;
+typedef gaalet::algebra<gaalet::signature<3,0>, rd> rm;
+
+typedef em::mv<3,5,6>::type bivector_t;
+typedef em::mv<1,2,4>::type vector_t;
+
+int main(int argc, char** argv)
+{
+   const unsigned int n = 1000;
+   vector_t t_0 = {1.0, 0.0, 0.0};
+   std::vector<bivector_t> m(n);
+   std::vector<vector_t> t(n);
+   for(unsigned int i = 0; i < n; ++i) {
+      double s = double(i)/double(n);
+      m[i] = {0.1*s, -0.2*s, 0.3};
+      t[i] = {std::cos(3.0*s), std::sin(3.0*s), 0.5 - s};
+   }
+
+   std::vector<bivector_t> grad_f(n), grad_r(n);
+
+   //forward mode: pass j seeds the parameters of rotor j, all other rotors evaluated with vanishing derivatives
+   auto forward = [&]() {
+      for(unsigned int j = 0; j < n; ++j) {
+         f3 U = 0.0;
+         for(unsigned int i = 0; i < n; ++i) {
+            fm::mv<3,5,6>::type m_i = (i==j) ? gaalet::ad::variables<3>(m[i]) : fm::mv<3,5,6>::type(m[i]);
+            auto R = exp(-0.5*m_i);
+            auto d = eval(grade<1>(R*t_0*~R) - t[i]);
+            U += eval(d&d);
+         }
+         for(unsigned int k = 0; k < 3; ++k) {
+            grad_f[j][k] = U.tangent[k];
+         }
+      }
+   };
+
+   //reverse mode: one recording of U on the reused tape, one sweep
+   auto reverse = [&]() {
+      gaalet::ad::tape<double>& tape = gaalet::ad::active_tape<double>();
+      tape.clear();
+      std::vector<rm::mv<3,5,6>::type> m_r(n);
+      rd U = 0.0;
+      for(unsigned int i = 0; i < n; ++i) {
+         m_r[i] = gaalet::ad::independent(m[i]);
+         auto R = exp(-0.5*m_r[i]);
+         auto d = eval(grade<1>(R*t_0*~R) - t[i]);
+         U += eval(d&d);
+      }
+      gaalet::ad::backward(U);
+      for(unsigned int i = 0; i < n; ++i) {
+         grad_r[i] = gaalet::ad::gradient(m_r[i]);
+      }
+   };
+
+   forward();
+   reverse();
+   double deviation = 0.0;
+   for(unsigned int i = 0; i < n; ++i) {
+      for(unsigned int k = 0; k < 3; ++k) {
+         deviation = std::max(deviation, std::fabs(grad_f[i][k] - grad_r[i][k]));
+      }
+   }
+   std::cout << "maximum deviation of reverse from forward mode: " << deviation
+             << ", tape entries: " << gaalet::ad::active_tape<double>().size()
+             << ", tape bytes: " << gaalet::ad::active_tape<double>().memory() << std::endl;
+
+   bench::add("GradientSearch 1000 rotors", "gradient", "baseline", [&]() {
+      forward();
+      bench::do_not_optimize(grad_f[n-1]);
+   });
+   bench::add("GradientSearch 1000 rotors", "gradient", "reverse", [&]() {
+      reverse();
+      bench::do_not_optimize(grad_r[n-1]);
+   });
+
+   return bench::run(argc, argv);
+}
@@ -0,0 +1,122 @@
+#include "gaalet.h"
+#include "benchmark.h"
+#include "generated_kernels.h"
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+//terms of the CarDynamicsCGA state equation: gaalet expressions against kernels generated at build time (kernels/GenerateKernels.cpp)
+//usage: StateEquation [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+typedef cm::mv<0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x11, 0x12, 0x14>::type S_type;
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+
+int main(int argc, char** argv)
+{
+   cm::mv<0x00>::type one = {1.0};
+   cm::mv<0x01>::type e1 = {1.0};
+   cm::mv<0x02>::type e2 = {1.0};
+   cm::mv<0x04>::type e3 = {1.0};
+   cm::mv<0x08>::type ep = {1.0};
+   cm::mv<0x10>::type em = {1.0};
+   cm::mv<0x08, 0x10>::type einf = em+ep;
+   cm::mv<0x07>::type Ie = e1*e2*e3;
+   cm::mv<0x00, 0x06>::type R_w = {cos(-0.25*M_PI), sin(-0.25*M_PI)};
+
+   //displacement versors, screw velocities, wheel angular and spring damper velocities
+   const unsigned int n = 1000;
+   std::vector<D_type> D(n);
+   std::vector<S_type> V(n);
+   std::vector<double> w(n), du(n);
+   for(unsigned int i=0; i<n; ++i) {
+      double s = double(i)/double(n);
+      D[i] = exp(-0.5*s*(e1^e2))*(one + 0.5*einf*(s*e1 + 0.2*e3));
+      V[i] = s*(e1^e2) + 0.5*(e2^e3) + einf*(0.3*e1 - s*e3);
+      w[i] = 10.0*s;
+      du[i] = 0.1 - 0.2*s;
+   }
+
+   //structure-of-arrays copies for batch kernels
+   std::vector<double> D_soa(D_type::size*n), V_soa(S_type::size*n), dD_soa(D_type::size*n), V_w_soa(10*n);
+   const double* D_arrays[D_type::size];
+   const double* V_arrays[S_type::size];
+   double* dD_arrays[D_type::size];
+   double* V_w_arrays[10];
+   for(unsigned int k=0; k<D_type::size; ++k) {
+      for(unsigned int i=0; i<n; ++i) {
+         D_soa[k*n + i] = D[i][k];
+      }
+      D_arrays[k] = &D_soa[k*n];
+      dD_arrays[k] = &dD_soa[k*n];
+   }
+   for(unsigned int k=0; k<S_type::size; ++k) {
+      for(unsigned int i=0; i<n; ++i) {
+         V_soa[k*n + i] = V[i][k];
+      }
+      V_arrays[k] = &V_soa[k*n];
+   }
+   for(unsigned int k=0; k<10; ++k) {
+      V_w_arrays[k] = &V_w_soa[k*n];
+   }
+
+   std::vector<D_type> dD(n), dD_gen(n);
+   typedef decltype(eval(grade<2>((~R_w)*((~D[0])*V[0]*D[0] - Ie*w[0]*e2 + einf*(-du[0])*e3)*R_w))) V_w_type;
+   std::vector<V_w_type> V_w(n), V_w_gen(n);
+
+   //generated kernels against expressions
+   double deviation = 0.0;
+   body_displacement_derivative_batch(n, D_arrays, V_arrays, dD_arrays);
+   wheel_velocity_batch(n, D_arrays, V_arrays, &w[0], &du[0], V_w_arrays);
+   for(unsigned int i=0; i<n; ++i) {
+      dD[i] = part_type<D_type>(D[i]*V[i]*0.5);
+      V_w[i] = grade<2>((~R_w)*((~D[i])*V[i]*D[i] - Ie*w[i]*e2 + einf*(-du[i])*e3)*R_w);
+      body_displacement_derivative(&D[i][0], &V[i][0], &dD_gen[i][0]);
+      wheel_velocity(&D[i][0], &V[i][0], w[i], du[i], &V_w_gen[i][0]);
+      for(unsigned int k=0; k<D_type::size; ++k) {
+         deviation = std::max(deviation, std::max(std::fabs(dD[i][k] - dD_gen[i][k]), std::fabs(dD[i][k] - dD_soa[k*n + i])));
+      }
+      for(unsigned int k=0; k<V_w_type::size; ++k) {
+         deviation = std::max(deviation, std::max(std::fabs(V_w[i][k] - V_w_gen[i][k]), std::fabs(V_w[i][k] - V_w_soa[k*n + i])));
+      }
+   }
+   std::cout << "maximum deviation of generated kernels: " << deviation << std::endl;
+
+   //one iteration: whole set of states
+   bench::add("CarDynamicsCGA", "dD_b", "gaalet", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         dD[i] = part_type<D_type>(D[i]*V[i]*0.5);
+      }
+      bench::do_not_optimize(dD[n-1]);
+   });
+   bench::add("CarDynamicsCGA", "dD_b", "codegen", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         body_displacement_derivative(&D[i][0], &V[i][0], &dD_gen[i][0]);
+      }
+      bench::do_not_optimize(dD_gen[n-1]);
+   });
+   bench::add("CarDynamicsCGA", "dD_b", "codegen SoA", [&]() {
+      body_displacement_derivative_batch(n, D_arrays, V_arrays, dD_arrays);
+      bench::do_not_optimize(dD_soa[0]);
+   });
+
+   bench::add("CarDynamicsCGA", "V_w", "gaalet", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         V_w[i] = grade<2>((~R_w)*((~D[i])*V[i]*D[i] - Ie*w[i]*e2 + einf*(-du[i])*e3)*R_w);
+      }
+      bench::do_not_optimize(V_w[n-1]);
+   });
+   bench::add("CarDynamicsCGA", "V_w", "codegen", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         wheel_velocity(&D[i][0], &V[i][0], w[i], du[i], &V_w_gen[i][0]);
+      }
+      bench::do_not_optimize(V_w_gen[n-1]);
+   });
+   bench::add("CarDynamicsCGA", "V_w", "codegen SoA", [&]() {
+      wheel_velocity_batch(n, D_arrays, V_arrays, &w[0], &du[0], V_w_arrays);
+      bench::do_not_optimize(V_w_soa[0]);
+   });
+
+   return bench::run(argc, argv);
+}
@@ -0,0 +1,79 @@
+#include "gaalet.h"
+#include "symbex.h"
+#include "benchmark.h"
+#include <string>
+#include <sstream>
+
+//symbolic geometric product of full conformal multivectors (32 symbols each), interned DAG against string concatenation as baseline
+//usage: SymbolicProduct [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+//baseline element type: expression built by string concatenation
+struct string_symbex
+{
+   string_symbex(const std::string& expr_ = "0")
+      :  expr(expr_)
+   { }
+
+   string_symbex(double v)
+   {
+      std::stringstream s;
+      s << v;
+      expr = s.str();
+   }
+
+   std::string expr;
+};
+
+string_symbex operator+(const string_symbex& l, const string_symbex& r) {
+   return string_symbex("(" + l.expr + "+" + r.expr + ")");
+}
+string_symbex operator-(const string_symbex& l, const string_symbex& r) {
+   return string_symbex("(" + l.expr + "-" + r.expr + ")");
+}
+string_symbex operator*(const string_symbex& l, const string_symbex& r) {
+   return string_symbex(l.expr + "*" + r.expr);
+}
+string_symbex operator*(const string_symbex& l, int r) {
+   return (r==1) ? l : string_symbex("(-" + l.expr + ")");
+}
+
+namespace gaalet
+{
+template<>
+struct null_element<string_symbex> {
+   static string_symbex value() {
+      return string_symbex("0");
+   }
+};
+}
+
+template<typename T>
+void register_product(const char* variant)
+{
+   typedef gaalet::algebra<gaalet::signature<4,1>, T> alg;
+   typedef typename alg::template mv<0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+                                     0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f>::type full_t;
+
+   full_t a, b;
+   for(int i = 0; i < 32; ++i) {
+      std::stringstream an, bn;
+      an << "a" << i;
+      bn << "b" << i;
+      a[i] = T(an.str());
+      b[i] = T(bn.str());
+   }
+
+   full_t r;
+   bench::add("CGA symbolic", "*", variant, [=]() mutable {
+      r = a*b;
+      bench::do_not_optimize(r);
+   });
+}
+
+int main(int argc, char** argv)
+{
+   register_product<string_symbex>("baseline");
+   register_product<gaalet::symbex>("dag");
+
+   return bench::run(argc, argv);
+}
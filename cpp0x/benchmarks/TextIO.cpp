@@ -0,0 +1,73 @@
+#include "gaalet.h"
+#include "text_io.h"
+#include "benchmark.h"
+#include <cmath>
+#include <iostream>
+#include <sstream>
+
+//text export and import of a trajectory log of conformal points: element-wise iostream formatting and extraction (baseline) against bulk formatting and parsing of blocks
+//usage: TextIO [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file]
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+typedef cm::mv<1, 2, 4, 8, 0x10>::array_type P_array;
+
+const std::size_t n = 1<<16;
+
+int main(int argc, char** argv)
+{
+   P_array X(n), Y(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double x = std::sin(0.001*i), y = std::cos(0.003*i), z = 1e-3*(i%1000);
+      X.set(i, P_type({x, y, z, 0.5*(x*x+y*y+z*z) - 0.5, 0.5*(x*x+y*y+z*z) + 0.5}));
+   }
+
+   //texts of same numbers: shortest round trip and fixed digits
+   std::ostringstream round_trip_os, fixed_os;
+   gaalet::write_text(round_trip_os, X, gaalet::text_format(' ', gaalet::text_header_none));
+   gaalet::write_text(fixed_os, X, gaalet::text_format(' ', gaalet::text_header_none, 6));
+   const std::string round_trip = round_trip_os.str(), fixed = fixed_os.str();
+   std::cout << "text bytes, round trip: " << round_trip.size() << ", fixed 6 digits: " << fixed.size() << std::endl;
+
+   bench::add("CGA points 2^16", "write", "baseline", [&]() {
+      std::ostringstream os;
+      os.precision(17);
+      for(std::size_t i = 0; i < n; ++i) {
+         for(unsigned int k = 0; k < P_type::size; ++k) {
+            os << X.blade(k)[i] << ' ';
+         }
+         os << '\n';
+      }
+      bench::do_not_optimize(os);
+   });
+   bench::add("CGA points 2^16", "write", "bulk", [&]() {
+      std::ostringstream os;
+      gaalet::write_text(os, X, gaalet::text_format(' ', gaalet::text_header_none));
+      bench::do_not_optimize(os);
+   });
+   bench::add("CGA points 2^16", "write", "bulk fixed", [&]() {
+      std::ostringstream os;
+      gaalet::write_text(os, X, gaalet::text_format(' ', gaalet::text_header_none, 6));
+      bench::do_not_optimize(os);
+   });
+
+   bench::add("CGA points 2^16", "read", "baseline", [&]() {
+      std::istringstream is(round_trip);
+      for(std::size_t i = 0; i < n; ++i) {
+         for(unsigned int k = 0; k < P_type::size; ++k) {
+            is >> Y.blade(k)[i];
+         }
+      }
+      bench::do_not_optimize(*Y.blade(0));
+   });
+   bench::add("CGA points 2^16", "read", "bulk", [&]() {
+      gaalet::parse_text(round_trip.data(), round_trip.data() + round_trip.size(), Y);
+      bench::do_not_optimize(*Y.blade(0));
+   });
+   bench::add("CGA points 2^16", "read", "bulk fixed", [&]() {
+      gaalet::parse_text(fixed.data(), fixed.data() + fixed.size(), Y);
+      bench::do_not_optimize(*Y.blade(0));
+   });
+
+   return bench::run(argc, argv);
+}
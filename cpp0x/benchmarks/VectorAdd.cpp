@@ -1,5 +1,5 @@
 #include "gaalet.h"
-#include <sys/time.h>
+#include "benchmark.h"
 #include <cmath>
 
 template<typename T>
@@ -21,60 +21,35 @@ T ns(const T& l, const T& r)
    return result;
 }
 
-int main()
+int main(int argc, char** argv)
 {
-   timeval start, end;
-   double solveTime;
-
    gaalet::mv<1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12>::type a = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0};
    gaalet::mv<1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12>::type b = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0};
 
    gaalet::mv<1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12>::type c;
 
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e7; ++i) {
+   bench::add("E", "c+a+b-...-c", "operator=", [=]() mutable {
+      bench::do_not_optimize(a);
       c = c + a + b - a - b + a + b - a - b - c;
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "c: " << c << std::endl;
-
-   std::cout << "operator=(): add solve time: " << solveTime << std::endl;
-
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e7; ++i) {
+      bench::do_not_optimize(c);
+   });
+   bench::add("E", "c+a+b-...-c", "operator+=", [=]() mutable {
+      bench::do_not_optimize(a);
+      c += a + b - a - b + a + b - a - b - c;
+      bench::do_not_optimize(c);
+   });
+   bench::add("E", "c+a+b-...-c", "eval", [=]() mutable {
+      bench::do_not_optimize(a);
       c = eval(c + a + b - a - b + a + b - a - b - c);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "c: " << c << std::endl;
-
-   std::cout << "eval(): add solve time: " << solveTime << std::endl;
-
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e7; ++i) {
+      bench::do_not_optimize(c);
+   });
+   bench::add("E", "c+a+b-...-c", "assign", [=]() mutable {
+      bench::do_not_optimize(a);
       c.assign(c + a + b - a - b + a + b - a - b - c);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "c: " << c << std::endl;
-
-   std::cout << "assign(): add solve time: " << solveTime << std::endl;
-
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e7; ++i) {
+      bench::do_not_optimize(c);
+   });
+   bench::add("E", "c+a+b-...-c", "baseline", [=]() mutable {
+      bench::do_not_optimize(a);
       c[0] = c[0] + a[0] + b[0] - a[0] - b[0] + a[0] + b[0] - a[0] - b[0] - c[0];
       c[1] = c[1] + a[1] + b[1] - a[1] - b[1] + a[1] + b[1] - a[1] - b[1] - c[1];
       c[1] = c[1] + a[1] + b[1] - a[1] - b[1] + a[1] + b[1] - a[1] - b[1] - c[1];
@@ -88,27 +63,13 @@ int main()
       c[9] = c[9] + a[9] + b[9] - a[9] - b[9] + a[9] + b[9] - a[9] - b[9] - c[9];
       c[10] = c[10] + a[10] + b[10] - a[10] - b[10] + a[10] + b[10] - a[10] - b[10] - c[10];
       c[11] = c[11] + a[11] + b[11] - a[11] - b[11] + a[11] + b[11] - a[11] - b[11] - c[11];
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "c: " << c << std::endl;
-
-   std::cout << "handcoded: add solve time: " << solveTime << std::endl;
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e7; ++i) {
-      //c = na(c, na(a, ns(b, ns(a, na(b, na(a, ns(b, ns(a, ns(b, c)))))))));
+      bench::do_not_optimize(c);
+   });
+   bench::add("E", "c+a+b-...-c", "naive", [=]() mutable {
+      bench::do_not_optimize(a);
       c = ns(ns(ns(na(na(ns(ns(na(na(c, a), b), a), b), a), b), a), b), c);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "c: " << c << std::endl;
+      bench::do_not_optimize(c);
+   });
 
-   std::cout << "naive_addition::operator+(): add solve time: " << solveTime << std::endl;
+   return bench::run(argc, argv);
 }
@@ -1,75 +1,56 @@
 #include "gaalet.h"
-#include <sys/time.h>
+#include "benchmark.h"
 #include <cmath>
 
 typedef gaalet::algebra<gaalet::signature<3,0>> em;
 
-int main()
+int main(int argc, char** argv)
 {
-   timeval start, end;
-   double solveTime;
-
    em::mv<1, 2, 4, 7>::type a = {1.0, 1.0, 0.0, 0.0};
    em::mv<0, 3, 5, 6>::type b = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
+   em::mv<1, 2, 4>::type k = {1.0, 1.0, 0.0};
 
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
-      //a = (~b)*b*a*(~b)*b;
+   bench::add("E3", "b*a*~b", "operator=", [=]() mutable {
+      bench::do_not_optimize(b);
       a = b*a*(~b);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "a: " << a << std::endl;
-   std::cout << "b: " << b << std::endl;
-   std::cout << "operator=(): multiply solve time: " << solveTime << std::endl;
-
-   em::mv<1, 2, 4, 7>::type d = {1.0, 1.0, 0.0, 0.0};
-   em::mv<0, 3, 5, 6>::type e = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
-      //d = eval((~e)*e*d*(~e)*e);
-      d = eval(e*d*(~e));
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "d: " << d << std::endl;
-   std::cout << "e: " << e << std::endl;
-   std::cout << "eval(): multiply solve time: " << solveTime << std::endl;
-
-
-   em::mv<1, 2, 4, 7>::type f = {1.0, 1.0, 0.0, 0.0};
-   em::mv<0, 3, 5, 6>::type g = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
+      bench::do_not_optimize(a);
+   });
+   bench::add("E3", "b*a*~b", "eval", [=]() mutable {
+      bench::do_not_optimize(b);
+      a = eval(b*a*(~b));
+      bench::do_not_optimize(a);
+   });
+   bench::add("E3", "b*a*~b", "materialize", [=]() mutable {
+      bench::do_not_optimize(b);
+      a = materialize(b*a)*(~b);
+      bench::do_not_optimize(a);
+   });
+   bench::add("E3", "b*a*~b", "sandwich", [=]() mutable {
+      bench::do_not_optimize(b);
+      k = gaalet::sw::apply(b, k);
+      bench::do_not_optimize(k);
+   });
+
+   auto f = a;
+   auto g = b;
+   bench::add("E3", "b*a*~b", "baseline", [=]() mutable {
+      bench::do_not_optimize(g);
       double f0 = -g[1]*g[3]*f[2]-g[1]*g[3]*f[2]+g[2]*g[3]*f[1]+g[2]*g[3]*f[1]+g[3]*g[3]*f[3]-g[1]*g[2]*f[3]-g[1]*g[2]*f[3]+g[3]*g[3]*f[0]+g[2]*g[2]*f[0]+g[1]*g[1]*f[0]+g[0]*g[0]*f[0];
       double f1 = g[1]*g[2]*f[2]+g[1]*g[2]*f[2]+g[3]*g[3]*f[1]+g[2]*g[2]*f[1]+g[1]*g[1]*f[1]+g[0]*g[0]*f[1]-g[1]*g[3]*f[3]-g[1]*g[3]*f[3]-g[2]*g[3]*f[0]-g[2]*g[3]*f[0];
       double f2 = g[3]*g[3]*f[2]+g[1]*g[1]*f[2]+g[0]*g[0]*f[2]-g[1]*g[2]*f[1]-g[1]*g[2]*f[1]-g[2]*g[3]*f[3]-g[2]*g[3]*f[3]+g[1]*g[3]*f[0]+g[1]*g[3]*f[0];
       double f3 = g[2]*g[3]*f[2]+g[2]*g[3]*f[2]+g[2]*g[2]*f[2]+g[1]*g[3]*f[1]+g[1]*g[3]*f[1]+g[2]*g[2]*f[3]+g[1]*g[1]*f[3]+g[0]*g[0]*f[3]+g[1]*g[2]*f[0]+g[1]*g[2]*f[0];
       f[0] = f0; f[1] = f1; f[2] = f2; f[3] = f3;
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-
-   std::cout << "f: " << f << std::endl;
-   std::cout << "g: " << g << std::endl;
-   std::cout << "handcoded: multiply solve time: " << solveTime << std::endl;
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
+      bench::do_not_optimize(f);
+   });
+   bench::add("E3", "b*a*~b", "optimized", [=]() mutable {
+      bench::do_not_optimize(g);
       double f0 = -2.0*g[1]*g[3]*f[2]+2.0*g[2]*g[3]*f[1]+g[3]*g[3]*f[3]-2.0*g[1]*g[2]*f[3]+g[3]*g[3]*f[0]+g[2]*g[2]*f[0]+g[1]*g[1]*f[0]+g[0]*g[0]*f[0];
       double f1 = 2.0*g[1]*g[2]*f[2]+g[3]*g[3]*f[1]+g[2]*g[2]*f[1]+g[1]*g[1]*f[1]+g[0]*g[0]*f[1]-2.0*g[1]*g[3]*f[3]-2.0*g[2]*g[3]*f[0];
       double f2 = g[3]*g[3]*f[2]+g[1]*g[1]*f[2]+g[0]*g[0]*f[2]-2.0*g[1]*g[2]*f[1]-2.0*g[2]*g[3]*f[3]+2.0*g[1]*g[3]*f[0];
       double f3 = 2.0*g[2]*g[3]*f[2]+g[2]*g[2]*f[2]+2.0*g[1]*g[3]*f[1]+g[2]*g[2]*f[3]+g[1]*g[1]*f[3]+g[0]*g[0]*f[3]+2.0*g[1]*g[2]*f[0];
       f[0] = f0; f[1] = f1; f[2] = f2; f[3] = f3;
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
+      bench::do_not_optimize(f);
+   });
 
-   std::cout << "f: " << f << std::endl;
-   std::cout << "g: " << g << std::endl;
-   std::cout << "handcoded optimized: multiply solve time: " << solveTime << std::endl;
+   return bench::run(argc, argv);
 }
@@ -0,0 +1,53 @@
+#include "gaalet.h"
+#include "benchmark.h"
+#include <cmath>
+#include <vector>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+
+int main(int argc, char** argv)
+{
+   cm::mv<0x00>::type one = {1.0};
+   cm::mv<0x01>::type e1 = {1.0};
+   cm::mv<0x02>::type e2 = {1.0};
+   cm::mv<0x04>::type e3 = {1.0};
+   cm::mv<0x08>::type ep = {1.0};
+   cm::mv<0x10>::type em = {1.0};
+   cm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
+   cm::mv<0x08, 0x10>::type einf = em+ep;
+
+   const unsigned int n = 1000;
+
+   std::vector<P_type> points(n);
+   for(unsigned int i=0; i<n; ++i) {
+      double x = double(i)/double(n);
+      points[i] = x*e1 + (1.0-x)*e2 + e0 + 0.5*(x*x + (1.0-x)*(1.0-x))*einf;
+   }
+   std::vector<P_type> moved(n);
+
+   D_type D = exp(-0.5*0.01*(e1^e2))*(one + 0.5*einf*(0.01*e3));
+
+   //one iteration: whole set of points mapped
+   bench::add("CGA", "D*P*~D", "gaalet", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         moved[i] = grade<1>(D*points[i]*(~D));
+      }
+      bench::do_not_optimize(moved[n-1]);
+   });
+   bench::add("CGA", "D*P*~D", "sandwich", [&]() {
+      for(unsigned int i = 0; i<n; ++i) {
+         moved[i] = gaalet::sw::apply(D, points[i]);
+      }
+      bench::do_not_optimize(moved[n-1]);
+   });
+   bench::add("CGA", "D*P*~D", "versor_map", [&]() {
+      gaalet::versor_map<D_type, P_type> D_map(D);
+      D_map.apply(points.begin(), points.end(), moved.begin());
+      bench::do_not_optimize(moved[n-1]);
+   });
+
+   return bench::run(argc, argv);
+}
@@ -0,0 +1,243 @@
+#ifndef __GAALET_BENCHMARK_H
+#define __GAALET_BENCHMARK_H
+
+//micro-benchmark harness: registered cases, iteration calibration, repeated samples, median and median absolute deviation, CSV/JSON output
+//usage of programs built on bench::run(): [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file] [--max-ratio r]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace bench
+{
+
+//barriers against dead-code elimination and hoisting: value is assumed to be read and modified in memory
+template<typename T> inline
+void do_not_optimize(T& value) {
+#if defined(__GNUC__)
+   asm volatile("" : : "r"(&value) : "memory");
+#else
+   volatile char sink = *reinterpret_cast<volatile char*>(&value);
+   (void)sink;
+#endif
+}
+template<typename T> inline
+void do_not_optimize(const T& value) {
+#if defined(__GNUC__)
+   asm volatile("" : : "r"(&value) : "memory");
+#else
+   volatile char sink = *reinterpret_cast<const volatile char*>(&value);
+   (void)sink;
+#endif
+}
+
+//benchmark case: run(n) executes n iterations
+struct case_t
+{
+   std::string group;
+   std::string operation;
+   std::string variant;
+   std::function<void(std::size_t)> run;
+};
+
+//result of case: time per iteration in nanoseconds
+struct result_t
+{
+   const case_t* c;
+   std::size_t iterations;
+   std::size_t samples;
+   double median;
+   double mad;
+   double min;
+};
+
+inline
+std::vector<case_t>& registry() {
+   static std::vector<case_t> cases;
+   return cases;
+}
+
+//registration of case with body f() executed once per iteration
+template<class F> inline
+void add(const std::string& group, const std::string& operation, const std::string& variant, F f) {
+   case_t c;
+   c.group = group;
+   c.operation = operation;
+   c.variant = variant;
+   c.run = [f](std::size_t n) mutable {
+      for(std::size_t i = 0; i < n; ++i) {
+         f();
+      }
+   };
+   registry().push_back(c);
+}
+
+inline
+double seconds(const case_t& c, std::size_t n) {
+   const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+   c.run(n);
+   const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+   return std::chrono::duration<double>(end - start).count();
+}
+
+inline
+double median(std::vector<double> v) {
+   std::sort(v.begin(), v.end());
+   const std::size_t m = v.size()/2;
+   return (v.size()%2) ? v[m] : 0.5*(v[m-1] + v[m]);
+}
+
+//calibration: iterations doubled until one sample takes min_time (also warm-up), then samples of this many iterations
+inline
+result_t measure(const case_t& c, std::size_t samples, double min_time) {
+   std::size_t n = 1;
+   while(seconds(c, n) < min_time && n < (std::size_t(1)<<40)) {
+      n *= 2;
+   }
+
+   std::vector<double> times(samples);
+   for(std::size_t s = 0; s < samples; ++s) {
+      times[s] = seconds(c, n)/double(n)*1e9;
+   }
+
+   result_t r;
+   r.c = &c;
+   r.iterations = n;
+   r.samples = samples;
+   r.median = median(times);
+   std::vector<double> deviations(samples);
+   for(std::size_t s = 0; s < samples; ++s) {
+      deviations[s] = std::fabs(times[s] - r.median);
+   }
+   r.mad = median(deviations);
+   r.min = *std::min_element(times.begin(), times.end());
+   return r;
+}
+
+//index of result of variant "baseline" of same group and operation, results.size() if none
+inline
+std::size_t baseline_index(const std::vector<result_t>& results, const result_t& r) {
+   for(std::size_t i = 0; i < results.size(); ++i) {
+      const case_t& b = *results[i].c;
+      if(b.variant=="baseline" && b.group==r.c->group && b.operation==r.c->operation) {
+         return i;
+      }
+   }
+   return results.size();
+}
+
+//time of variant "baseline" of same group and operation, 0 if none
+inline
+double baseline_of(const std::vector<result_t>& results, const result_t& r) {
+   const std::size_t i = baseline_index(results, r);
+   return (i < results.size()) ? results[i].median : 0.0;
+}
+
+inline
+void write_csv(std::FILE* f, const std::vector<result_t>& results) {
+   std::fprintf(f, "group,operation,variant,iterations,samples,median_ns,mad_ns,min_ns,ratio_to_baseline\n");
+   for(std::size_t i = 0; i < results.size(); ++i) {
+      const result_t& r = results[i];
+      const double b = baseline_of(results, r);
+      std::fprintf(f, "%s,\"%s\",%s,%zu,%zu,%.4f,%.4f,%.4f,%.4f\n", r.c->group.c_str(), r.c->operation.c_str(), r.c->variant.c_str(),
+                   r.iterations, r.samples, r.median, r.mad, r.min, (b > 0.0) ? r.median/b : 0.0);
+   }
+}
+
+inline
+void write_json(std::FILE* f, const std::vector<result_t>& results) {
+   std::fprintf(f, "[\n");
+   for(std::size_t i = 0; i < results.size(); ++i) {
+      const result_t& r = results[i];
+      const double b = baseline_of(results, r);
+      std::fprintf(f, "  {\"group\": \"%s\", \"operation\": \"%s\", \"variant\": \"%s\", \"iterations\": %zu, \"samples\": %zu, "
+                      "\"median_ns\": %.4f, \"mad_ns\": %.4f, \"min_ns\": %.4f, \"ratio_to_baseline\": %.4f}%s\n",
+                   r.c->group.c_str(), r.c->operation.c_str(), r.c->variant.c_str(), r.iterations, r.samples,
+                   r.median, r.mad, r.min, (b > 0.0) ? r.median/b : 0.0, (i+1 < results.size()) ? "," : "");
+   }
+   std::fprintf(f, "]\n");
+}
+
+//measurement of registered cases matching filter (substring of "group operation variant"), table on stdout
+//guard: fails (returns 2) if the median of a case exceeds max_ratio times the one of its baseline (max_ratio 0: no guard)
+inline
+int run(int argc, char** argv, double max_ratio = 0.0) {
+   std::string filter;
+   std::size_t samples = 15;
+   double min_time = 0.01;
+   const char* csv = 0;
+   const char* json = 0;
+   for(int i = 1; i < argc; ++i) {
+      if(!std::strcmp(argv[i], "--filter") && i+1 < argc) filter = argv[++i];
+      else if(!std::strcmp(argv[i], "--samples") && i+1 < argc) samples = std::max(1ul, std::strtoul(argv[++i], 0, 10));
+      else if(!std::strcmp(argv[i], "--min-time") && i+1 < argc) min_time = std::atof(argv[++i])*1e-3;
+      else if(!std::strcmp(argv[i], "--csv") && i+1 < argc) csv = argv[++i];
+      else if(!std::strcmp(argv[i], "--json") && i+1 < argc) json = argv[++i];
+      else if(!std::strcmp(argv[i], "--max-ratio") && i+1 < argc) max_ratio = std::atof(argv[++i]);
+      else {
+         std::cerr << "usage: " << argv[0] << " [--filter text] [--samples n] [--min-time ms] [--csv file] [--json file] [--max-ratio r]" << std::endl;
+         return 1;
+      }
+   }
+
+   std::vector<result_t> results;
+   const std::vector<case_t>& cases = registry();
+   for(std::size_t i = 0; i < cases.size(); ++i) {
+      const std::string name = cases[i].group + " " + cases[i].operation + " " + cases[i].variant;
+      if(!filter.empty() && name.find(filter)==std::string::npos) continue;
+      results.push_back(measure(cases[i], samples, min_time));
+   }
+
+   std::printf("%-6s %-12s %-12s %12s %10s %10s %10s %8s\n", "group", "operation", "variant", "iterations", "median/ns", "mad/ns", "min/ns", "ratio");
+   for(std::size_t i = 0; i < results.size(); ++i) {
+      const result_t& r = results[i];
+      const double b = baseline_of(results, r);
+      char ratio[32] = "-";
+      if(b > 0.0) std::snprintf(ratio, sizeof(ratio), "%.3f", r.median/b);
+      std::printf("%-6s %-12s %-12s %12zu %10.3f %10.3f %10.3f %8s\n", r.c->group.c_str(), r.c->operation.c_str(), r.c->variant.c_str(),
+                  r.iterations, r.median, r.mad, r.min, ratio);
+   }
+
+   if(csv) {
+      std::FILE* f = std::fopen(csv, "w");
+      if(!f) { std::cerr << "cannot write " << csv << std::endl; return 1; }
+      write_csv(f, results);
+      std::fclose(f);
+   }
+   if(json) {
+      std::FILE* f = std::fopen(json, "w");
+      if(!f) { std::cerr << "cannot write " << json << std::endl; return 1; }
+      write_json(f, results);
+      std::fclose(f);
+   }
+
+   //failing case measured again with its baseline, failure only if exceeding max_ratio in every attempt (timing noise)
+   int status = 0;
+   for(std::size_t i = 0; i < results.size() && max_ratio > 0.0; ++i) {
+      const result_t& r = results[i];
+      const std::size_t b = baseline_index(results, r);
+      if(b==results.size() || b==i) continue;
+      double ratio = r.median/results[b].median;
+      for(int attempt = 1; attempt < 3 && ratio > max_ratio; ++attempt) {
+         const double median = measure(*r.c, samples, min_time).median;
+         ratio = median/measure(*results[b].c, samples, min_time).median;
+      }
+      if(ratio > max_ratio) {
+         std::printf("guard failed: %s %s %s %.3f times baseline (limit %.3f)\n", r.c->group.c_str(), r.c->operation.c_str(), r.c->variant.c_str(),
+                     ratio, max_ratio);
+         status = 2;
+      }
+   }
+   return status;
+}
+
+} //end namespace bench
+
+#endif
@@ -1,52 +1,27 @@
 #include "gaalet.h"
-#include <sys/time.h>
+#include "benchmark.h"
 #include <cmath>
 
-int main()
+int main(int argc, char** argv)
 {
-   timeval start, end;
-   double solveTime;
-
-   
    gaalet::mv<1, 2, 4, 7>::type a = {1.0, 1.0, 0.0, 0.0};
    gaalet::mv<0, 3, 5, 6>::type b = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
 
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
-      a = b*a*(!b);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-   
-   std::cout << "operator!(): multiply solve time: " << solveTime << std::endl;
-
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
-      a = b*a*inverse(b);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-   
-   std::cout << "inverse(): multiply solve time: " << solveTime << std::endl;
-
-  
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
+   bench::add("E3", "b*a*b^-1", "operator!", [=]() mutable {
+      bench::do_not_optimize(b);
       a = b*a*(!b);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-   
-   std::cout << "operator!(): multiply solve time: " << solveTime << std::endl;
-
-
-   gettimeofday(&start, 0);
-   for(int i = 0; i<1e8; ++i) {
+      bench::do_not_optimize(a);
+   });
+   bench::add("E3", "b*a*b^-1", "inverse", [=]() mutable {
+      bench::do_not_optimize(b);
       a = b*a*inverse(b);
-   }
-   gettimeofday(&end, 0);
-   solveTime = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_usec - start.tv_usec)*1e-6;
-   
-   std::cout << "inverse(): multiply solve time: " << solveTime << std::endl;
+      bench::do_not_optimize(a);
+   });
+   bench::add("E3", "b*a*b^-1", "materialize", [=]() mutable {
+      bench::do_not_optimize(b);
+      a = materialize(b*a)*(!b);
+      bench::do_not_optimize(a);
+   });
+
+   return bench::run(argc, argv);
 }
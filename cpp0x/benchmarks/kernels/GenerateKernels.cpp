@@ -0,0 +1,82 @@
+#include "gaalet.h"
+#include "codegen.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+//build-time generator of the kernels of generated_kernels.h, symbolic evaluation of gaalet expressions
+//usage: GenerateKernels output_file
+
+typedef gaalet::algebra<gaalet::signature<4,1>, gaalet::symbex> sm;
+
+typedef sm::mv<0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x11, 0x12, 0x14>::type S_type;
+typedef sm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+
+int main(int argc, char** argv)
+{
+   if(argc!=2) {
+      std::cerr << "usage: " << argv[0] << " output_file" << std::endl;
+      return 1;
+   }
+
+   sm::mv<0x01>::type e1 = {1.0};
+   sm::mv<0x02>::type e2 = {1.0};
+   sm::mv<0x04>::type e3 = {1.0};
+   sm::mv<0x08>::type ep = {1.0};
+   sm::mv<0x10>::type em = {1.0};
+   sm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
+   sm::mv<0x08, 0x10>::type einf = em+ep;
+   sm::mv<0x07>::type Ie = e1*e2*e3;
+
+   //Horizon benchmark: circle of the horizon of point (x, y, z) seen from sphere of radius r around the origin
+   gaalet::codegen horizon("horizon");
+   {
+      gaalet::symbex x = horizon.scalar_input("x");
+      gaalet::symbex y = horizon.scalar_input("y");
+      gaalet::symbex z = horizon.scalar_input("z");
+      gaalet::symbex r = horizon.scalar_input("r");
+
+      auto P = eval(e1*x + e2*y + e3*z + e0*1.0 + einf*(x*x+y*y+z*z)*0.5);
+      sm::mv<0x08, 0x10>::type S = e0 - einf*0.5*r*r;
+      horizon.output("C", S^(P+(P&S)*einf));
+   }
+
+   //CarDynamicsCGA state equation: time derivative of body displacement versor D_b with screw velocity V_b
+   gaalet::codegen body_displacement("body_displacement_derivative");
+   {
+      D_type D_b = body_displacement.input<D_type>("D_b");
+      S_type V_b = body_displacement.input<S_type>("V_b");
+
+      body_displacement.output("dD_b", part_type<D_type>(D_b*V_b*0.5));
+   }
+
+   //CarDynamicsCGA state equation: screw velocity of wheel frame D_w with wheel angular velocity w_w and spring damper velocity du_w
+   gaalet::codegen wheel_velocity("wheel_velocity");
+   {
+      D_type D_w = wheel_velocity.input<D_type>("D_w");
+      S_type V_b = wheel_velocity.input<S_type>("V_b");
+      gaalet::symbex w_w = wheel_velocity.scalar_input("w_w");
+      gaalet::symbex du_w = wheel_velocity.scalar_input("du_w");
+
+      sm::mv<0x00, 0x06>::type R_w = {cos(-0.25*M_PI), sin(-0.25*M_PI)};
+
+      wheel_velocity.output("V_w", grade<2>((~R_w)*((~D_w)*V_b*D_w - Ie*w_w*e2 + einf*(-du_w)*e3)*R_w));
+   }
+
+   std::ofstream file(argv[1]);
+   file << "#ifndef __GAALET_GENERATED_KERNELS_H" << std::endl;
+   file << "#define __GAALET_GENERATED_KERNELS_H" << std::endl << std::endl;
+   file << "#include <cmath>" << std::endl;
+   file << "#include <cstddef>" << std::endl << std::endl;
+   horizon.write(file);
+   file << std::endl;
+   body_displacement.write(file);
+   file << std::endl;
+   wheel_velocity.write(file);
+   file << std::endl << "#endif" << std::endl;
+
+   std::cout << "kernels written to " << argv[1] << ": horizon " << horizon.temporaries() << ", body_displacement_derivative " << body_displacement.temporaries()
+             << ", wheel_velocity " << wheel_velocity.temporaries() << " temporaries" << std::endl;
+
+   return file ? 0 : 1;
+}
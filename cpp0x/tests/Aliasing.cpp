@@ -0,0 +1,70 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+
+typedef em::mv<0, 1, 2, 3, 4, 5, 6, 7>::type M_type;
+
+//strategy of assignment of expression E to multivector D
+template<class D, class E>
+void strategy(const char* name, const E&)
+{
+   typedef typename D::template Aliasing<E> aliasing;
+   std::cout << name << ": in place by type: " << aliasing::in_place << ", buffered elements: " << aliasing::buffered
+             << ", several elements read: " << aliasing::several << std::endl;
+}
+
+int main()
+{
+   M_type a = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+   M_type b = {0.5, -1.0, 0.25, 2.0, -0.75, 1.5, 0.125, -2.0};
+   em::mv<0, 3>::type r = {std::cos(0.3), std::sin(0.3)};
+
+   strategy<M_type>("a + b", a + b);
+   strategy<M_type>("2.0*~a - grade<1>(b)", 2.0*(~a) - grade<1>(b));
+   strategy<M_type>("dual(a)", dual(a));
+   strategy<M_type>("a*b", a*b);
+   strategy<M_type>("a + b*a", a + b*a);
+
+   //element-wise: in place
+   M_type c = a;
+   c = c + b - 0.5*c;
+   std::cout << "c = c + b - 0.5*c: " << c << ", expected: " << eval(a + b - 0.5*a) << std::endl;
+
+   //permutation of elements: elements read after being written buffered
+   c = a;
+   c = dual(c);
+   std::cout << "c = dual(c): " << c << ", expected: " << eval(dual(a)) << std::endl;
+
+   //products reading the destination: temporary
+   c = a;
+   c = r*c*(!r);
+   std::cout << "c = r*c*!r: " << c << ", expected: " << eval(r*a*(!r)) << std::endl;
+
+   //products not reading the destination: in place by addresses
+   c = a*b;
+   std::cout << "c = a*b: " << c << ", expected: " << eval(a*b) << std::endl;
+
+   //compound operators
+   c = a;
+   c += b;
+   std::cout << "c += b: " << c << std::endl;
+   c -= 2.0*b;
+   std::cout << "c -= 2.0*b: " << c << ", expected: " << eval(a - b) << std::endl;
+   c = a;
+   c *= b;
+   std::cout << "c *= b: " << c << ", expected: " << eval(a*b) << std::endl;
+   c = a;
+   c *= 0.5;
+   std::cout << "c *= 0.5: " << c << std::endl;
+   c = a;
+   c ^= b;
+   std::cout << "c ^= b: " << c << ", expected: " << eval(a^b) << std::endl;
+   c = a;
+   c += c*b;
+   std::cout << "c += c*b: " << c << ", expected: " << eval(a + a*b) << std::endl;
+
+   //elements outside of configuration list discarded as in assignment
+   em::mv<1, 2, 4>::type x = {1.0, 2.0, 3.0};
+   x *= r;
+   std::cout << "x *= r: " << x << ", expected: " << eval(grade<1>(em::mv<1, 2, 4>::type({1.0, 2.0, 3.0})*r)) << std::endl;
+}
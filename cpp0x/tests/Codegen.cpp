@@ -0,0 +1,26 @@
+#include "gaalet.h"
+#include "codegen.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>, gaalet::symbex> sem;
+
+int main()
+{
+   //rotation of a vector: scalar and batch kernel, terms of the sandwich product shared by the elements
+   gaalet::codegen rotate("rotate");
+   sem::mv<0, 3, 5, 6>::type R = rotate.input<sem::mv<0, 3, 5, 6>::type>("R");
+   sem::mv<1, 2, 4>::type x = rotate.input<sem::mv<1, 2, 4>::type>("x");
+   rotate.output("y", grade<1>(R*x*~R));
+   rotate.write(std::cout);
+   std::cout << "temporaries: " << rotate.temporaries() << std::endl << std::endl;
+
+   //polynomial expansion: (s+a)*(s+a)-(s-a)*(s-a) = 4*s*a
+   gaalet::codegen square("square");
+   gaalet::symbex a = square.scalar_input("a");
+   gaalet::symbex s = square.scalar_input("s");
+   sem::mv<0>::type q = {(s+a)*(s+a)-(s-a)*(s-a)};
+   square.output("q", q);
+   square.write(std::cout);
+
+   gaalet::symbex_expansion expansion;
+   std::cout << "expanded: " << expansion.simplify(q[0]) << ", operations: " << gaalet::symbex_expansion::operations(q[0].node()) << std::endl;
+}
@@ -0,0 +1,33 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+int main()
+{
+   using namespace gaalet::cga;
+
+   cm::mv<0x01>::type r_e1 = {1.0};
+   cm::mv<0x02>::type r_e2 = {1.0};
+   cm::mv<0x04>::type r_e3 = {1.0};
+   cm::mv<0x08>::type r_ep = {1.0};
+   cm::mv<0x10>::type r_em = {1.0};
+   cm::mv<0x08, 0x10>::type r_e0 = 0.5*(r_em-r_ep);
+   cm::mv<0x08, 0x10>::type r_einf = r_em+r_ep;
+
+   std::cout << "sizeof(einf): " << sizeof(einf) << ", sizeof(einf*e0): " << sizeof(einf*e0) << std::endl;
+   std::cout << "e0: " << e0 << ", einf: " << einf << ", Ic: " << Ic << std::endl;
+   std::cout << "e0&einf: " << (e0&einf) << ", einf*e0: " << einf*e0 << ", e1*e2*e3*ep*em: " << e1*e2*e3*ep*em << std::endl;
+   std::cout << "gaalet::blade<0x03>()*e1: " << gaalet::blade<0x03>()*e1 << std::endl;
+
+   cm::mv<1, 2, 4>::type x = {1.0, 2.0, 3.0};
+   cm::mv<1, 2, 4, 8, 0x10>::type P = x + 0.5*(x&x)*einf + e0;
+   cm::mv<1, 2, 4, 8, 0x10>::type r_P = x + 0.5*(x&x)*r_einf + r_e0;
+   std::cout << "P: " << P << ", runtime constants: " << r_P << std::endl;
+   std::cout << "P&einf: " << (P&einf) << ", runtime constants: " << (P&r_einf) << std::endl;
+   std::cout << "P&e0: " << (P&e0) << ", runtime constants: " << (P&r_e0) << std::endl;
+   std::cout << "einf^P: " << (einf^P) << ", runtime constants: " << (r_einf^P) << std::endl;
+   std::cout << "P*Ic: " << P*Ic << ", runtime constants: " << P*(r_e1*r_e2*r_e3*r_ep*r_em) << std::endl;
+
+   auto T = eval(one + 0.5*einf*(0.3*e3));
+   std::cout << "T: " << T << ", T*P*~T: " << grade<1>(T*P*~T) << std::endl;
+}
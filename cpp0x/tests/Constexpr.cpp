@@ -0,0 +1,50 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+//multivectors and expressions of namespace scope are constant expressions
+constexpr em::mv<1, 2, 4>::type a = {1.0, 2.0, 3.0};
+constexpr em::mv<0, 3, 5, 6>::type R = {0.5, 0.5, 0.5, 0.5};
+
+constexpr auto D = R*a*~R;
+constexpr em::mv<1, 2, 4>::type b = grade<1>(D);
+
+static_assert(D.element<0x01>()==3.0 && D.element<0x02>()==-1.0 && D.element<0x04>()==-2.0, "rotation not folded");
+static_assert(b.element<0x02>()==D.element<0x02>(), "evaluation not folded");
+//products of multivectors evaluate by table-driven kernel at runtime, their elements fold
+static_assert((a&b).element<0x00>()==-5.0, "inner product not folded");
+static_assert((a^b).element<0x03>()==-7.0, "outer product not folded");
+
+//products of constants evaluate element-wise
+typedef gaalet::cga::e1_t e1_t;
+typedef gaalet::cga::einf_t einf_t;
+constexpr cm::mv<0x09, 0x11>::type e1einf = e1_t()*einf_t();
+static_assert(e1einf.element<0x09>()==1.0 && e1einf.element<0x11>()==1.0, "product of constants not folded");
+
+//missing elements are null elements
+constexpr em::mv<1, 2, 4>::type c = {1.0};
+static_assert(c.element<0x02>()==0.0 && c.element<0x03>()==0.0, "null element not folded");
+
+//translator of nilpotent constant bivector, exp(t) = 1 + t
+typedef gaalet::constant<cm::metric, double, gaalet::constant_element<0x09, 1, 2>, gaalet::constant_element<0x11, 1, 2>> t_t;
+static_assert(gaalet::is_nilpotent<t_t>::value, "translator generator not nilpotent");
+static_assert(!gaalet::is_nilpotent<gaalet::cga::E_t>::value, "Minkowski plane nilpotent");
+
+constexpr auto T = exp(t_t());
+constexpr cm::mv<1, 2, 4, 8, 0x10>::type P = {0.0, 0.0, 0.0, -0.5, 0.5};
+constexpr cm::mv<1, 2, 4, 8, 0x10>::type TP = T*P*~T;
+static_assert(TP.element<0x01>()==-1.0 && TP.element<0x10>()==1.0, "translation not folded");
+
+int main()
+{
+   std::cout << "D: " << D << ", b: " << b << ", a&b: " << (a&b) << std::endl;
+   std::cout << "c: " << c << std::endl;
+   std::cout << "exp(t): " << T << ", T*P*~T: " << TP << std::endl;
+
+   //element-wise construction at runtime, stateful expressions on a prepared copy
+   em::mv<1, 2, 4>::type x = {1.0, 0.0, 0.0};
+   em::mv<1, 2, 4>::type y = R*x*~R;
+   em::mv<0, 3, 5, 6>::type r = exp(em::mv<3>::type({-0.25*M_PI}));
+   std::cout << "y: " << y << ", r: " << r << ", r*x*~r: " << r*x*~r << std::endl;
+}
@@ -0,0 +1,65 @@
+#include "gaalet.h"
+
+typedef gaalet::counting<double> cd;
+typedef gaalet::algebra<gaalet::signature<4,1>, cd> cm;
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   //scalar operations
+   {
+      gaalet::operation_scope scope;
+      cd a = 2.0;
+      cd b = a*a + 1.0;
+      cd c = sqrt(b)/cos(a);
+      std::cout << "c: " << c << ", counts: " << scope.counts() << std::endl;
+   }
+
+   //horizon of Horizon benchmark: C = S^(P+(P&S)*einf), operands assigned from uninstrumented double expressions
+   cm::mv<1, 2, 4, 8, 0x10>::type P = 2.0*e1 + 1.0*e2 + 0.5*e3 + e0 + 0.5*(2.0*2.0 + 1.0*1.0 + 0.5*0.5)*einf;
+   cm::mv<0x08, 0x10>::type S = e0 - 0.5*0.5*0.5*einf;
+   cm::mv<0x09, 0x0a, 0x0c, 0x11, 0x12, 0x14, 0x18>::type C;
+   {
+      gaalet::operation_report report(std::cout, "C = S^(P+(P&S)*einf)");
+      C = (S^(P+(P&S)*einf));
+   }
+   {
+      gaalet::operation_report report(std::cout, "C = S^(P+eval(P&S)*einf)");
+      C = (S^(P+eval(P&S)*einf));
+   }
+   std::cout << "C: " << C << std::endl;
+
+   //lazy products: inner product evaluated per element of the outer product
+   cm::mv<0x00, 0x03>::type R = {cos(-0.25), sin(-0.25)};
+   cm::mv<1, 2, 4, 8, 0x10>::type Q;
+   {
+      gaalet::operation_report report(std::cout, "Q = grade<1>(R*P*~R)");
+      Q = grade<1>(R*P*~R);
+   }
+   {
+      gaalet::operation_report report(std::cout, "Q = sandwich(R, P)");
+      Q = gaalet::sw::apply(R, P);
+   }
+   std::cout << "Q: " << Q << std::endl;
+
+   //functions of expressions with state
+   cm::mv<0x03>::type B = {0.3};
+   cm::mv<0x00, 0x03>::type D;
+   {
+      gaalet::operation_report report(std::cout, "D = exp(B)");
+      D = exp(B);
+   }
+   std::cout << "D: " << D << std::endl;
+
+   //counters per thread
+   gaalet::operation_scope scope;
+   Q = P + P;
+   gaalet::operation_count c = scope.counts();
+   scope.reset();
+   std::cout << "P + P: " << c.add << " additions, after reset: " << scope.counts().flops() << " flops" << std::endl;
+}
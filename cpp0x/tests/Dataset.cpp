@@ -0,0 +1,167 @@
+#include "gaalet.h"
+#include "dataset.h"
+
+#include <cstddef>
+#include <cstdio>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef gaalet::algebra<gaalet::signature<4,1>, gaalet::precision<float, double>> cmx;
+
+typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   const std::size_t n = 1000;
+   auto point = [](std::size_t i) {
+      const double x = 0.01*double(i), y = 1.0 - x, z = 0.5;
+      return P_type(x*e1 + y*e2 + z*e3 + e0 + 0.5*(x*x + y*y + z*z)*einf);
+   };
+
+   //aos dataset: streamed multivectors, read in place
+   {
+      gaalet::dataset_writer<P_type> writer("Dataset_aos.gmv", gaalet::dataset_aos);
+      for(std::size_t i = 0; i < n; ++i) {
+         writer.push(point(i));
+      }
+      writer.close();
+
+      gaalet::dataset_reader<P_type> reader("Dataset_aos.gmv");
+      bool equal = (reader.length() == n);
+      for(std::size_t i = 0; i < n && equal; ++i) {
+         for(unsigned int k = 0; k < P_type::size; ++k) {
+            equal = equal && (reader.begin()[i][k] == point(i)[k]);
+         }
+      }
+      std::cout << "aos: " << reader.length() << " points, equal: " << equal << ", P[7]: " << reader[7] << std::endl;
+   }
+
+   //soa dataset: partial blocks, batch written from blade arrays, blocks read in place as batch operands
+   {
+      cm::mv<1, 2, 4, 8, 0x10>::array_type X(n);
+      for(std::size_t i = 0; i < n; ++i) {
+         X.set(i, point(i));
+      }
+      gaalet::dataset_writer<P_type> writer("Dataset_soa.gmv", gaalet::dataset_soa, 256);
+      writer.push(point(0));
+      writer.write(X);
+      writer.write(X.view(0, 300));
+      writer.close();
+
+      gaalet::dataset_reader<P_type> reader("Dataset_soa.gmv");
+      bool equal = (reader.length() == 1 + n + 300);
+      for(std::size_t i = 0; i < reader.length() && equal; ++i) {
+         const std::size_t j = (i == 0) ? 0 : (i <= n) ? i - 1 : i - 1 - n;
+         for(unsigned int k = 0; k < P_type::size; ++k) {
+            equal = equal && (reader[i][k] == point(j)[k]);
+         }
+      }
+      bool aligned = true;
+      for(std::size_t b = 0; b < reader.blocks(); ++b) {
+         aligned = aligned && (reinterpret_cast<std::uintptr_t>(reader.block(b).blade(1)) % GAALET_ARRAY_ALIGNMENT == 0);
+      }
+      std::cout << std::dec << "soa: " << reader.length() << " points in " << reader.blocks() << " blocks, equal: " << equal << ", aligned: " << aligned << std::endl;
+
+      //blocks as operands of batch expressions
+      cm::mv<0x03>::type B = {0.3};
+      D_type D = exp(-0.5*B)*(gaalet::cga::one + 0.5*einf*(e1 + 2.0*e2 - e3));
+      double deviation = 0.0;
+      for(std::size_t b = 0; b < reader.blocks(); ++b) {
+         gaalet::dataset_reader<P_type>::view_t block = reader.block(b);
+         cm::mv<1, 2, 4, 8, 0x10>::array_type Y(block.length());
+         Y = grade<1>(D*block*~D);
+         for(std::size_t i = 0; i < block.length(); ++i) {
+            P_type y = grade<1>(D*block[i]*~D);
+            for(unsigned int k = 0; k < P_type::size; ++k) {
+               deviation = std::max(deviation, std::fabs(Y[i][k] - y[k]));
+            }
+         }
+      }
+      std::cout << "D*block*~D: deviation from single evaluation: " << deviation << std::endl;
+   }
+
+   //float storage of precision policy: element type recorded in header
+   {
+      gaalet::dataset_writer<cmx::mv<1, 2, 4, 8, 0x10>::type> writer("Dataset_float.gmv", gaalet::dataset_aos);
+      writer.push(point(3));
+      writer.close();
+      gaalet::dataset_reader<cmx::mv<1, 2, 4, 8, 0x10>::type> reader("Dataset_float.gmv");
+      std::cout << "float storage: " << reader[0] << std::endl;
+   }
+
+   //arrays of multivectors after pushed multivectors: aos block buffer and array by one write, soa blocks copied blade by blade
+   {
+      std::vector<P_type> points(n);
+      for(std::size_t i = 0; i < n; ++i) {
+         points[i] = point(i);
+      }
+      const gaalet::dataset_layout layouts[2] = { gaalet::dataset_aos, gaalet::dataset_soa };
+      for(unsigned int l = 0; l < 2; ++l) {
+         gaalet::dataset_writer<P_type> writer("Dataset_array.gmv", layouts[l], 64);
+         writer.push(point(0));
+         writer.write(points.data(), n);
+         writer.write(points.data(), 5);
+         writer.close();
+
+         gaalet::dataset_reader<P_type> reader("Dataset_array.gmv");
+         bool equal = (reader.length() == 1 + n + 5);
+         for(std::size_t i = 0; i < reader.length() && equal; ++i) {
+            const std::size_t j = (i == 0) ? 0 : (i <= n) ? i - 1 : i - 1 - n;
+            for(unsigned int k = 0; k < P_type::size; ++k) {
+               equal = equal && (reader[i][k] == point(j)[k]);
+            }
+         }
+         std::cout << std::dec << ((l == 0) ? "aos" : "soa") << " arrays: " << reader.length() << " points, equal: " << equal << std::endl;
+      }
+   }
+
+   //count of corrupt header checked against file size
+   {
+      std::FILE* f = std::fopen("Dataset_array.gmv", "r+b");
+      const std::uint64_t count = ~std::uint64_t(0)/2;
+      std::fseek(f, offsetof(gaalet::dataset_header, count), SEEK_SET);
+      std::fwrite(&count, sizeof(count), 1, f);
+      std::fclose(f);
+      try {
+         gaalet::dataset_reader<P_type> reader("Dataset_array.gmv");
+         std::cout << "corrupt count: not detected" << std::endl;
+      }
+      catch(const gaalet::dataset_error& e) {
+         std::cout << "corrupt count: " << e.what() << std::endl;
+      }
+   }
+
+   //requested types checked when opening
+   try {
+      gaalet::dataset_reader<cm::mv<1, 2, 4, 8>::type> reader("Dataset_aos.gmv");
+      std::cout << "blade list: not detected" << std::endl;
+   }
+   catch(const gaalet::dataset_error& e) {
+      std::cout << "blade list: " << e.what() << std::endl;
+   }
+   try {
+      gaalet::dataset_reader<gaalet::algebra<gaalet::signature<5,0>>::mv<1, 2, 4, 8, 0x10>::type> reader("Dataset_aos.gmv");
+      std::cout << "signature: not detected" << std::endl;
+   }
+   catch(const gaalet::dataset_error& e) {
+      std::cout << "signature: " << e.what() << std::endl;
+   }
+   try {
+      gaalet::dataset_reader<P_type> reader("Dataset_float.gmv");
+      std::cout << "element type: not detected" << std::endl;
+   }
+   catch(const gaalet::dataset_error& e) {
+      std::cout << "element type: " << e.what() << std::endl;
+   }
+
+   std::remove("Dataset_aos.gmv");
+   std::remove("Dataset_soa.gmv");
+   std::remove("Dataset_float.gmv");
+   std::remove("Dataset_array.gmv");
+}
@@ -0,0 +1,65 @@
+#include "gaalet.h"
+
+typedef gaalet::counting<double> cd;
+typedef gaalet::algebra<gaalet::signature<4,1>, cd> cm;
+
+//static cost model against counted operations of one evaluation
+template<class E, class D>
+void compare(const char* name, D& d, const gaalet::expression<E>& e)
+{
+   gaalet::operation_scope scope;
+   d = e;
+   std::cout << name << ":" << std::endl;
+   std::cout << "   model:   " << gaalet::cost_of(e) << std::endl;
+   std::cout << "   counted: " << scope.counts() << std::endl;
+}
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   cm::mv<1, 2, 4, 8, 0x10>::type P = 2.0*e1 + 1.0*e2 + 0.5*e3 + e0 + 0.5*(2.0*2.0 + 1.0*1.0 + 0.5*0.5)*einf;
+   cm::mv<0x08, 0x10>::type S = e0 - 0.5*0.5*0.5*einf;
+   cm::mv<0x00, 0x03>::type R = {cos(-0.25), sin(-0.25)};
+   cm::mv<0x03>::type B = {0.3};
+
+   cm::mv<0x09, 0x0a, 0x0c, 0x11, 0x12, 0x14, 0x18>::type C;
+   compare("S^(P+(P&S)*einf)", C, S^(P+(P&S)*einf));
+   compare("S^(P+materialize(P&S)*einf)", C, S^(P+materialize(P&S)*einf));
+
+   cm::mv<1, 2, 4, 8, 0x10>::type Q;
+   compare("grade<1>(R*P*~R)", Q, grade<1>(R*P*~R));
+   compare("grade<1>(materialize(R*P)*~R)", Q, grade<1>(materialize(R*P)*~R));
+   compare("sandwich(R, P)", Q, gaalet::sw::apply(R, P));
+   compare("P+P-P", Q, P+P-P);
+
+   cm::mv<0x00, 0x03>::type D;
+   compare("exp(B)", D, exp(B));
+   compare("!R", D, !R);
+   compare("log(R)", D, log(R));
+
+   //nested stateful nodes: each operand prepared once, initialization linear in depth
+   compare("!exp(B)", D, !exp(B));
+   compare("!!exp(B)", D, !!exp(B));
+   compare("!!!exp(B)", D, !!!exp(B));
+   compare("log(!exp(B))", D, log(!exp(B)));
+
+   cm::mv<0x00>::type s;
+   compare("magnitude(P)", s, magnitude(P));
+   compare("magnitude(!exp(B))", s, magnitude(!exp(B)));
+
+   //budgets at compile time
+   static_assert(gaalet::expression_cost<decltype(R*P)>::mul == 10, "R*P: ten multiplications");
+   static_assert(gaalet::expression_cost<decltype(gaalet::sw::apply(R, P))>::flops < gaalet::expression_cost<decltype(grade<1>(R*P*~R))>::flops,
+                 "sandwich cheaper than lazy products");
+   static_assert(gaalet::expression_cost<decltype(exp(B))>::transcendental == 3, "exp(B): square root, cosine and sine");
+
+   //cost table of terms, elements and initialization
+   typedef gaalet::expression_cost<decltype(grade<1>(materialize(R*P)*~R))> cost_t;
+   std::cout << "grade<1>(materialize(R*P)*~R): init " << cost_t::init::count() << std::endl;
+   std::cout << "   elements " << cost_t::elements::count() << std::endl;
+}
@@ -0,0 +1,127 @@
+#include "gaalet.h"
+
+#include <algorithm>
+#include <cmath>
+
+typedef gaalet::ad::fvar<double, 3> f3;
+typedef gaalet::ad::fvar<double, 4> f4;
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<3,0>, f3> fm3;
+typedef gaalet::algebra<gaalet::signature<3,0>, f4> fm4;
+
+//largest deviation of the Jacobian of f at x from central differences
+template<unsigned int N, class F, class X>
+double deviation(F f, const X& x)
+{
+   auto J = gaalet::ad::jacobian(f(gaalet::ad::variables<N>(x)));
+   const double h = 1e-6;
+   double d = 0.0;
+   for(unsigned int i = 0; i < N; ++i) {
+      X x_p = x;
+      X x_m = x;
+      x_p[i] += h;
+      x_m[i] -= h;
+      auto y_p = gaalet::ad::values(f(gaalet::ad::variables<N>(x_p)));
+      auto y_m = gaalet::ad::values(f(gaalet::ad::variables<N>(x_m)));
+      for(unsigned int k = 0; k < J.size(); ++k) {
+         d = std::max(d, std::fabs(J[k][i] - (y_p[k] - y_m[k])/(2.0*h)));
+      }
+   }
+   return d;
+}
+
+template<class J>
+void print_jacobian(const J& jac)
+{
+   for(unsigned int k = 0; k < jac.size(); ++k) {
+      std::cout << "   ";
+      for(unsigned int i = 0; i < jac[k].size(); ++i) {
+         std::cout << " " << jac[k][i];
+      }
+      std::cout << std::endl;
+   }
+}
+
+int main()
+{
+   //scalar functions
+   f3 x(0.5, 0);
+   f3 y = sin(x)*exp(x) + sqrt(1.0 + x*x)/x;
+   std::cout << "y: " << y << ", analytic derivative: "
+             << cos(0.5)*exp(0.5) + sin(0.5)*exp(0.5) + 0.5/std::sqrt(1.25)/0.5 - std::sqrt(1.25)/0.25 << std::endl;
+
+   //rotated vector by bivector parameters: Jacobian from a single evaluation
+   fm3::mv<1>::type e1 = {1.0};
+   auto rotated = [&](const fm3::mv<3,5,6>::type& b) {
+      return eval(grade<1>(exp(-0.5*b)*e1*~exp(-0.5*b)));
+   };
+   em::mv<3,5,6>::type b = {0.3, -0.2, 0.5};
+   std::cout << "R*e1*~R: " << gaalet::ad::values(rotated(gaalet::ad::variables<3>(b))) << ", Jacobian:" << std::endl;
+   print_jacobian(gaalet::ad::jacobian(rotated(gaalet::ad::variables<3>(b))));
+   std::cout << "deviation from differences < 1e-6: " << (deviation<3>(rotated, b) < 1e-6) << std::endl;
+
+   //exponential at the branch point: vanishing bivector
+   auto exponential = [](const fm3::mv<3,5,6>::type& b) {
+      return eval(exp(b));
+   };
+   em::mv<3,5,6>::type zero = {0.0, 0.0, 0.0};
+   std::cout << "exp(0): " << gaalet::ad::values(exponential(gaalet::ad::variables<3>(zero))) << ", Jacobian:" << std::endl;
+   print_jacobian(gaalet::ad::jacobian(exponential(gaalet::ad::variables<3>(zero))));
+   std::cout << "deviation from differences at 0 < 1e-6: " << (deviation<3>(exponential, zero) < 1e-6)
+             << ", at b: " << (deviation<3>(exponential, b) < 1e-6) << std::endl;
+
+   //hyperbolic functions of bivectors
+   auto hyperbolic_sine = [](const fm3::mv<3,5,6>::type& b) {
+      return eval(sinh(b));
+   };
+   auto hyperbolic_cosine = [](const fm3::mv<3,5,6>::type& b) {
+      return eval(cosh(b));
+   };
+   std::cout << "sinh(0): " << gaalet::ad::values(hyperbolic_sine(gaalet::ad::variables<3>(zero)))
+             << ", cosh(0): " << gaalet::ad::values(hyperbolic_cosine(gaalet::ad::variables<3>(zero))) << std::endl;
+   std::cout << "deviation from differences sinh at 0 < 1e-6: " << (deviation<3>(hyperbolic_sine, zero) < 1e-6)
+             << ", at b: " << (deviation<3>(hyperbolic_sine, b) < 1e-6)
+             << ", cosh at 0: " << (deviation<3>(hyperbolic_cosine, zero) < 1e-6)
+             << ", at b: " << (deviation<3>(hyperbolic_cosine, b) < 1e-6) << std::endl;
+
+   //spinor logarithm: identity rotor and general rotor
+   auto logarithm = [](const fm4::mv<0,3,5,6>::type& r) {
+      return eval(log(r));
+   };
+   em::mv<0,3,5,6>::type one = {1.0, 0.0, 0.0, 0.0};
+   em::mv<0,3,5,6>::type R = {std::cos(0.4), std::sin(0.4)*0.6, 0.0, std::sin(0.4)*0.8};
+   std::cout << "log(1): " << gaalet::ad::values(logarithm(gaalet::ad::variables<4>(one))) << ", Jacobian:" << std::endl;
+   print_jacobian(gaalet::ad::jacobian(logarithm(gaalet::ad::variables<4>(one))));
+   std::cout << "log(R): " << gaalet::ad::values(logarithm(gaalet::ad::variables<4>(R))) << std::endl;
+   std::cout << "deviation from differences at 1 < 1e-6: " << (deviation<4>(logarithm, one) < 1e-6)
+             << ", at R: " << (deviation<4>(logarithm, R) < 1e-6) << std::endl;
+
+   //magnitude and inverse
+   auto mag = [](const fm4::mv<0,3,5,6>::type& r) {
+      return eval(magnitude(r));
+   };
+   auto inv = [](const fm4::mv<0,3,5,6>::type& r) {
+      return eval(!r);
+   };
+   std::cout << "deviation from differences magnitude < 1e-6: " << (deviation<4>(mag, R) < 1e-6)
+             << ", inverse: " << (deviation<4>(inv, R) < 1e-6) << std::endl;
+
+   //gradient descent of U = |R*t_0*~R - t_t|^2 by the bivector parameters of R = exp(-0.5*m)
+   em::mv<1,2,4>::type t_0 = {1.0, 0.0, 0.0};
+   em::mv<1,2,4>::type t_t = {1.0, 2.0, 1.0};
+   t_t = t_t*(1.0/eval(magnitude(t_t)));
+   em::mv<3,5,6>::type m = {0.0, 0.0, 0.0};
+   double U = 1.0;
+   unsigned int steps = 0;
+   for(; steps < 1000 && U > 1e-12; ++steps) {
+      auto m_v = gaalet::ad::variables<3>(m);
+      auto R_m = exp(-0.5*m_v);
+      auto d = eval(grade<1>(R_m*t_0*~R_m) - t_t);
+      f3 U_m = eval(d&d);
+      U = U_m.value;
+      for(unsigned int i = 0; i < 3; ++i) {
+         m[i] -= 0.5*U_m.tangent[i];
+      }
+   }
+   std::cout << "gradient descent: steps < 1000: " << (steps < 1000) << ", t: " << grade<1>(exp(-0.5*m)*t_0*~exp(-0.5*m)) << ", t_t: " << t_t << std::endl;
+}
@@ -0,0 +1,66 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra< gaalet::signature<3,0> > em;
+typedef gaalet::algebra< gaalet::signature<4,1> > cm;
+typedef gaalet::algebra< gaalet::signature<3,0,1> > pm;
+
+//fused sandwich product gaalet::sw::apply(V, X) against V*X*~V
+int main()
+{
+   using gaalet::sw::apply;
+
+   em::mv<1,2,4>::type v = {1.0, 2.0, 3.0};
+   em::mv<0,3,5,6>::type R = {cos(-0.5*0.5*M_PI), sin(-0.5*0.5*M_PI), 0.0, 0.0};
+
+   const auto& s = apply(R,v);
+   std::cout << "apply(R,v): " << s << std::endl;
+   std::cout << "apply(R,v) - <R*v*~R>_1: " << s - grade<1>(R*v*~R) << std::endl;
+   //per evaluation: quadratic forms of R and matrix rows, against both products
+   std::cout << std::dec << "terms: " << decltype(apply(R,v))::kernel::terms << ", matrix elements: " << decltype(apply(R,v))::kernel::matrix_elements
+             << ", R*v*~R multiplications: " << gaalet::multiplication_count<decltype(R*v)::melist>::value + gaalet::multiplication_count<decltype(R*v*~R)::melist>::value << std::endl;
+
+   em::mv<3,5,6>::type B = {1.0, -2.0, 0.5};
+   std::cout << "apply(R,B): " << apply(R,B) << ", <R*B*~R>_2: " << grade<2>(R*B*~R) << std::endl;
+
+   //evaluation into operand
+   em::mv<1,2,4>::type w = apply(R,v);
+   for(int i=0; i<4; ++i) {
+      w = apply(R,w);
+      std::cout << "i: " << i << ", w = apply(R,w): " << w << std::endl;
+   }
+
+   cm::mv<0x01>::type e1 = {1.0};
+   cm::mv<0x02>::type e2 = {1.0};
+   cm::mv<0x04>::type e3 = {1.0};
+   cm::mv<0x08>::type ep = {1.0};
+   cm::mv<0x10>::type em = {1.0};
+   cm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
+   cm::mv<0x08, 0x10>::type einf = em+ep;
+
+   cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D = {0.9, 0.1, -0.2, 0.3, -0.5, 0.4, 0.1, 0.05, -0.5, 0.2, 0.3, 0.01};
+   cm::mv<1, 2, 4, 8, 0x10>::type P = e1 + 2.0*e2 + 3.0*e3 + 7.0*einf + e0;
+
+   auto DPD = eval(apply(D,P));
+   std::cout << "apply(D,P): " << DPD << std::endl;
+   std::cout << "apply(D,P) - <D*P*~D>_1: " << DPD - grade<1>(D*P*~D) << std::endl;
+   std::cout << std::dec << "terms: " << decltype(apply(D,P))::kernel::terms << ", matrix elements: " << decltype(apply(D,P))::kernel::matrix_elements
+             << ", D*P*~D multiplications: " << gaalet::multiplication_count<decltype(D*P)::melist>::value + gaalet::multiplication_count<decltype(D*P*~D)::melist>::value << std::endl;
+   std::cout << "apply(D,e1^e2) - <D*(e1^e2)*~D>_2: " << apply(D,e1^e2) - grade<2>(D*(e1^e2)*~D) << std::endl;
+   std::cout << "apply(exp(-0.5*(e1^e2)),P): " << apply(exp(-0.5*(e1^e2)),P) << std::endl;
+
+   //element reads of the cached matrix: sandwich as operand of a product
+   std::cout << "apply(D,P)*P - <D*P*~D>_1*P: " << apply(D,P)*P - grade<1>(D*P*~D)*P << std::endl;
+
+   //non-versor v of even grades: V*~V not scalar, only the part of V*X*~V in the grades of X
+   cm::mv<0x00, 0x0f>::type V = {1.0, 0.5};
+   std::cout << "V*~V: " << V*~V << std::endl;
+   std::cout << "V*P*~V: " << V*P*~V << std::endl;
+   std::cout << "apply(V,P): " << apply(V,P) << ", apply(V,P) - <V*P*~V>_1: " << apply(V,P) - grade<1>(V*P*~V) << std::endl;
+   //violates static_assert: v of even and odd grades
+   //apply(1.0 + e1, P);
+
+   //degenerate metric
+   pm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f>::type M = {0.8, 0.6, 0.0, 0.0, 0.3, -0.2, 0.1, 0.05};
+   pm::mv<0x07, 0x0b, 0x0d, 0x0e>::type X = {1.0, 0.5, -1.5, 2.0};
+   std::cout << "apply(M,X): " << apply(M,X) << ", <M*X*~M>_3: " << grade<3>(M*X*~M) << std::endl;
+}
@@ -0,0 +1,40 @@
+#define GAALET_AUTO_MATERIALIZATION 1
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+int main()
+{
+   em::mv<1, 2, 4, 7>::type a = {1.0, 1.0, 0.0, 0.0};
+   em::mv<0, 3, 5, 6>::type b = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
+
+   //b*a is read more than once by the outer product: materialized automatically
+   std::cout << "is_cheap_expression<a>: " << gaalet::is_cheap_expression<decltype(a)>::value
+             << ", is_cheap_expression<b*a>: " << gaalet::is_cheap_expression<decltype(b*a)>::value
+             << ", is_cheap_expression<~b>: " << gaalet::is_cheap_expression<decltype(~b)>::value << std::endl;
+   std::cout << "b*a*(!b): " << b*a*(!b) << std::endl;
+   std::cout << "b*a*(~b): " << b*a*(~b) << std::endl;
+   std::cout << "materialize(b*a)*(~b): " << materialize(b*a)*(~b) << std::endl;
+   std::cout << "eval(b*a)*(~b): " << eval(b*a)*(~b) << std::endl;
+
+   for(int i=0; i<4; ++i) {
+      a = b*a*(!b);
+      std::cout << "i: " << i << ", a = b*a*(!b): " << a << std::endl;
+   }
+
+   cm::mv<0x01>::type e1 = {1.0};
+   cm::mv<0x02>::type e2 = {1.0};
+   cm::mv<0x04>::type e3 = {1.0};
+   cm::mv<0x08>::type ep = {1.0};
+   cm::mv<0x10>::type em = {1.0};
+   cm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
+   cm::mv<0x08, 0x10>::type einf = em+ep;
+
+   cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D = {1.0, 0.0, 0.0, -0.707107, -0.5, 0.0, 0.0, 0.0, -0.5, 0.0, 0.0, 0.0};
+   cm::mv<1, 2, 4, 8, 0x10>::type P = e1 + 2.0*e2 + 3.0*e3 + 7.0*einf + e0;
+
+   std::cout << "D*P*~D: " << grade<1>(D*P*~D) << std::endl;
+   std::cout << "~(D*D)*P*(D*D): " << grade<1>(~(D*D)*P*(D*D)) << std::endl;
+   std::cout << "~eval(D*D)*P*eval(D*D): " << grade<1>(~eval(D*D)*P*eval(D*D)) << std::endl;
+}
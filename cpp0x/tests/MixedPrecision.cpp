@@ -0,0 +1,88 @@
+#include "gaalet.h"
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+typedef gaalet::algebra<gaalet::signature<4,1>, gaalet::precision<float, double>> cmx;
+typedef gaalet::algebra<gaalet::signature<4,1>, float> cmf;
+typedef gaalet::algebra<gaalet::signature<4,1>, double> cmd;
+
+#define FULL 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, \
+             0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f
+
+//largest deviation of stored elements from reference rounded to float: products summed in double and rounded once give 0
+template<class A, class R>
+double deviation(const A& a, const R& reference)
+{
+   double d = 0.0;
+   for(unsigned int i = 0; i < A::size; ++i) {
+      d = std::max(d, std::fabs(double(a[i]) - double(float(reference[i]))));
+   }
+   return d;
+}
+
+int main()
+{
+   std::cout << "storage: " << sizeof(cmx::mv<FULL>::type) << " bytes (float: " << sizeof(cmf::mv<FULL>::type)
+             << "), element_t double: " << std::is_same<cmx::element_t, double>::value
+             << ", eval() of expressions in double: " << std::is_same<decltype(eval(cmx::mv<1>::type()*cmx::mv<2>::type()))::element_t, double>::value << std::endl;
+
+   //full multivectors with cancelling products, inputs representable in float
+   cmx::mv<FULL>::type a, b;
+   cmf::mv<FULL>::type a_f, b_f;
+   cmd::mv<FULL>::type a_d, b_d;
+   for(unsigned int i = 0; i < 32; ++i) {
+      a[i] = float(1000.0 + 0.37*i - ((i%3) ? 1.0 : 0.0)*1000.0);
+      b[i] = float(1.0 + 0.013*i*i);
+      a_f[i] = a[i];
+      b_f[i] = b[i];
+      a_d[i] = a[i];
+      b_d[i] = b[i];
+   }
+
+   //table-driven products of stored operands
+   cmd::mv<FULL>::type c_d = a_d*b_d;
+   cmx::mv<FULL>::type c = a*b;
+   cmf::mv<FULL>::type c_f = a_f*b_f;
+   std::cout << "a*b: deviation from double rounded once, mixed: " << deviation(c, c_d) << ", float: " << (deviation(c_f, c_d) > 0.0) << std::endl;
+
+   c_d = a_d&b_d;
+   c = a&b;
+   std::cout << "a&b: deviation mixed: " << deviation(c, c_d) << std::endl;
+   c_d = a_d^b_d;
+   c = a^b;
+   std::cout << "a^b: deviation mixed: " << deviation(c, c_d) << std::endl;
+
+   //element-wise products of compound operands: sums of operands computed in double
+   c_d = (a_d + b_d)*(a_d - b_d);
+   c = (a + b)*(a - b);
+   c_f = (a_f + b_f)*(a_f - b_f);
+   std::cout << "(a+b)*(a-b): deviation mixed: " << deviation(c, c_d) << ", float: " << (deviation(c_f, c_d) > 0.0) << std::endl;
+
+   //batch of multivectors stored in float
+   const std::size_t n = 100;
+   cmx::mv<0x00, 0x03, 0x05, 0x06>::array_type R(n);
+   cmx::mv<1, 2, 4>::array_type X(n), Y(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double phi = 0.01*i;
+      R.set(i, cmd::mv<0x00, 0x03>::type({std::cos(phi), std::sin(phi)}));
+      X.set(i, cmd::mv<1, 2, 4>::type({1.0 + i, 2.0, -0.5*i}));
+   }
+   Y = grade<1>(R*X*~R);
+   double d = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      cmd::mv<0x00, 0x03, 0x05, 0x06>::type R_d = R[i];
+      cmd::mv<1, 2, 4>::type X_d = X[i];
+      d = std::max(d, deviation(Y[i], cmd::mv<1, 2, 4>::type(grade<1>(R_d*X_d*~R_d))));
+   }
+   std::cout << "batch: blade bytes per element: " << sizeof(*X.blade(0)) << ", deviation of R*X*~R: " << d << std::endl;
+   std::cout << "Y[10]: " << Y[10] << std::endl;
+   //conformal constants of the element type of the algebra: float points stay float
+   typedef gaalet::cga::basis<float> cf;
+   cmf::mv<1, 2, 4>::type x_f = {1.0f, 2.0f, 3.0f};
+   auto P_f = eval(x_f + 0.5f*(x_f&x_f)*cf::einf + cf::e0);
+   auto P_d = eval(x_f + 0.5*(x_f&x_f)*gaalet::cga::einf + gaalet::cga::e0);
+   std::cout << "cga point: float basis: " << std::is_same<decltype(P_f)::element_t, float>::value
+             << ", default basis: " << std::is_same<decltype(P_d)::element_t, double>::value << ", P: " << P_f << std::endl;
+}
@@ -0,0 +1,80 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+   typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+   typedef cm::mv<1, 2, 4, 8, 0x10>::array_type P_array;
+   typedef cm::mv<0x00>::array_type S_array;
+
+   cm::mv<0x03>::type B = {0.3};
+   D_type D = exp(-0.5*B)*(gaalet::cga::one + 0.5*einf*(e1 + 2.0*e2 - e3));
+
+   //batch of points, elements scattered lane by lane
+   const std::size_t n = 300;
+   P_array X(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double x = 0.01*double(i);
+      X.set(i, x*e1 + (1.0-x)*e2 + e0 + 0.5*(x*x + (1.0-x)*(1.0-x))*einf);
+   }
+   std::cout << "X: " << X.length() << " points, X[7]: " << X[7] << std::endl;
+   std::cout << "aligned: " << (reinterpret_cast<std::uintptr_t>(X.blade(1)) % GAALET_ARRAY_ALIGNMENT == 0) << std::endl;
+
+   //one versor applied to the batch
+   P_array Y(n);
+   Y = grade<1>(D*X*~D);
+   P_array Z(n, gaalet::sw::apply(D, X));
+   double error = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      P_type x = X[i];
+      P_type y = grade<1>(D*x*~D);
+      for(gaalet::conf_t index = 0; index < P_type::size; ++index) {
+         error += fabs(Y[i][index] - y[index]) + fabs(Z[i][index] - y[index]);
+      }
+   }
+   std::cout << "Y[7]: " << Y[7] << ", batch error: " << error << std::endl;
+
+   //scalar results of batch and constant operands
+   S_array W(n);
+   W = Y&einf;
+   std::cout << "(Y&einf)[7]: " << W[7] << ", (Y[7]&einf): " << (Y[7]&einf) << std::endl;
+
+   //evaluation into an operand of the expression, across blocks of lanes
+   X = grade<1>(D*X*~D);
+   std::cout << "X[7]: " << X[7] << ", X[299]-Y[299]: " << (X[299] - Y[299]) << std::endl;
+
+   //views of sub-ranges
+   P_array::view_t V = Y.view(100, 10);
+   V = V + einf;
+   std::cout << "V: " << std::dec << V.length() << " points, V[0]-Z[100]: " << (V[0] - Z[100]) << ", Y[99]-Z[99]: " << (Y[99] - Z[99]) << std::endl;
+   Y.view(0, 2).fill(P_type({1.0, 2.0, 3.0}));
+   std::cout << "Y[1]: " << Y[1] << std::endl;
+
+   //expression with state, prepared once per lane
+   cm::mv<0x03>::array_type A(4);
+   for(std::size_t i = 0; i < A.length(); ++i) {
+      A.set(i, cm::mv<0x03>::type({-0.25*M_PI*double(i)}));
+   }
+   cm::mv<0x00, 0x03>::array_type R(4);
+   R = exp(A);
+   for(std::size_t i = 0; i < R.length(); ++i) {
+      std::cout << "R[" << i << "]: " << R[i] << ", exp(A[i]): " << exp(A[i]) << std::endl;
+   }
+
+   //several views of one array in one expression, each read at the bound lane
+   S_array N(n-1);
+   N = X.view(1, n-1)&X.view(0, n-1);
+   std::cout << "N[7]: " << N[7] << ", X[8]&X[7]: " << (X[8]&X[7]) << std::endl;
+
+   //copy
+   P_array C(Y);
+   std::cout << "C[150]-Y[150]: " << (C[150] - Y[150]) << std::endl;
+}
@@ -0,0 +1,101 @@
+#include "gaalet.h"
+#include "parallel.h"
+
+#include <stdexcept>
+#include <vector>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef gaalet::algebra<gaalet::signature<4,1>, gaalet::precision<float, double>> cmx;
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+   typedef cm::mv<1, 2, 4, 8, 0x10>::array_type P_array;
+
+   cm::mv<0x03>::type B = {0.3};
+   D_type D = exp(-0.5*B)*(gaalet::cga::one + 0.5*einf*(e1 + 2.0*e2 - e3));
+
+   //pool with more participants than chunks of some ranges, independent of hardware
+   gaalet::thread_pool pool(4);
+   std::cout << "pool size: " << pool.size() << std::endl;
+
+   //every index evaluated exactly once
+   for(std::size_t n = 0; n < 2000; n += 333) {
+      std::vector<int> count(n, 0);
+      pool.parallel_for(n, 7, [&count](std::size_t begin, std::size_t end) {
+         for(std::size_t i = begin; i < end; ++i) ++count[i];
+      });
+      bool once = true;
+      for(std::size_t i = 0; i < n; ++i) once &= (count[i]==1);
+      std::cout << "n: " << n << ", each index once: " << once << std::endl;
+   }
+
+   //exception of a chunk rethrown on the calling thread, pool usable afterwards
+   try {
+      pool.parallel_for(1000, 7, [](std::size_t begin, std::size_t end) {
+         if(begin <= 500 && 500 < end) throw std::runtime_error("chunk of index 500");
+      });
+      std::cout << "no exception" << std::endl;
+   }
+   catch(const std::runtime_error& e) {
+      std::cout << "exception: " << e.what() << std::endl;
+   }
+   std::vector<int> count(1000, 0);
+   pool.parallel_for(1000, 7, [&count](std::size_t begin, std::size_t end) {
+      for(std::size_t i = begin; i < end; ++i) ++count[i];
+   });
+   std::cout << "after exception, index 999 evaluated: " << count[999] << std::endl;
+
+   //parallel evaluation equals serial evaluation
+   const std::size_t n = 100000;
+   P_array X(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double x = 1e-5*double(i);
+      X.set(i, x*e1 + (1.0-x)*e2 + e0 + 0.5*(x*x + (1.0-x)*(1.0-x))*einf);
+   }
+   P_array Y(n);
+   Y = gaalet::sw::apply(D, X);
+   P_array Z(n);
+   gaalet::parallel_assign(Z, gaalet::sw::apply(D, X), pool);
+
+   double difference = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      for(gaalet::conf_t index = 0; index < P_array::size; ++index) {
+         difference += fabs(Y.blade(index)[i] - Z.blade(index)[i]);
+      }
+   }
+   std::cout << "Z[12345]: " << Z[12345] << ", parallel-serial difference: " << difference << std::endl;
+
+   //in-place evaluation, default pool
+   gaalet::parallel_assign(X, gaalet::sw::apply(D, X));
+   difference = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      for(gaalet::conf_t index = 0; index < P_array::size; ++index) {
+         difference += fabs(X.blade(index)[i] - Y.blade(index)[i]);
+      }
+   }
+   std::cout << "in-place difference: " << difference << std::endl;
+
+   //precision policy: chunks sized by float storage, elements computed in double
+   typedef cmx::mv<1, 2, 4, 8, 0x10>::array_type Px_array;
+   Px_array Xx(n), Yx(n), Zx(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double x = 1e-5*double(i);
+      Xx.set(i, x*e1 + (1.0-x)*e2 + e0 + 0.5*(x*x + (1.0-x)*(1.0-x))*einf);
+   }
+   Yx = gaalet::sw::apply(D, Xx);
+   gaalet::parallel_assign(Zx, gaalet::sw::apply(D, Xx), pool);
+   difference = 0.0;
+   for(std::size_t i = 0; i < n; ++i) {
+      for(gaalet::conf_t index = 0; index < Px_array::size; ++index) {
+         difference += fabs(Yx.blade(index)[i] - Zx.blade(index)[i]);
+      }
+   }
+   std::cout << "precision policy, parallel-serial difference: " << difference << std::endl;
+}
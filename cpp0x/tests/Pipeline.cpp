@@ -0,0 +1,161 @@
+#include "gaalet.h"
+#include "pipeline.h"
+
+#include <cstdio>
+#include <stdexcept>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+typedef cm::mv<1, 2, 4>::type E_type;
+typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+
+//sink failing after some blocks
+struct failing_sink
+{
+   template<class X>
+   void operator()(const X&) {
+      if(++blocks == 3) throw std::runtime_error("sink failed");
+   }
+   unsigned int blocks;
+};
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   //motor: rotation about e3 followed by translation
+   cm::mv<0x03>::type B = {0.4};
+   D_type D = (gaalet::cga::one - 0.5*einf*(1.0*e1 - 2.0*e2 + 0.5*e3))*exp(-0.5*B);
+
+   //point cloud in plain file
+   const std::size_t n = 10007;
+   std::vector<double> cloud(3*n);
+   for(std::size_t i = 0; i < n; ++i) {
+      cloud[3*i] = std::sin(0.01*i);
+      cloud[3*i+1] = std::cos(0.013*i);
+      cloud[3*i+2] = 1e-3*i;
+   }
+   std::FILE* f = std::fopen("Pipeline_in.raw", "wb");
+   std::fwrite(cloud.data(), sizeof(double), cloud.size(), f);
+   std::fclose(f);
+
+   //reference: single evaluation of lift, sandwich and projection
+   std::vector<E_type> reference(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      E_type x = {cloud[3*i], cloud[3*i+1], cloud[3*i+2]};
+      auto p = eval(grade<1>(D*(x + 0.5*(x&x)*einf + e0)*~D));
+      reference[i] = part<1, 2, 4>(p)*(-1.0/eval(p&einf).element<0x00>());
+   }
+
+   //plain file to plain file, small blocks and few blocks in flight: back-pressure and partial last block
+   gaalet::point_pipeline<D_type> pipeline(D, 256, 3);
+   {
+      gaalet::raw_point_source<> source("Pipeline_in.raw");
+      gaalet::raw_point_sink<> sink("Pipeline_out.raw");
+      const std::size_t m = pipeline.run(source, sink);
+      sink.close();
+
+      std::vector<double> out(3*n + 3);
+      f = std::fopen("Pipeline_out.raw", "rb");
+      const std::size_t read = std::fread(out.data(), 3*sizeof(double), n + 1, f);
+      std::fclose(f);
+      double deviation = 0.0;
+      for(std::size_t i = 0; i < n; ++i) {
+         for(unsigned int k = 0; k < 3; ++k) {
+            deviation = std::max(deviation, std::fabs(out[3*i+k] - reference[i][k]));
+         }
+      }
+      std::cout << "raw: " << m << " points, " << read << " written, deviation < 1e-12: " << (deviation < 1e-12) << std::endl;
+   }
+
+   //plain file to binary dataset to binary dataset, pipeline reused
+   {
+      gaalet::raw_point_source<> source("Pipeline_in.raw");
+      gaalet::dataset_point_sink<E_type> sink("Pipeline_a.gmv", gaalet::dataset_soa, 1024);
+      pipeline.run(source, sink);
+      sink.close();
+   }
+   {
+      gaalet::dataset_point_source<E_type> source("Pipeline_a.gmv");
+      gaalet::dataset_point_sink<E_type> sink("Pipeline_b.gmv", gaalet::dataset_aos);
+      const std::size_t m = pipeline.run(source, sink);
+      sink.close();
+
+      //twice transformed
+      gaalet::dataset_reader<E_type> reader("Pipeline_b.gmv");
+      double deviation = 0.0;
+      for(std::size_t i = 0; i < n; ++i) {
+         const E_type& x = reference[i];
+         auto p = eval(grade<1>(D*(x + 0.5*(x&x)*einf + e0)*~D));
+         E_type y = part<1, 2, 4>(p)*(-1.0/eval(p&einf).element<0x00>());
+         for(unsigned int k = 0; k < 3; ++k) {
+            deviation = std::max(deviation, std::fabs(reader.begin()[i][k] - y[k]));
+         }
+      }
+      std::cout << std::dec << "dataset: " << m << " points, " << reader.length() << " in dataset, deviation < 1e-12: " << (deviation < 1e-12) << std::endl;
+   }
+
+   //dataset sources: blade rows of soa blocks and of aos datasets, views across block boundaries
+   {
+      for(unsigned int l = 0; l < 2; ++l) {
+         const gaalet::dataset_layout layout = l ? gaalet::dataset_aos : gaalet::dataset_soa;
+         {
+            gaalet::dataset_writer<E_type> writer("Pipeline_c.gmv", layout, 1024);
+            writer.write(reference.data(), n);
+            writer.close();
+         }
+         gaalet::dataset_point_source<E_type> source("Pipeline_c.gmv");
+         cm::mv<1, 2, 4>::array_type X(700);
+         std::size_t m = 0, k;
+         bool equal = true;
+         while((k = source(X.view(0, X.length()))) > 0) {
+            for(std::size_t i = 0; i < k; ++i) {
+               for(gaalet::conf_t index = 0; index < 3; ++index) equal &= (X.blade(index)[i] == reference[m+i][index]);
+            }
+            m += k;
+         }
+         std::cout << (l ? "aos" : "soa") << " source: " << m << " points, equal: " << equal << std::endl;
+      }
+   }
+
+   //errors of stages end all stages and are rethrown
+   try {
+      gaalet::raw_point_source<> source("Pipeline_in.raw");
+      failing_sink sink = { 0 };
+      pipeline.run(source, sink);
+      std::cout << "error: not detected" << std::endl;
+   }
+   catch(const std::runtime_error& e) {
+      std::cout << "error: " << e.what() << std::endl;
+   }
+
+   //ring: capacity and end of stream
+   gaalet::spsc_ring<int> ring(5);
+   int pushed = 0;
+   while(ring.try_push(pushed)) ++pushed;
+   ring.close();
+   int v, sum = 0;
+   while(ring.pop(v)) sum += v;
+   std::cout << "ring: capacity " << ring.capacity() << ", pushed " << pushed << ", sum " << sum << std::endl;
+
+   //ring between threads: producer and consumer blocking on full and empty ring
+   gaalet::spsc_ring<int> small(2);
+   std::thread producer([&small]() {
+      for(int i = 0; i < 100000; ++i) small.push(i);
+      small.close();
+   });
+   long long total = 0;
+   while(small.pop(v)) total += v;
+   producer.join();
+   std::cout << "ring between threads: sum " << total << std::endl;
+
+   std::remove("Pipeline_in.raw");
+   std::remove("Pipeline_out.raw");
+   std::remove("Pipeline_a.gmv");
+   std::remove("Pipeline_b.gmv");
+   std::remove("Pipeline_c.gmv");
+}
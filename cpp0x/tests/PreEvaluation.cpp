@@ -0,0 +1,31 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+
+int main()
+{
+   em::mv<1, 2, 4>::type a = {1.0, 2.0, 3.0};
+   em::mv<3, 5, 6>::type b = {0.0, 0.0, 0.0};
+   em::mv<0, 3, 5, 6>::type s = {1.0, 0.0, 0.0, 0.0};
+
+   //expression objects are evaluated on a prepared private copy: scalar factors follow changes of the operands
+   auto R = exp(-0.5*b);
+   auto Ra = R*a*(~R);
+   auto Sa = s*a*(!s);
+   auto L = log(s);
+   for(int i=1; i<=4; ++i) {
+      b[0] = 0.25*M_PI*i;
+      s[0] = cos(0.125*M_PI*i); s[1] = sin(0.125*M_PI*i);
+      s = s*(1.0+i);
+      em::mv<1, 2, 4, 7>::type x = Ra;
+      em::mv<1, 2, 4, 7>::type y = Sa;
+      std::cout << "i: " << i << ", R: " << R << ", R*a*~R: " << x << ", s*a*!s: " << y << ", log(s): " << L << std::endl;
+   }
+
+   //same expression object evaluated twice, operands unchanged
+   em::mv<0, 3, 5, 6>::type R1 = R;
+   em::mv<0, 3, 5, 6>::type R2 = R;
+   std::cout << "R1: " << R1 << ", R2: " << R2 << std::endl;
+
+   std::cout << "sinh(b): " << sinh(b) << ", exp(-0.5*b)*exp(0.5*b): " << exp(-0.5*b)*exp(0.5*b) << std::endl;
+}
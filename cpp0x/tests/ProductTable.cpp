@@ -0,0 +1,78 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+template<typename T>
+void printTable()
+{
+   std::cout << "size: " << T::size << std::endl;
+   for(unsigned int i=0; i<T::size; ++i) {
+      std::cout << "\t" << std::hex << T::entries[i].result << std::dec << "[" << T::entries[i].result_index << "] += "
+                << (T::entries[i].sign<0 ? "-" : "+") << "l[" << T::entries[i].left_index << "]*r[" << T::entries[i].right_index << "]" << std::endl;
+   }
+}
+
+//maximum element difference between table-driven kernel and element-wise evaluation into multivector type M
+template<typename M, typename E>
+double maxDifference(const gaalet::expression<E>& e_)
+{
+   static_assert(gaalet::evaluation_kernel<E>::value, "maxDifference(): expression without table-driven kernel");
+   const E& e(e_);
+   std::array<typename M::element_t, M::size> m;
+   std::array<typename M::element_t, M::size> n;
+   M::template Evaluation<E>::eval(m, e);
+   M::template ElementEvaluation<E>::eval(n, e);
+   double diff = 0.0;
+   for(unsigned int i=0; i<M::size; ++i) {
+      diff = std::max(diff, std::fabs(m[i]-n[i]));
+   }
+   return diff;
+}
+
+int main()
+{
+   em::mv<1, 2, 4>::type a = {1.0, 2.0, 3.0};
+   em::mv<0, 3, 5, 6>::type R = {cos(-M_PI*0.25), sin(-M_PI*0.25), 0.0, 0.0};
+
+   std::cout << "a*a:" << std::endl;
+   printTable<decltype(a*a)::table>();
+   std::cout << "R*a:" << std::endl;
+   printTable<decltype(R*a)::table>();
+   std::cout << "a&a:" << std::endl;
+   printTable<decltype(a&a)::table>();
+   std::cout << "a^a:" << std::endl;
+   printTable<decltype(a^a)::table>();
+
+   auto Ra = eval(R*a);
+   std::cout << "R*a: " << Ra << ", R*a (element-wise): " << R*a << std::endl;
+   em::mv<1, 2, 4, 7>::type b = Ra*(~R);
+   std::cout << "Ra*~R: " << b << ", Ra*~R (element-wise): " << Ra*(~R) << std::endl;
+   em::mv<1, 2>::type c = Ra*(~R);
+   std::cout << "<Ra*~R>_{1,2}: " << c << std::endl;
+   em::mv<0, 1, 2, 4, 7>::type d = Ra*(~R);
+   std::cout << "Ra*~R to {0 1 2 4 7}: " << d << std::endl;
+
+   cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D = {0.9, 0.1, -0.2, 0.3, -0.5, 0.4, 0.1, 0.05, -0.5, 0.2, 0.3, 0.01};
+   cm::mv<1, 2, 4, 8, 0x10>::type P = {1.0, 2.0, 3.0, 6.5, 7.5};
+
+   //assignment evaluates by table-driven kernel
+   decltype(eval(D*D)) DD;
+   DD = D*D;
+   std::cout << "D*D: " << DD << ", max difference: " << maxDifference<decltype(DD)>(D*D) << std::endl;
+   decltype(eval(D*P)) DP;
+   DP = D*P;
+   std::cout << "D*P: " << DP << ", max difference: " << maxDifference<decltype(DP)>(D*P) << std::endl;
+   decltype(eval(DP*(~D))) DPD;
+   DPD = DP*(~D);
+   std::cout << "D*P*~D: " << DPD << ", max difference: " << maxDifference<decltype(DPD)>(DP*(~D)) << std::endl;
+   decltype(eval(D&P)) DiP;
+   DiP = D&P;
+   std::cout << "D&P: " << DiP << ", max difference: " << maxDifference<decltype(DiP)>(D&P) << std::endl;
+   decltype(eval(D^P)) DoP;
+   DoP = D^P;
+   std::cout << "D^P: " << DoP << ", max difference: " << maxDifference<decltype(DoP)>(D^P) << std::endl;
+   //destination configuration differing from product configuration
+   std::cout << "D*P to {1 2 4}: max difference: " << maxDifference<cm::mv<1, 2, 4>::type>(D*P)
+             << ", to {0 1 8 0x1f}: " << maxDifference<cm::mv<0, 1, 8, 0x1f>::type>(D*P) << std::endl;
+}
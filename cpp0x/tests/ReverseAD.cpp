@@ -0,0 +1,69 @@
+#include "gaalet.h"
+
+#include <algorithm>
+#include <cmath>
+
+typedef gaalet::ad::rvar<double> rd;
+typedef gaalet::ad::fvar<double, 4> f4;
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<3,0>, rd> rm;
+typedef gaalet::algebra<gaalet::signature<3,0>, f4> fm;
+
+int main()
+{
+   gaalet::ad::tape<double>& tape = gaalet::ad::active_tape<double>();
+
+   //scalar function: recorded operations, constants not recorded
+   rd x = gaalet::ad::variable(0.5);
+   rd y = sin(x)*exp(x) + sqrt(1.0 + x*x)/x;
+   gaalet::ad::backward(y);
+   std::cout << "y: " << y << ", dy/dx: " << gaalet::ad::adjoint(x) << ", analytic: "
+             << cos(0.5)*exp(0.5) + sin(0.5)*exp(0.5) + 0.5/std::sqrt(1.25)/0.5 - std::sqrt(1.25)/0.25
+             << ", tape entries: " << tape.size() << std::endl;
+   tape.clear();
+
+   //gradient of scalar objective of a rotor by its spinor elements: reverse against forward mode
+   em::mv<0,3,5,6>::type R = {std::cos(0.4), std::sin(0.4)*0.6, 0.0, std::sin(0.4)*0.8};
+   em::mv<1,2,4>::type t = {1.0, 2.0, 0.5};
+
+   auto R_r = gaalet::ad::independent(R);
+   rd U_r = eval(magnitude(grade<1>(R_r*t*~R_r) - log(R_r)*t));
+   gaalet::ad::backward(U_r);
+   auto grad_r = gaalet::ad::gradient(R_r);
+
+   auto R_f = gaalet::ad::variables<4>(R);
+   f4 U_f = eval(magnitude(grade<1>(R_f*t*~R_f) - log(R_f)*t));
+   double d = 0.0;
+   for(unsigned int i = 0; i < 4; ++i) {
+      d = std::max(d, std::fabs(grad_r[i] - U_f.tangent[i]));
+   }
+   std::cout << "U: " << U_r << ", gradient: " << grad_r << ", deviation from forward mode < 1e-12: " << (d < 1e-12) << std::endl;
+
+   //vector-Jacobian product of multivector result: one sweep for weighted sum of elements
+   auto v_r = eval(grade<1>(R_r*t*~R_r));
+   em::mv<1,2,4>::type w = {1.0, 0.0, 0.0};
+   gaalet::ad::backward(v_r, w);
+   auto v_f = eval(grade<1>(R_f*t*~R_f));
+   d = 0.0;
+   for(unsigned int i = 0; i < 4; ++i) {
+      d = std::max(d, std::fabs(gaalet::ad::gradient(R_r)[i] - v_f[0].tangent[i]));
+   }
+   std::cout << "first row of Jacobian: " << gaalet::ad::gradient(R_r) << ", deviation from forward mode < 1e-12: " << (d < 1e-12) << std::endl;
+
+   //tape reused by repeated recordings: memory allocated once
+   std::size_t entries = 0, memory = 0;
+   bool reused = true;
+   for(unsigned int i = 0; i < 10; ++i) {
+      tape.clear();
+      auto m = gaalet::ad::independent(em::mv<3,5,6>::type({0.1*i, 0.2, -0.3}));
+      auto R_m = exp(-0.5*m);
+      rd U = eval(magnitude(grade<1>(R_m*t*~R_m) - t));
+      gaalet::ad::backward(U);
+      if(i > 0) {
+         reused = reused && (tape.size() == entries) && (tape.memory() == memory);
+      }
+      entries = tape.size();
+      memory = tape.memory();
+   }
+   std::cout << "tape entries per recording: " << entries << ", memory reused: " << reused << std::endl;
+}
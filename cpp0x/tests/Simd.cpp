@@ -0,0 +1,50 @@
+#include "gaalet.h"
+
+typedef gaalet::simd<double, 4> d4;
+typedef gaalet::simd<float, 8> f8;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef gaalet::algebra<gaalet::signature<4,1>, d4> cm4;
+
+int main()
+{
+   using gaalet::cga::e1;
+   using gaalet::cga::e2;
+   using gaalet::cga::e3;
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+
+   //lanes and broadcast
+   constexpr d4 s = {1.0, 2.0, 3.0, 4.0};
+   constexpr d4 h(0.5);
+   static_assert(s[2]==3.0 && h[3]==0.5, "pack construction not folded");
+   f8 f(0.5f);
+   std::cout << "s: " << s << ", 2*s-1: " << 2*s-1 << ", sqrt(s): " << sqrt(s) << ", f/s[1]: " << f/s[1] << std::endl;
+
+   //four rotations of four points evaluated at once
+   d4 angle = {0.0, 0.25*M_PI, 0.5*M_PI, M_PI};
+   cm4::mv<0x00, 0x03>::type R = {cos(-0.5*angle), sin(-0.5*angle)};
+   cm4::mv<1, 2, 4, 8, 0x10>::type P = {d4({1.0, 2.0, 3.0, 4.0}), d4(1.0), d4(0.0), d4(0.0), d4(1.0)};
+   P = P + 0.5*(P&P)*einf;
+
+   cm4::mv<1, 2, 4, 8, 0x10>::type Q = grade<1>(R*P*~R);
+   std::cout << "R: " << R << std::endl;
+   std::cout << "Q: " << Q << std::endl;
+   std::cout << "Q&einf: " << (Q&einf) << ", Q&Q: " << (Q&Q) << ", dual(e1^e2^Q): " << dual(e1^e2^Q) << std::endl;
+
+   //lanes against scalar evaluation
+   double error = 0.0;
+   for(unsigned int i = 0; i < d4::lanes; ++i) {
+      cm::mv<0x00, 0x03>::type r = {R[0][i], R[1][i]};
+      cm::mv<1, 2, 4, 8, 0x10>::type p = {P[0][i], P[1][i], P[2][i], P[3][i], P[4][i]};
+      cm::mv<1, 2, 4, 8, 0x10>::type q = grade<1>(r*p*~r);
+      for(gaalet::conf_t index = 0; index < q.size; ++index) {
+         error += fabs(q[index] - Q[index][i]);
+      }
+   }
+   std::cout << "lane error: " << error << std::endl;
+
+   //sandwich and versor map with packs
+   cm4::mv<1, 2, 4, 8, 0x10>::type S = gaalet::sw::apply(R, P);
+   gaalet::versor_map<decltype(R)> R_map(R);
+   std::cout << "S-Q: " << S-Q << ", R_map(P)-Q: " << R_map(P)-Q << std::endl;
+}
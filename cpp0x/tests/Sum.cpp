@@ -0,0 +1,64 @@
+#include "gaalet.h"
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+//number of operands of sum node
+template<class... T>
+unsigned int operands(const gaalet::sum<T...>&)
+{
+   return sizeof...(T);
+}
+
+int main()
+{
+   em::mv<1, 2, 4>::type a = {1.0, 2.0, 3.0};
+   em::mv<1, 2, 4>::type b = {0.5, -0.25, 4.0};
+   em::mv<1, 2, 4>::type c = {-1.0, 1.0, 2.0};
+   em::mv<0, 3>::type s = {2.0, -1.0};
+
+   //chains flattened into one node
+   std::cout << "operands of c+a+b-a-b+a+b-a-b-c: " << operands(c + a + b - a - b + a + b - a - b - c) << std::endl;
+   std::cout << "operands of (a+b)-(c-s): " << operands((a + b) - (c - s)) << std::endl;
+   static_assert(std::is_same<decltype((a + b) - (c - s)),
+                              gaalet::sum<gaalet::positive<em::mv<1, 2, 4>::type>, gaalet::positive<em::mv<1, 2, 4>::type>,
+                                          gaalet::negative<em::mv<1, 2, 4>::type>, gaalet::positive<em::mv<0, 3>::type>>>::value,
+                 "subtraction of sum: signs of operands not flipped");
+
+   em::mv<1, 2, 4>::type d = c + a + b - a - b + a + b - a - b - c;
+   std::cout << "c+a+b-a-b+a+b-a-b-c: " << d << std::endl;
+   std::cout << "(a+b)-(c-s): " << eval((a + b) - (c - s)) << std::endl;
+   std::cout << "grade<0>(a*b)-a+s-b*s: " << eval(grade<0>(a*b) - a + s - b*s) << std::endl;
+
+   //sums of operands with disjoint elements: no additions of absent elements
+   typedef gaalet::counting<double> cd;
+   typedef gaalet::algebra<gaalet::signature<3,0>, cd> ecm;
+   ecm::mv<1, 2, 4>::type x = {1.0, 2.0, 3.0};
+   ecm::mv<0, 3>::type y = {1.0, 2.0};
+   ecm::mv<0, 1, 2, 3, 4>::type z;
+   {
+      gaalet::operation_scope scope;
+      z = x + y - x;
+      std::cout << "x+y-x: " << z << std::endl;
+      std::cout << "   counted: " << scope.counts() << std::endl;
+      std::cout << "   model:   " << gaalet::cost_of(x + y - x) << std::endl;
+   }
+
+   //constant operands of identical type cancel
+   using gaalet::cga::e0;
+   using gaalet::cga::einf;
+   cm::mv<1, 2, 4>::type p = {1.0, 2.0, 3.0};
+   std::cout << "operands of e0+p+einf-e0: " << operands(e0 + p + einf - e0) << ", of e0+p-einf: " << operands(e0 + p - einf) << std::endl;
+   std::cout << "e0+p+einf-e0: " << eval(e0 + p + einf - e0) << std::endl;
+
+   //element type and metric combined over all operands
+   em::mv<1, 2, 4>::type f = {1.0, 1.0, 1.0};
+   gaalet::algebra<gaalet::signature<3,0>, float>::mv<1, 2, 4>::type g = {1.0f, 2.0f, 3.0f};
+   static_assert(std::is_same<decltype(g + g - g)::element_t, float>::value, "float sum not float");
+   static_assert(std::is_same<decltype(g + f - g)::element_t, double>::value, "mixed sum not double");
+   std::cout << "g+f-g: " << eval(g + f - g) << std::endl;
+
+   //in-place assignment of sum reading destination
+   a += b - c + a;
+   std::cout << "a += b-c+a: " << a << std::endl;
+}
@@ -34,4 +34,29 @@ int main()
    sem::mv<3,5,6>::type m = {"m12", "m13", "m23"};
    auto mag_m = magnitude(m);
    //std::cout << "m: " << m << ", mag_m: " << mag_m << std::endl;
+
+   //local simplification and constant folding
+   gaalet::symbex z = 0.0;
+   std::cout << "a*0: " << a*z << ", a*1: " << a*1.0 << ", a+0: " << a+z << ", -(-a): " << -(-a) << ", 2*3+a: " << gaalet::symbex(2.0)*3.0+a << ", sqrt(4)*a-a: " << sqrt(gaalet::symbex(4.0))*a-a << std::endl;
+
+   //shared subterms: equal expressions are the same node
+   std::cout << "a*b is b*a: " << ((a*b).node()==(b*a).node()) << ", c is a+b: " << (c.node()==(a+b).node()) << std::endl;
+
+   //full product of conformal multivectors, 32 symbols each
+   typedef gaalet::algebra< gaalet::signature<4,1>, gaalet::symbex> scm;
+   typedef scm::mv<0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+                   0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f>::type full_t;
+   full_t A, B;
+   for(int i = 0; i < 32; ++i) {
+      std::stringstream an, bn;
+      an << "a" << i;
+      bn << "b" << i;
+      A[i] = an.str();
+      B[i] = bn.str();
+   }
+   const std::size_t nodes = gaalet::symbex_pool().size();
+   full_t AB = A*B;
+   const std::size_t product_nodes = gaalet::symbex_pool().size() - nodes;
+   AB = A*B;
+   std::cout << std::dec << "A*B: " << product_nodes << " nodes, again: " << gaalet::symbex_pool().size() - nodes - product_nodes << " nodes, scalar element: " << AB[0] << std::endl;
 }
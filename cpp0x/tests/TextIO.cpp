@@ -0,0 +1,85 @@
+#include "gaalet.h"
+#include "text_io.h"
+
+#include <sstream>
+
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+typedef gaalet::algebra<gaalet::signature<4,1>, float> cmf;
+
+typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+typedef cm::mv<1, 2, 4, 8, 0x10>::array_type P_array;
+
+//largest deviation of elements of batches
+template<class A, class B>
+double deviation(const A& a, const B& b)
+{
+   double d = (a.length()==b.length()) ? 0.0 : 1.0/0.0;
+   for(std::size_t i = 0; i < a.length() && i < b.length(); ++i) {
+      for(unsigned int k = 0; k < A::size; ++k) {
+         d = std::max(d, std::fabs(double(a[i][k]) - double(b[i][k])));
+      }
+   }
+   return d;
+}
+
+int main()
+{
+   const std::size_t n = 1000;
+   P_array X(n);
+   for(std::size_t i = 0; i < n; ++i) {
+      const double x = std::sin(0.01*i), y = std::cos(0.03*i), z = 1e-3*i;
+      X.set(i, P_type({x, y, z, 0.5*(x*x+y*y+z*z) - 0.5, 0.5*(x*x+y*y+z*z) + 0.5}));
+   }
+   X.set(7, P_type({1e300, -2.5e-310, 0.0, -0.0, 123456789012345678.0}));
+
+   //default format: index header, shortest round trip, exact reading
+   std::ostringstream os;
+   gaalet::write_text(os, X);
+   const std::string text = os.str();
+   std::cout << "header and first line:" << std::endl << text.substr(0, text.find('\n', text.find('\n') + 1) + 1);
+   P_array Y;
+   std::size_t m = gaalet::parse_text(text.data(), text.data() + text.size(), Y);
+   std::cout << "round trip: " << m << " multivectors, deviation: " << deviation(X, Y) << ", Y[7]: " << Y[7] << std::endl;
+
+   //fixed digits, csv with basis header, read from stream
+   std::ostringstream csv;
+   gaalet::write_text(csv, X.view(0, 3), gaalet::text_format(',', gaalet::text_header_basis, 6));
+   std::cout << csv.str();
+   std::istringstream is(csv.str());
+   m = gaalet::read_text(is, Y);
+   std::cout << "fixed 6 digits: " << m << " multivectors, deviation <= 5e-7: " << (deviation(X.view(0, 3), Y) <= 5e-7) << std::endl;
+
+   //columns of common blade list: structurally zero columns written as 0 or skipped
+   typedef cm::mv<0, 1, 2, 3, 4, 8, 0x10>::type::clist columns_t;
+   std::ostringstream full, skipped;
+   gaalet::write_text<columns_t>(full, X.view(0, 2), gaalet::text_format(' ', gaalet::text_header_index, 3));
+   gaalet::write_text<columns_t>(skipped, X.view(0, 2), gaalet::text_format(' ', gaalet::text_header_index, 3, true));
+   std::cout << full.str() << skipped.str();
+
+   //header maps columns: order, missing blades and blades of other types
+   const char input[] = "\n# e1^e2 e2 1 e1\n1.5 2 0 -3e2\n\n  # comment\n0,0.25,0,1e-3\r\n";
+   cm::mv<1, 2, 3>::array_type B;
+   m = gaalet::parse_text(input, input + sizeof(input) - 1, B);
+   std::cout << "mapped: " << m << " multivectors, B[0]: " << B[0] << ", B[1]: " << B[1] << std::endl;
+
+   //float batches
+   cmf::mv<1, 2, 4, 8, 0x10>::array_type F(n, cmf::mv<1, 2, 4, 8, 0x10>::type({0.1f, 1e-30f, 3.4e38f, -7.0f, 0.333333343f})), G;
+   std::ostringstream fs;
+   gaalet::write_text(fs, F, gaalet::text_format(' ', gaalet::text_header_none));
+   const std::string ftext = fs.str();
+   gaalet::parse_text(ftext.data(), ftext.data() + ftext.size(), G);
+   std::cout << "float round trip: deviation: " << deviation(F, G) << ", G[0]: " << G[0] << std::endl;
+
+   //errors with line numbers
+   const char* bad[] = { "1 2 3\n4 5\n", "# 1 2 4 8\n1 2 3 4\n", "1 2 x\n", "# 1 2 q\n" };
+   for(const char* b : bad) {
+      try {
+         cm::mv<1, 2, 4>::array_type E;
+         gaalet::parse_text(b, b + std::strlen(b), E);
+         std::cout << "error: not detected" << std::endl;
+      }
+      catch(const gaalet::text_error& e) {
+         std::cout << "error: " << e.what() << std::endl;
+      }
+   }
+}
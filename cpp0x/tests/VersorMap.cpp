@@ -0,0 +1,59 @@
+#include "gaalet.h"
+#include <vector>
+
+typedef gaalet::algebra<gaalet::signature<3,0>> em;
+typedef gaalet::algebra<gaalet::signature<4,1>> cm;
+
+int main()
+{
+   em::mv<0, 3, 5, 6>::type R = {2.0*cos(-M_PI*0.125), 2.0*sin(-M_PI*0.125), 0.0, 0.0};
+   em::mv<1, 2, 4>::type a = {1.0, 2.0, 3.0};
+
+   gaalet::versor_map<decltype(R)> R_map(R);
+   std::cout << "R: " << R_map.versor() << ", ~R: " << R_map.reverse() << ", !R: " << R_map.inverse() << ", |R|: " << R_map.norm() << std::endl;
+   std::cout << "grade 1 matrix:";
+   for(unsigned int i=0; i<3; ++i) for(unsigned int j=0; j<3; ++j) std::cout << " " << R_map.matrix<1>()(i, j);
+   std::cout << std::endl;
+   std::cout << "R_map(a): " << R_map(a) << ", R*a*!R: " << grade<1>(R*a*!R) << std::endl;
+   em::mv<3, 5, 6>::type B = {1.0, -2.0, 0.5};
+   std::cout << "R_map(B): " << R_map(B) << ", R*B*!R: " << grade<2>(R*B*!R) << std::endl;
+   std::cout << "R_map(a)^R_map(a+B): " << (R_map(a)^R_map(a+B)) << std::endl;
+
+   cm::mv<0x00>::type one = {1.0};
+   cm::mv<0x01>::type e1 = {1.0};
+   cm::mv<0x02>::type e2 = {1.0};
+   cm::mv<0x04>::type e3 = {1.0};
+   cm::mv<0x08>::type ep = {1.0};
+   cm::mv<0x10>::type em = {1.0};
+   cm::mv<0x08, 0x10>::type e0 = 0.5*(em-ep);
+   cm::mv<0x08, 0x10>::type einf = em+ep;
+
+   typedef cm::mv<0x00, 0x03, 0x05, 0x06, 0x09, 0x0a, 0x0c, 0x0f, 0x11, 0x12, 0x14, 0x17>::type D_type;
+   typedef cm::mv<1, 2, 4, 8, 0x10>::type P_type;
+   typedef cm::mv<0x07, 0x0b, 0x0d, 0x0e, 0x13, 0x15, 0x16, 0x19, 0x1a, 0x1c>::type L_type;
+
+   D_type D = exp(-0.5*0.3*(e1^e2))*(one + 0.5*einf*(e1 + 2.0*e2 - e3));
+   P_type P = e1 + 2.0*e2 + 3.0*e3 + 7.0*einf + e0;
+   L_type L = ((e1 + e0)^(e2 + einf))^einf;
+
+   gaalet::versor_map<D_type, P_type, L_type> D_map(D);
+   std::cout << "D_map grades: " << std::hex << D_map.grades << std::dec << ", |D|: " << D_map.norm() << std::endl;
+   std::cout << "D_map(P): " << D_map(P) << std::endl;
+   std::cout << "D*P*!D: " << grade<1>(D*P*!D) << std::endl;
+   std::cout << "D_map(P) - sandwich(D,P): " << D_map(P) - gaalet::sw::apply(D,P) << std::endl;
+   std::cout << "D_map(L) - <D*L*!D>_3: " << D_map(L) - grade<3>(D*L*!D) << std::endl;
+   std::cout << "D_map(P)&D_map(P): " << (D_map(P)&D_map(P)) << ", P&P: " << (P&P) << std::endl;
+
+   std::vector<P_type> points(4);
+   for(unsigned int i=0; i<points.size(); ++i) {
+      points[i] = e1*double(i) + e2 + e0 + 0.5*(double(i*i) + 1.0)*einf;
+   }
+   std::vector<P_type> moved(points.size());
+   D_map.apply(points.begin(), points.end(), moved.begin());
+   for(unsigned int i=0; i<moved.size(); ++i) {
+      std::cout << "moved[" << i << "]: " << moved[i] << std::endl;
+   }
+
+   D_map.assign(D*D);
+   std::cout << "D*D map, D_map(P) - sandwich(D*D,P): " << D_map(P) - gaalet::sw::apply(D*D,P) << std::endl;
+}
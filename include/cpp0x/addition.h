@@ -4,68 +4,488 @@
 namespace gaalet
 {
 
-template<class L, class R>
-struct addition : public expression<addition<L, R>>
+//signed operand A of a sum node
+template<class A>
+struct positive
+{
+   typedef A type;
+};
+template<class A>
+struct negative
 {
-   typedef typename merge_lists<typename L::clist, typename R::clist>::clist clist;
+   typedef A type;
+};
 
-   typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
+template<class T>
+struct negated;
+template<class A>
+struct negated<positive<A>>
+{
+   typedef negative<A> type;
+};
+template<class A>
+struct negated<negative<A>>
+{
+   typedef positive<A> type;
+};
+
+//element conf in configuration list of expression A
+template<class A, conf_t conf>
+struct has_element
+{
+   static const bool value = (search_element<conf, typename A::clist>::index < A::clist::size);
+};
+
+//element conf of signed operand T of sum operands o, accumulated from left to right: operands without element conf are skipped
+template<class T, conf_t conf, bool present = has_element<typename T::type, conf>::value>
+struct sum_element
+{
+   template<typename element_t, class O>
+   static constexpr element_t first(const O& o) {
+      return o.tail.template element<conf, element_t>();
+   }
+   template<typename element_t, class O>
+   static constexpr element_t next(const element_t& s, const O& o) {
+      return o.tail.template accumulate<conf>(s);
+   }
+};
+template<class A, conf_t conf>
+struct sum_element<positive<A>, conf, true>
+{
+   template<typename element_t, class O>
+   static constexpr element_t first(const O& o) {
+      return o.tail.template accumulate<conf>(element_t(o.a.template element<conf>()));
+   }
+   template<typename element_t, class O>
+   static constexpr element_t next(const element_t& s, const O& o) {
+      return o.tail.template accumulate<conf>(element_t(s + o.a.template element<conf>()));
+   }
+};
+template<class A, conf_t conf>
+struct sum_element<negative<A>, conf, true>
+{
+   template<typename element_t, class O>
+   static constexpr element_t first(const O& o) {
+      return o.tail.template accumulate<conf>(element_t(-o.a.template element<conf>()));
+   }
+   template<typename element_t, class O>
+   static constexpr element_t next(const element_t& s, const O& o) {
+      return o.tail.template accumulate<conf>(element_t(s - o.a.template element<conf>()));
+   }
+};
 
-   typedef typename element_type_combination_traits<typename L::element_t, typename R::element_t>::element_t element_t;
+//signed operands of a sum node, stored as head and tail
+template<class... T>
+struct sum_operands;
 
-   addition(const L& l_ , const R& r_ )
-      :  l(l_), r(r_)
+template<>
+struct sum_operands<>
+{
+   constexpr sum_operands()
    { }
 
-   template<conf_t conf>
-   element_t element() const {
-      return l.template element<conf>() + r.template element<conf>();
+   template<conf_t conf, typename element_t>
+   constexpr element_t element() const {
+      return null_element<element_t>::value();
    }
 
-protected:
-   const L& l;
-   const R& r;
+   template<conf_t conf, typename element_t>
+   constexpr element_t accumulate(const element_t& s) const {
+      return s;
+   }
+
+   void init() { }
+
+   constexpr bool aliases(const void*) const {
+      return false;
+   }
+
+   void bind_lane(std::size_t) { }
+
+   constexpr sum_operands<> negate() const {
+      return sum_operands<>();
+   }
+
+   template<class U>
+   constexpr sum_operands<U> append(const typename U::type& u) const {
+      return sum_operands<U>(u, *this);
+   }
 };
 
-template<class L, class R>
-struct subtraction : public expression<subtraction<L, R>>
+template<class T, class... TT>
+struct sum_operands<T, TT...>
 {
-   typedef typename merge_lists<typename L::clist, typename R::clist>::clist clist;
+   typedef typename T::type A;
+   typedef sum_operands<TT...> tail_t;
 
-   typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
+   constexpr sum_operands(const A& a_, const tail_t& tail_)
+      :  a(a_), tail(tail_)
+   { }
 
-   typedef typename element_type_combination_traits<typename L::element_t, typename R::element_t>::element_t element_t;
+   //sum of elements conf of operands
+   template<conf_t conf, typename element_t>
+   constexpr element_t element() const {
+      return sum_element<T, conf>::template first<element_t>(*this);
+   }
 
-   subtraction(const L& l_ , const R& r_ )
-      :  l(l_), r(r_)
+   //sum s of elements conf of preceding operands, plus elements conf of operands
+   template<conf_t conf, typename element_t>
+   constexpr element_t accumulate(const element_t& s) const {
+      return sum_element<T, conf>::next(s, *this);
+   }
+
+   void init() {
+      a.init();
+      tail.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d) || tail.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+      tail.bind_lane(lane);
+   }
+
+   constexpr sum_operands<typename negated<T>::type, typename negated<TT>::type...> negate() const {
+      return sum_operands<typename negated<T>::type, typename negated<TT>::type...>(a, tail.negate());
+   }
+
+   template<class U>
+   constexpr sum_operands<T, TT..., U> append(const typename U::type& u) const {
+      return sum_operands<T, TT..., U>(a, tail.template append<U>(u));
+   }
+
+   typename expression_storage<A>::type a;
+   tail_t tail;
+};
+
+template<class O>
+struct negated_operands;
+template<class... T>
+struct negated_operands<sum_operands<T...>>
+{
+   typedef sum_operands<typename negated<T>::type...> type;
+};
+
+template<class T, class O>
+struct prepend_operand;
+template<class T, class... TT>
+struct prepend_operand<T, sum_operands<TT...>>
+{
+   typedef sum_operands<T, TT...> type;
+};
+
+template<class O, class U>
+struct contains_operand;
+template<class U>
+struct contains_operand<sum_operands<>, U>
+{
+   static const bool value = false;
+};
+template<class T, class... TT, class U>
+struct contains_operand<sum_operands<T, TT...>, U>
+{
+   static const bool value = std::is_same<T, U>::value || contains_operand<sum_operands<TT...>, U>::value;
+};
+
+//operands O without first operand U
+template<class O, class U>
+struct remove_operand;
+template<class U, class... TT>
+struct remove_operand<sum_operands<U, TT...>, U>
+{
+   typedef sum_operands<TT...> type;
+
+   static constexpr type apply(const sum_operands<U, TT...>& o) {
+      return o.tail;
+   }
+};
+template<class T, class... TT, class U>
+struct remove_operand<sum_operands<T, TT...>, U>
+{
+   typedef remove_operand<sum_operands<TT...>, U> tail_remove;
+   typedef typename prepend_operand<T, typename tail_remove::type>::type type;
+
+   static constexpr type apply(const sum_operands<T, TT...>& o) {
+      return type(o.a, tail_remove::apply(o.tail));
+   }
+};
+
+//operands O followed by operand U: operands with constant elements cancel an operand of identical type and opposite sign
+template<class O, class U, bool cancel = (has_constant_elements<typename U::type>::value && contains_operand<O, typename negated<U>::type>::value)>
+struct append_operand;
+template<class... T, class U>
+struct append_operand<sum_operands<T...>, U, false>
+{
+   typedef sum_operands<T..., U> type;
+
+   static constexpr type apply(const sum_operands<T...>& o, const typename U::type& u) {
+      return o.template append<U>(u);
+   }
+};
+template<class O, class U>
+struct append_operand<O, U, true>
+{
+   typedef remove_operand<O, typename negated<U>::type> remove;
+   typedef typename remove::type type;
+
+   static constexpr type apply(const O& o, const typename U::type&) {
+      return remove::apply(o);
+   }
+};
+
+//operands O followed by operands R
+template<class O, class R>
+struct append_operands;
+template<class O>
+struct append_operands<O, sum_operands<>>
+{
+   typedef O type;
+
+   static constexpr type apply(const O& o, const sum_operands<>&) {
+      return o;
+   }
+};
+template<class O, class U, class... UU>
+struct append_operands<O, sum_operands<U, UU...>>
+{
+   typedef append_operand<O, U> append;
+   typedef append_operands<typename append::type, sum_operands<UU...>> tail_append;
+   typedef typename tail_append::type type;
+
+   static constexpr type apply(const O& o, const sum_operands<U, UU...>& r) {
+      return tail_append::apply(append::apply(o, r.a), r.tail);
+   }
+};
+
+//configuration list, metric and element type of signed operands, combined once for all operands
+template<class... T>
+struct sum_traits;
+template<>
+struct sum_traits<>
+{
+   typedef cl_null clist;
+   typedef signature<0,0> metric;
+   typedef default_element_t element_t;
+};
+template<class T>
+struct sum_traits<T>
+{
+   typedef typename T::type::clist clist;
+   typedef typename T::type::metric metric;
+   typedef typename T::type::element_t element_t;
+};
+template<class T, class T2, class... TT>
+struct sum_traits<T, T2, TT...>
+{
+   typedef typename T::type A;
+   typedef sum_traits<T2, TT...> tail;
+
+   typedef typename merge_lists<typename A::clist, typename tail::clist>::clist clist;
+   typedef typename metric_combination_traits<typename A::metric, typename tail::metric>::metric metric;
+   typedef typename element_type_combination_traits<typename A::element_t, typename tail::element_t>::element_t element_t;
+};
+
+/// N-ary sum of signed operands positive<A> and negative<A>.
+/**
+ * Built by operator+ and operator- from chains of additions and subtractions: operands of sums are flattened into one node.
+ * Each element is the signed sum of the elements of the operands having it in their configuration list, from left to right.
+ */
+template<class... T>
+struct sum : public expression<sum<T...>>
+{
+   typedef typename sum_traits<T...>::clist clist;
+
+   typedef typename sum_traits<T...>::metric metric;
+
+   typedef typename sum_traits<T...>::element_t element_t;
+
+   typedef sum_operands<T...> operands_t;
+
+   constexpr sum(const operands_t& o_)
+      :  o(o_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
-      return l.template element<conf>() - r.template element<conf>();
+   constexpr element_t element() const {
+      return o.template element<conf, element_t>();
+   }
+
+   void init() {
+      o.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return o.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      o.bind_lane(lane);
+   }
+
+   constexpr const operands_t& operands() const {
+      return o;
    }
 
 protected:
-   const L& l;
-   const R& r;
+   operands_t o;
+};
+
+//signed operands of expression E: E itself, or the operands of a sum
+template<class E>
+struct sum_operands_of
+{
+   typedef sum_operands<positive<E>> type;
+
+   static constexpr type apply(const E& e) {
+      return type(e, sum_operands<>());
+   }
+};
+template<class... T>
+struct sum_operands_of<sum<T...>>
+{
+   typedef sum_operands<T...> type;
+
+   static constexpr type apply(const sum<T...>& e) {
+      return e.operands();
+   }
+};
+
+template<class O>
+struct sum_of_operands;
+template<class... T>
+struct sum_of_operands<sum_operands<T...>>
+{
+   typedef sum<T...> type;
+};
+
+//flattened sum l + r
+template<class L, class R>
+struct sum_addition
+{
+   typedef append_operands<typename sum_operands_of<L>::type, typename sum_operands_of<R>::type> append;
+   typedef typename sum_of_operands<typename append::type>::type type;
+
+   static constexpr type apply(const L& l, const R& r) {
+      return type(append::apply(sum_operands_of<L>::apply(l), sum_operands_of<R>::apply(r)));
+   }
+};
+
+//flattened sum l - r
+template<class L, class R>
+struct sum_subtraction
+{
+   typedef append_operands<typename sum_operands_of<L>::type, typename negated_operands<typename sum_operands_of<R>::type>::type> append;
+   typedef typename sum_of_operands<typename append::type>::type type;
+
+   static constexpr type apply(const L& l, const R& r) {
+      return type(append::apply(sum_operands_of<L>::apply(l), sum_operands_of<R>::apply(r).negate()));
+   }
+};
+
+//aliasing: element-wise in operands having the element
+template<class D, conf_t conf, class... T>
+struct sum_alias_source;
+template<class D, conf_t conf>
+struct sum_alias_source<D, conf>
+{
+   static const conf_t value = alias_none;
+};
+template<class D, conf_t conf, class T, class... TT>
+struct sum_alias_source<D, conf, T, TT...>
+{
+   static const conf_t value = alias_combine(has_element<typename T::type, conf>::value ? alias_source<typename T::type, D, conf>::value : alias_none,
+                                             sum_alias_source<D, conf, TT...>::value);
+};
+
+template<class... T, class D, conf_t conf>
+struct alias_source<sum<T...>, D, conf>
+{
+   static const conf_t value = sum_alias_source<D, conf, T...>::value;
+};
+
+//cost model: operands having the element, one addition per operand after the first
+template<class T, conf_t conf, bool present = has_element<typename T::type, conf>::value>
+struct sum_operand_cost
+{
+   typedef operations<> type;
+   static const unsigned long long terms = 0;
+};
+template<class T, conf_t conf>
+struct sum_operand_cost<T, conf, true>
+{
+   typedef typename element_cost<typename T::type, conf>::type type;
+   static const unsigned long long terms = 1;
+};
+
+template<conf_t conf, class... T>
+struct sum_operands_cost;
+template<conf_t conf>
+struct sum_operands_cost<conf>
+{
+   typedef operations<> type;
+   static const unsigned long long terms = 0;
+};
+template<conf_t conf, class T, class... TT>
+struct sum_operands_cost<conf, T, TT...>
+{
+   typedef sum_operands_cost<conf, TT...> tail;
+
+   typedef typename operations_sum<typename sum_operand_cost<T, conf>::type, typename tail::type>::type type;
+   static const unsigned long long terms = sum_operand_cost<T, conf>::terms + tail::terms;
+};
+
+template<class... T, conf_t conf>
+struct element_cost<sum<T...>, conf>
+{
+   typedef sum_operands_cost<conf, T...> operands_cost;
+
+   typedef typename operations_sum<typename operands_cost::type, operations<(operands_cost::terms>1) ? operands_cost::terms-1 : 0>>::type type;
 };
 
 } //end namespace gaalet
 
 /// \brief Addition of two multivectors.
+/**
+ * Chains of additions and subtractions are flattened into one sum node (see gaalet::sum).
+ */
 /// \ingroup ga_ops
-template <class L, class R> inline
-gaalet::addition<L, R>
+template <class L, class R> constexpr
+typename gaalet::sum_addition<L, R>::type
 operator+(const gaalet::expression<L>& l, const gaalet::expression<R>& r) {
-   return gaalet::addition<L, R>(l, r);
+   return gaalet::sum_addition<L, R>::apply(l, r);
 }
 
 /// \brief Subtraction of two multivectors.
 /// \ingroup ga_ops
-template <class L, class R> inline
-gaalet::subtraction<L, R>
+template <class L, class R> constexpr
+typename gaalet::sum_subtraction<L, R>::type
 operator-(const gaalet::expression<L>& l, const gaalet::expression<R>& r) {
-   return gaalet::subtraction<L, R>(l, r);
+   return gaalet::sum_subtraction<L, R>::apply(l, r);
+}
+
+/// \brief Addition of a multivector to a multivector in place.
+/**
+ * Evaluated as l = l + r: elements outside the configuration list of l are discarded, and elements are evaluated
+ * in place unless r reads elements of l already written (see multivector::Aliasing).
+ */
+/// \ingroup ga_ops
+template <class CL, class M, class T, class R> inline
+gaalet::multivector<CL, M, T>&
+operator+=(gaalet::multivector<CL, M, T>& l, const gaalet::expression<R>& r) {
+   l = l + r;
+   return l;
+}
+
+/// \brief Subtraction of a multivector from a multivector in place.
+/// \ingroup ga_ops
+template <class CL, class M, class T, class R> inline
+gaalet::multivector<CL, M, T>&
+operator-=(gaalet::multivector<CL, M, T>& l, const gaalet::expression<R>& r) {
+   l = l - r;
+   return l;
 }
 
 #endif
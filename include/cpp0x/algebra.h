@@ -2,6 +2,7 @@
 #define __GAALET_ALGEBRA_H
 
 #include "multivector.h"
+#include "multivector_array.h"
 #include "utility.h"
 
 namespace gaalet
@@ -45,7 +46,9 @@ struct algebra
 {
    typedef M metric;
 
-   typedef T element_t;
+   //element type T: plain type, or precision<storage, computation> policy
+   typedef typename element_precision<T>::element_t element_t;
+   typedef typename element_precision<T>::storage_t storage_t;
 
    //no cpp0x template aliases supported by gcc yet
    /*template<conf_t head, conf_t... tail>
@@ -56,16 +59,10 @@ struct algebra
 
    //multivector configuration elements unpacking
    template<conf_t... elements>
-   struct mv;
-   template<conf_t head, conf_t... tail>
-   struct mv<head, tail...>
-   {
-      typedef multivector<typename insert_element<head, typename mv<tail...>::type::clist>::clist, metric, element_t> type;
-   };
-   template<conf_t head>
-   struct mv<head>
+   struct mv
    {
-      typedef multivector<configuration_list<head, cl_null>, metric, element_t> type;
+      typedef multivector<typename elements_clist<elements...>::clist, metric, T> type;
+      typedef multivector_array<typename elements_clist<elements...>::clist, metric, T> array_type;
    };
 };
 
@@ -0,0 +1,389 @@
+#ifndef __GAALET_CODEGEN_H
+#define __GAALET_CODEGEN_H
+
+#include "symbex.h"
+
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <vector>
+#include <map>
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gaalet
+{
+
+/// Polynomial normal form of symbolic expressions: sum of monomials of atoms with constant coefficients.
+/**
+ * Atoms are symbols, functions and quotients by non-constant terms. Expansion cancels terms which local simplification of symbex keeps,
+ * e.g. (0.5+a)*(0.5+a)-(0.5-a)*(0.5-a) to 2*a. Expansions exceeding max_terms monomials are given up.
+ */
+class symbex_expansion
+{
+public:
+   explicit symbex_expansion(std::size_t max_terms_ = 4096)
+      :  max_terms(max_terms_)
+   { }
+
+   //expanded form of s if it takes fewer operations than s, s otherwise
+   symbex simplify(const symbex& s) {
+      std::shared_ptr<polynomial> p = expand(s.node());
+      if(!p) {
+         return s;
+      }
+      const symbex e = build(*p);
+      return (operations(e.node())<operations(s.node())) ? e : s;
+   }
+
+   //number of operation nodes of the term of n, shared subterms counted once
+   static std::size_t operations(const symbex_node* n) {
+      std::unordered_set<const symbex_node*> visited;
+      return operations(n, visited);
+   }
+   //number of operation nodes of terms, subterms shared by terms counted once
+   static std::size_t operations(const std::vector<symbex>& terms) {
+      std::unordered_set<const symbex_node*> visited;
+      std::size_t o = 0;
+      for(std::size_t i = 0; i<terms.size(); ++i) {
+         o += operations(terms[i].node(), visited);
+      }
+      return o;
+   }
+
+protected:
+   //atoms ordered by creation of nodes, deterministic order of terms
+   struct atoms_less {
+      bool operator()(const std::vector<const symbex_node*>& a, const std::vector<const symbex_node*>& b) const {
+         return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(),
+                                             [](const symbex_node* x, const symbex_node* y) { return x->id<y->id; });
+      }
+   };
+   typedef std::vector<const symbex_node*> monomial;
+   typedef std::map<monomial, double, atoms_less> polynomial;
+
+   static std::size_t operations(const symbex_node* n, std::unordered_set<const symbex_node*>& visited) {
+      if(n->op==symbex_constant || n->op==symbex_symbol || !visited.insert(n).second) {
+         return 0;
+      }
+      return 1 + operations(n->l, visited) + (n->r ? operations(n->r, visited) : 0);
+   }
+
+   static void add_term(polynomial& p, const monomial& m, double c) {
+      const double sum = (p[m] += c);
+      if(sum==0.0) {
+         p.erase(m);
+      }
+   }
+
+   //expanded polynomial of node, null if too large
+   std::shared_ptr<polynomial> expand(const symbex_node* n) {
+      auto memo = expansions.find(n);
+      if(memo!=expansions.end()) {
+         return memo->second;
+      }
+
+      std::shared_ptr<polynomial> p(new polynomial);
+      std::shared_ptr<polynomial> l, r;
+      switch(n->op) {
+         case symbex_constant:
+            add_term(*p, monomial(), n->value);
+            break;
+         case symbex_neg:
+            if((l = expand(n->l))) {
+               for(auto t = l->begin(); t!=l->end(); ++t) {
+                  (*p)[t->first] = -t->second;
+               }
+            }
+            break;
+         case symbex_add:
+         case symbex_sub:
+            if((l = expand(n->l)) && (r = expand(n->r))) {
+               *p = *l;
+               for(auto t = r->begin(); t!=r->end(); ++t) {
+                  add_term(*p, t->first, (n->op==symbex_add) ? t->second : -t->second);
+               }
+            }
+            break;
+         case symbex_mul:
+            if((l = expand(n->l)) && (r = expand(n->r)) && l->size()*r->size()<=max_terms) {
+               for(auto a = l->begin(); a!=l->end(); ++a) {
+                  for(auto b = r->begin(); b!=r->end(); ++b) {
+                     monomial m(a->first.size() + b->first.size());
+                     std::merge(a->first.begin(), a->first.end(), b->first.begin(), b->first.end(), m.begin(),
+                                [](const symbex_node* x, const symbex_node* y) { return x->id<y->id; });
+                     add_term(*p, m, a->second*b->second);
+                  }
+               }
+            }
+            else {
+               l.reset();
+            }
+            break;
+         default:
+            add_term(*p, monomial(1, n), 1.0);
+      }
+      if((n->op==symbex_neg || n->op==symbex_add || n->op==symbex_sub || n->op==symbex_mul) && (!l || (n->op!=symbex_neg && !r))) {
+         p.reset();
+      }
+
+      expansions[n] = p;
+      return p;
+   }
+
+   //sum of monomials: coefficient times product of atoms
+   static symbex build(const polynomial& p) {
+      symbex sum(0.0);
+      for(auto t = p.begin(); t!=p.end(); ++t) {
+         symbex product(1.0);
+         for(auto a = t->first.begin(); a!=t->first.end(); ++a) {
+            product = product*symbex(*a);
+         }
+         sum = sum + symbex(t->second)*product;
+      }
+      return sum;
+   }
+
+   std::size_t max_terms;
+   std::unordered_map<const symbex_node*, std::shared_ptr<polynomial>> expansions;
+};
+
+/// Generator of flat C++ kernels by symbolic evaluation of expressions with element type symbex.
+/**
+ * Inputs are multivectors and scalars of symbols, outputs are expressions of them.
+ * Elements of outputs are expanded to polynomials where it saves operations of the output (symbex_expansion).
+ * Terms shared by outputs are computed once into temporaries (common subexpressions found by the interning of symbex nodes),
+ * the emitted kernels are straight-line code without branches. For a generator named kernel with input multivector a, scalar s and output c:
+ * - scalar kernel on element arrays: void kernel(const double* a, double s, double* c)
+ * - batch kernel on structure-of-arrays data, one array per element: void kernel_batch(std::size_t n, const double* const* a, const double* s_array, double* const* c)
+ * Inputs are loaded before outputs are stored, thus outputs may alias inputs.
+ * Example:
+ *    gaalet::codegen gen("rotate");
+ *    auto R = gen.input<sm::mv<0,3,5,6>::type>("R");
+ *    auto x = gen.input<sm::mv<1,2,4>::type>("x");
+ *    gen.output("y", grade<1>(R*x*~R));
+ *    gen.write(std::cout);
+ */
+class codegen
+{
+public:
+   //expand: elements of outputs in polynomial normal form where the output takes fewer operations (symbex_expansion)
+   codegen(const std::string& name_, bool expand_ = true)
+      :  name(name_), expand(expand_)
+   { }
+
+   //input multivector of symbols name_0, name_1, ... by element index
+   template<class MV>
+   MV input(const std::string& arg) {
+      MV mv;
+      argument a = { arg, false, false, std::vector<symbex>(), std::vector<conf_t>() };
+      for(conf_t index = 0; index<MV::size; ++index) {
+         std::stringstream symbol;
+         symbol << arg << "_" << index;
+         mv[index] = symbex(symbex_pool().symbol(symbol.str()));
+         a.elements.push_back(mv[index]);
+      }
+      a.confs = confs<typename MV::clist>();
+      arguments.push_back(a);
+      return mv;
+   }
+
+   //input scalar of symbol name
+   symbex scalar_input(const std::string& arg) {
+      symbex s(symbex_pool().symbol(arg));
+      argument a = { arg, true, false, std::vector<symbex>(1, s), std::vector<conf_t>() };
+      arguments.push_back(a);
+      return s;
+   }
+
+   //output multivector of elements of configuration list of expression
+   template<class E>
+   void output(const std::string& arg, const expression<E>& e) {
+      const multivector<typename E::clist, typename E::metric, symbex> mv = e;
+      argument a = { arg, false, true, std::vector<symbex>(), confs<typename E::clist>() };
+      std::vector<symbex> expanded;
+      symbex_expansion expansion;
+      for(conf_t index = 0; index<E::clist::size; ++index) {
+         a.elements.push_back(mv[index]);
+         expanded.push_back(expand ? expansion.simplify(mv[index]) : mv[index]);
+      }
+      //expanded elements if fewer operations in total, terms shared by elements counted once
+      if(symbex_expansion::operations(expanded)<symbex_expansion::operations(a.elements)) {
+         a.elements.swap(expanded);
+      }
+      arguments.push_back(a);
+   }
+
+   //scalar and batch kernel
+   template<class E, class TR>
+   void write(std::basic_ostream<E, TR>& os) const {
+      std::vector<const symbex_node*> order;
+      std::vector<unsigned> uses;
+      schedule(order, uses);
+
+      const std::streamsize precision = os.precision(17);
+
+      os << "//kernel " << name << ", generated by gaalet::codegen:";
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         os << " " << arguments[a].name << (arguments[a].output ? " (output)" : "");
+         if(!arguments[a].scalar) {
+            os << std::hex << " {";
+            for(std::size_t i = 0; i<arguments[a].confs.size(); ++i) {
+               os << " " << arguments[a].confs[i];
+            }
+            os << " }" << std::dec;
+         }
+      }
+      os << std::endl;
+
+      //scalar kernel
+      os << "inline void " << name << "(";
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         os << (a ? ", " : "") << (arguments[a].output ? "double* " : (arguments[a].scalar ? "double " : "const double* ")) << arguments[a].name;
+      }
+      os << ")" << std::endl << "{" << std::endl;
+      write_body(os, order, uses, "   ", "");
+      os << "}" << std::endl << std::endl;
+
+      //batch kernel
+      os << "inline void " << name << "_batch(std::size_t n";
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         os << ", " << (arguments[a].output ? "double* const* " : (arguments[a].scalar ? "const double* " : "const double* const* "))
+            << arguments[a].name << (arguments[a].scalar ? "_array" : "");
+      }
+      os << ")" << std::endl << "{" << std::endl;
+      os << "   for(std::size_t i = 0; i < n; ++i) {" << std::endl;
+      write_body(os, order, uses, "      ", "[i]");
+      os << "   }" << std::endl << "}" << std::endl;
+
+      os.precision(precision);
+   }
+
+   //number of temporaries of the kernel: operations shared by outputs
+   std::size_t temporaries() const {
+      std::vector<const symbex_node*> order;
+      std::vector<unsigned> uses;
+      schedule(order, uses);
+      std::size_t t = 0;
+      for(std::size_t o = 0; o<order.size(); ++o) {
+         t += is_temporary(order[o], uses);
+      }
+      return t;
+   }
+
+protected:
+   struct argument
+   {
+      std::string name;
+      bool scalar;
+      bool output;
+      std::vector<symbex> elements;
+      std::vector<conf_t> confs;
+   };
+
+   template<typename CL>
+   static std::vector<conf_t> confs() {
+      return confs<CL>(typename make_index_list<CL::size>::type());
+   }
+   template<typename CL, conf_t... I>
+   static std::vector<conf_t> confs(index_list<I...>) {
+      return std::vector<conf_t>{ get_element<I, CL>::value... };
+   }
+
+   //operations of outputs in evaluation order, uses of nodes by id
+   void schedule(std::vector<const symbex_node*>& order, std::vector<unsigned>& uses) const {
+      uses.assign(symbex_pool().size(), 0);
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         if(arguments[a].output) {
+            for(std::size_t i = 0; i<arguments[a].elements.size(); ++i) {
+               visit(arguments[a].elements[i].node(), uses, order);
+            }
+         }
+      }
+   }
+
+   //depth-first traversal of operations, operands first
+   static void visit(const symbex_node* n, std::vector<unsigned>& uses, std::vector<const symbex_node*>& order) {
+      if(uses[n->id]++ > 0) {
+         return;
+      }
+      if(n->l) {
+         visit(n->l, uses, order);
+      }
+      if(n->r) {
+         visit(n->r, uses, order);
+      }
+      order.push_back(n);
+   }
+
+   //operations used more than once are computed into temporaries
+   static bool is_temporary(const symbex_node* n, const std::vector<unsigned>& uses) {
+      return n->op!=symbex_constant && n->op!=symbex_symbol && uses[n->id]>1;
+   }
+
+   template<class E, class TR>
+   void write_body(std::basic_ostream<E, TR>& os, const std::vector<const symbex_node*>& order, const std::vector<unsigned>& uses,
+                   const char* indent, const char* batch_index) const
+   {
+      symbex_names names(symbex_pool().size());
+
+      //loads of used input elements
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         if(arguments[a].output) {
+            continue;
+         }
+         for(std::size_t i = 0; i<arguments[a].elements.size(); ++i) {
+            const symbex_node* n = arguments[a].elements[i].node();
+            if(!uses[n->id] || !names[n->id].empty()) {
+               continue;
+            }
+            names[n->id] = *n->name;
+            if(arguments[a].scalar) {
+               if(*batch_index) {
+                  os << indent << "const double " << *n->name << " = " << arguments[a].name << "_array" << batch_index << ";" << std::endl;
+               }
+            }
+            else {
+               os << indent << "const double " << *n->name << " = " << arguments[a].name << "[" << i << "]" << batch_index << ";" << std::endl;
+            }
+         }
+      }
+
+      //temporaries
+      std::size_t t = 0;
+      for(std::size_t o = 0; o<order.size(); ++o) {
+         const symbex_node* n = order[o];
+         if(!is_temporary(n, uses)) {
+            continue;
+         }
+         std::stringstream temporary;
+         temporary << "t_" << t++;
+         os << indent << "const double " << temporary.str() << " = ";
+         write_symbex(os, n, names, true);
+         os << ";" << std::endl;
+         names[n->id] = temporary.str();
+      }
+
+      //stores
+      for(std::size_t a = 0; a<arguments.size(); ++a) {
+         if(!arguments[a].output) {
+            continue;
+         }
+         for(std::size_t i = 0; i<arguments[a].elements.size(); ++i) {
+            os << indent << arguments[a].name << "[" << i << "]" << batch_index << " = ";
+            write_symbex_operand(os, arguments[a].elements[i].node(), names, true, false);
+            os << ";" << std::endl;
+         }
+      }
+   }
+
+   std::string name;
+   bool expand;
+   std::vector<argument> arguments;
+};
+
+} //end namespace gaalet
+
+#endif
@@ -6,107 +6,266 @@ namespace gaalet
 
 typedef unsigned long long int conf_t;
 
+//bit arithmetic on configuration bitmaps (bit c set for element c), evaluated by the compiler without template instantiations
+constexpr conf_t bit_count(conf_t b) {
+   return b ? 1 + bit_count(b & (b-1)) : 0;
+}
+//index of lowest set bit, b!=0
+constexpr conf_t lowest_bit(conf_t b) {
+   return bit_count((b & (~b+1)) - 1);
+}
+//index of set bit number n
+constexpr conf_t select_bit(conf_t b, conf_t n) {
+   return n ? select_bit(b & (b-1), n-1) : lowest_bit(b);
+}
+//number of set bits below bit c
+constexpr conf_t bit_rank(conf_t b, conf_t c) {
+   return bit_count(b & ((conf_t(1)<<c)-1));
+}
+//bit c set, c<64
+constexpr bool bit_test(conf_t b, conf_t c) {
+   return (c<64) && ((b>>c) & 1);
+}
+
+//configuration list: ascending elements (basis blade bitmaps)
+// --- flat lists (ascending elements less than 64, i.e. algebras up to dimension 6) are represented by the bitmap of their elements
+//     only (configuration_bitmap<B>): head and tail are computed from the bitmap, thus a list is one specialization independent of
+//     its size, lookups are done by bit arithmetic on the bitmap
+// --- other lists (elements of 64 and above, or built out of order) are chains of nodes (configuration_node<H, T>)
+template<conf_t B>
+struct configuration_bitmap
+{
+   //head in cl_null defined for cleaner utility implementations (e.g. insert_element, search_element), may result in error prone implementation
+   static const conf_t head = B ? lowest_bit(B) : 0;
+
+   typedef configuration_bitmap<(B & (B-1))> tail;
+
+   static const conf_t size = bit_count(B);
+
+   static const bool flat = true;
+   static const conf_t bitmap = B;
+};
+
+typedef configuration_bitmap<0> cl_null;
+
 template<conf_t H, typename T>
-struct configuration_list
+struct configuration_node
 {
    static const conf_t head = H;
 
    typedef T tail;
 
    static const conf_t size = tail::size + 1;
+
+   static const bool flat = false;
+   static const conf_t bitmap = 0;
 };
 
-struct cl_null
+//list of head H and tail T: bitmap if flat, node otherwise
+template<conf_t H, typename T, bool flat = (H<64) && T::flat && (T::size==0 || H<T::head)>
+struct make_configuration_list
 {
-   //head in cl_null defined for cleaner utility implementations (e.g. insert_element, search_element), may result in error prone implementation
-   static const conf_t head = 0;
+   typedef configuration_bitmap<((conf_t(1)<<H) | T::bitmap)> clist;
+};
+template<conf_t H, typename T>
+struct make_configuration_list<H, T, false>
+{
+   typedef configuration_node<H, T> clist;
+};
+
+template<conf_t H, typename T>
+using configuration_list = typename make_configuration_list<H, T>::clist;
 
-   static const conf_t size = 0;
+//flat configuration list of bitmap
+template<conf_t B>
+struct bitmap_clist
+{
+   typedef configuration_bitmap<B> clist;
 };
 
-//get_element
-template<conf_t index, typename list>
+//get_element, search_element, insert_element and merge_lists: bit arithmetic on flat lists, recursion through nodes otherwise
+template<conf_t index, typename list, bool flat = list::flat>
 struct get_element
 {
    static_assert(index < list::size, "get_element<index, list>: index not less than list size");
 
+   static const conf_t value = select_bit(list::bitmap, index);
+};
+
+template<conf_t index, typename list>
+struct get_element<index, list, false>
+{
+   static_assert(index < list::size, "get_element<index, list>: index not less than list size");
+
    static const conf_t value = get_element<index - 1, typename list::tail>::value;
 };
 
 template<typename list>
-struct get_element<0, list>
+struct get_element<0, list, false>
 {
    static_assert(0 < list::size, "get_element<index, list>: index not less than list size");
 
    static const conf_t value = list::head;
 };
 
-//insert_element
 template<conf_t element, typename list, int op = (element==list::head) ? 0 : ((element<list::head) ? 1 : -1)>
+struct insert_list_element;
+
+//insert_element
+template<conf_t element, typename list, bool flat = (list::flat && element<64)>
 struct insert_element
+{
+   typedef typename bitmap_clist<(list::bitmap | (conf_t(1)<<element))>::clist clist;
+};
+
+template<conf_t element, typename list>
+struct insert_element<element, list, false>
+{
+   typedef typename insert_list_element<element, list>::clist clist;
+};
+
+//insert_element by recursion through list
+template<conf_t element, typename list, int op>
+struct insert_list_element
 {
    typedef configuration_list<list::head, typename insert_element<element, typename list::tail>::clist> clist;
 };
 
 template<conf_t element, int op>
-struct insert_element<element, cl_null, op>
+struct insert_list_element<element, cl_null, op>
 {
    typedef configuration_list<element, cl_null> clist;
 };
 template<conf_t element>
-struct insert_element<element, cl_null, 0>
+struct insert_list_element<element, cl_null, 0>
 {
    typedef configuration_list<element, cl_null> clist;
 };
 
 template<conf_t element, typename list>
-struct insert_element<element, list, 0>
+struct insert_list_element<element, list, 0>
 {
    typedef list clist;
 };
 
 template<conf_t element, typename list>
-struct insert_element<element, list, 1>
+struct insert_list_element<element, list, 1>
 {
    typedef configuration_list<element, list> clist;
 };
 
 
 //merge lists
-template<typename listlow, typename listhigh>
+template<typename listlow, typename listhigh, bool flat = (listlow::flat && listhigh::flat)>
 struct merge_lists {
+   typedef typename bitmap_clist<(listlow::bitmap | listhigh::bitmap)>::clist clist;
+};
+
+template<typename listlow, typename listhigh>
+struct merge_lists<listlow, listhigh, false> {
    typedef typename merge_lists<typename listlow::tail, typename insert_element<listlow::head, listhigh>::clist>::clist clist;
 };
 
 template<typename listhigh>
-struct merge_lists<cl_null, listhigh> {
+struct merge_lists<cl_null, listhigh, false> {
    typedef listhigh clist;
 };
 
-//search element
+//bitmap of unsorted elements, flat if all elements are less than 64
+template<conf_t... elements>
+struct elements_bitmap;
+template<>
+struct elements_bitmap<>
+{
+   static const bool flat = true;
+   static const conf_t value = 0;
+};
+template<conf_t element, conf_t... elements>
+struct elements_bitmap<element, elements...>
+{
+   static const bool flat = (element<64) && elements_bitmap<elements...>::flat;
+   static const conf_t value = flat ? ((conf_t(1)<<element) | elements_bitmap<elements...>::value) : 0;
+};
+
+//configuration list of unsorted elements
+template<bool flat, conf_t... elements>
+struct unsorted_clist
+{
+   typedef typename bitmap_clist<elements_bitmap<elements...>::value>::clist clist;
+};
+template<>
+struct unsorted_clist<false>
+{
+   typedef cl_null clist;
+};
+template<conf_t element, conf_t... elements>
+struct unsorted_clist<false, element, elements...>
+{
+   typedef typename insert_element<element, typename unsorted_clist<false, elements...>::clist>::clist clist;
+};
+
+template<conf_t... elements>
+struct elements_clist
+{
+   typedef typename unsorted_clist<elements_bitmap<elements...>::flat, elements...>::clist clist;
+};
+
 template<conf_t element, typename list, conf_t this_index = 0, bool fit = (element==list::head)>
+struct search_list_element;
+
+//search element
+template<conf_t element, typename list, bool flat = list::flat>
 struct search_element
 {
-   static const conf_t index = search_element<element, typename list::tail, this_index+1>::index;
+   static const conf_t index = bit_test(list::bitmap, element) ? bit_rank(list::bitmap, element) : list::size;
+};
+
+template<conf_t element, typename list>
+struct search_element<element, list, false>
+{
+   static const conf_t index = search_list_element<element, list>::index;
+};
+
+//search element by recursion through list
+template<conf_t element, typename list, conf_t this_index, bool fit>
+struct search_list_element
+{
+   static const conf_t index = search_list_element<element, typename list::tail, this_index+1>::index;
 };
 
 template<conf_t element, typename list, conf_t this_index>
-struct search_element<element, list, this_index, true>
+struct search_list_element<element, list, this_index, true>
 {
    static const conf_t index = this_index;
 };
 
 template<conf_t element, conf_t this_index, bool fit>
-struct search_element<element, cl_null, this_index, fit>
+struct search_list_element<element, cl_null, this_index, fit>
 {
    static const conf_t index = this_index;
 };
 template<conf_t element, conf_t this_index>
-struct search_element<element, cl_null, this_index, true>
+struct search_list_element<element, cl_null, this_index, true>
 {
    static const conf_t index = this_index;
 };
 
+//list of element indices 0, ..., size-1 of a configuration list, for pack expansion over elements
+template<conf_t... I>
+struct index_list
+{ };
+
+template<conf_t N, conf_t... I>
+struct make_index_list
+{
+   typedef typename make_index_list<N-1, N-1, I...>::type type;
+};
+template<conf_t... I>
+struct make_index_list<0, I...>
+{
+   typedef index_list<I...> type;
+};
+
 } //end namespace gaalet
 
 #endif
@@ -0,0 +1,276 @@
+#ifndef __GAALET_CONSTANT_H
+#define __GAALET_CONSTANT_H
+
+#include "algebra.h"
+#include "materialization.h"
+#include "geometric_product.h"
+#include "exponential.h"
+
+namespace gaalet
+{
+
+//rational coefficient N/D of element C of a constant multivector
+template<conf_t C, long N = 1, long D = 1>
+struct constant_element
+{
+   static const conf_t conf = C;
+   static const long num = N;
+   static const long den = D;
+};
+
+//configuration list of constant elements
+template<class... E>
+struct constant_clist;
+template<>
+struct constant_clist<>
+{
+   typedef cl_null clist;
+};
+template<class E, class... EE>
+struct constant_clist<E, EE...>
+{
+   typedef typename insert_element<E::conf, typename constant_clist<EE...>::clist>::clist clist;
+};
+
+//value of element conf, known at compile time
+template<conf_t conf, typename T, class... E>
+struct constant_value;
+template<conf_t conf, typename T>
+struct constant_value<conf, T>
+{
+   static constexpr T value() {
+      return null_element<T>::value();
+   }
+};
+template<conf_t conf, typename T, class E, class... EE>
+struct constant_value<conf, T, E, EE...>
+{
+   static constexpr T value() {
+      return (conf==E::conf) ? T(E::num)/T(E::den) : constant_value<conf, T, EE...>::value();
+   }
+};
+
+//multivector with elements carried in the type: no storage, element access folds to compile time constants
+template<class D, typename M, typename T, class... E>
+struct constant_expression : public expression<D>
+{
+   typedef typename constant_clist<E...>::clist clist;
+   static const conf_t size = clist::size;
+
+   typedef M metric;
+
+   typedef T element_t;
+
+   //return element by configuration (basis vector), configuration known at compile time
+   template<conf_t conf>
+   constexpr element_t element() const {
+      return constant_value<conf, element_t, E...>::value();
+   }
+
+   //return element by index, index known at compile time
+   template<conf_t index>
+   constexpr element_t get() const {
+      return constant_value<get_element<index, clist>::value, element_t, E...>::value();
+   }
+
+   //constant: nothing to prepare
+   void init() const { }
+
+   constexpr bool aliases(const void*) const {
+      return false;
+   }
+};
+
+/// Constant multivector, elements given as rational coefficients constant_element<conf, num, den>.
+template<typename M, typename T, class... E>
+struct constant : public constant_expression<constant<M, T, E...>, M, T, E...>
+{ };
+
+/// Unit basis blade of configuration C.
+/**
+ * The default metric signature<0,0> combines with any other metric.
+ */
+template<conf_t C, typename M = signature<0,0>, typename T = default_element_t>
+struct blade : public constant_expression<blade<C, M, T>, M, T, constant_element<C>>
+{ };
+
+template<typename M, typename T, class... E>
+struct is_cheap_expression<constant<M, T, E...>>
+{
+   static const bool value = true;
+};
+template<conf_t C, typename M, typename T>
+struct is_cheap_expression<blade<C, M, T>>
+{
+   static const bool value = true;
+};
+
+template<typename M, typename T, class... E>
+struct has_constant_elements<constant<M, T, E...>>
+{
+   static const bool value = true;
+};
+template<conf_t C, typename M, typename T>
+struct has_constant_elements<blade<C, M, T>>
+{
+   static const bool value = true;
+};
+
+template<typename M, typename T, class... E, class D, conf_t conf>
+struct alias_source<constant<M, T, E...>, D, conf>
+{
+   static const conf_t value = alias_none;
+};
+template<conf_t C, typename M, typename T, class D, conf_t conf>
+struct alias_source<blade<C, M, T>, D, conf>
+{
+   static const conf_t value = alias_none;
+};
+
+template<typename M, typename T, class... E>
+struct has_storage<constant<M, T, E...>>
+{
+   static const bool value = true;
+};
+template<conf_t C, typename M, typename T>
+struct has_storage<blade<C, M, T>>
+{
+   static const bool value = true;
+};
+
+//cost model: elements folded to compile time constants
+template<typename M, typename T, class... E, conf_t conf>
+struct element_cost<constant<M, T, E...>, conf>
+{
+   typedef operations<> type;
+};
+template<typename M, typename T, class... E>
+struct init_cost<constant<M, T, E...>>
+{
+   typedef operations<> type;
+};
+template<conf_t C, typename M, typename T, conf_t conf>
+struct element_cost<blade<C, M, T>, conf>
+{
+   typedef operations<> type;
+};
+template<conf_t C, typename M, typename T>
+struct init_cost<blade<C, M, T>>
+{
+   typedef operations<> type;
+};
+
+template<typename M, typename T, class... E> inline
+const constant<M, T, E...>& storage_of(const constant<M, T, E...>& c) {
+   return c;
+}
+template<conf_t C, typename M, typename T> inline
+const blade<C, M, T>& storage_of(const blade<C, M, T>& b) {
+   return b;
+}
+
+//square of constant multivector vanishes, evaluated at compile time
+template<class A, typename CL = typename geometric_product<A, A>::clist>
+struct constant_square_null
+{
+   static const bool value = (geometric_product<A, A>(A(), A()).template element<CL::head>()==null_element<typename A::element_t>::value())
+                             && constant_square_null<A, typename CL::tail>::value;
+};
+template<class A>
+struct constant_square_null<A, cl_null>
+{
+   static const bool value = true;
+};
+
+template<typename M, typename T, class... E>
+struct is_nilpotent<constant<M, T, E...>>
+{
+   static const bool value = constant_square_null<constant<M, T, E...>>::value;
+};
+template<conf_t C, typename M, typename T>
+struct is_nilpotent<blade<C, M, T>>
+{
+   static const bool value = constant_square_null<blade<C, M, T>>::value;
+};
+
+//constants of conformal geometric algebra
+namespace cga
+{
+
+typedef signature<4,1> metric;
+
+//constants of element type T, combined with multivectors of element type T without promotion
+template<typename T = default_element_t>
+struct basis
+{
+   typedef blade<0x00, metric, T> one_t;
+   typedef blade<0x01, metric, T> e1_t;
+   typedef blade<0x02, metric, T> e2_t;
+   typedef blade<0x04, metric, T> e3_t;
+   typedef blade<0x08, metric, T> ep_t;
+   typedef blade<0x10, metric, T> em_t;
+
+   //null basis: e0 = 0.5*(em-ep), einf = em+ep
+   typedef constant<metric, T, constant_element<0x08, -1, 2>, constant_element<0x10, 1, 2>> e0_t;
+   typedef constant<metric, T, constant_element<0x08>, constant_element<0x10>> einf_t;
+
+   //Minkowski plane, euclidean and conformal pseudoscalar
+   typedef blade<0x18, metric, T> E_t;
+   typedef blade<0x07, metric, T> Ie_t;
+   typedef blade<0x1f, metric, T> Ic_t;
+
+   static constexpr one_t one = one_t();
+   static constexpr e1_t e1 = e1_t();
+   static constexpr e2_t e2 = e2_t();
+   static constexpr e3_t e3 = e3_t();
+   static constexpr ep_t ep = ep_t();
+   static constexpr em_t em = em_t();
+   static constexpr e0_t e0 = e0_t();
+   static constexpr einf_t einf = einf_t();
+   static constexpr E_t E = E_t();
+   static constexpr Ie_t Ie = Ie_t();
+   static constexpr Ic_t Ic = Ic_t();
+};
+
+template<typename T> constexpr typename basis<T>::one_t basis<T>::one;
+template<typename T> constexpr typename basis<T>::e1_t basis<T>::e1;
+template<typename T> constexpr typename basis<T>::e2_t basis<T>::e2;
+template<typename T> constexpr typename basis<T>::e3_t basis<T>::e3;
+template<typename T> constexpr typename basis<T>::ep_t basis<T>::ep;
+template<typename T> constexpr typename basis<T>::em_t basis<T>::em;
+template<typename T> constexpr typename basis<T>::e0_t basis<T>::e0;
+template<typename T> constexpr typename basis<T>::einf_t basis<T>::einf;
+template<typename T> constexpr typename basis<T>::E_t basis<T>::E;
+template<typename T> constexpr typename basis<T>::Ie_t basis<T>::Ie;
+template<typename T> constexpr typename basis<T>::Ic_t basis<T>::Ic;
+
+//constants of default element type
+typedef basis<>::one_t one_t;
+typedef basis<>::e1_t e1_t;
+typedef basis<>::e2_t e2_t;
+typedef basis<>::e3_t e3_t;
+typedef basis<>::ep_t ep_t;
+typedef basis<>::em_t em_t;
+typedef basis<>::e0_t e0_t;
+typedef basis<>::einf_t einf_t;
+typedef basis<>::E_t E_t;
+typedef basis<>::Ie_t Ie_t;
+typedef basis<>::Ic_t Ic_t;
+
+const one_t one = one_t();
+const e1_t e1 = e1_t();
+const e2_t e2 = e2_t();
+const e3_t e3 = e3_t();
+const ep_t ep = ep_t();
+const em_t em = em_t();
+const e0_t e0 = e0_t();
+const einf_t einf = einf_t();
+const E_t E = E_t();
+const Ie_t Ie = Ie_t();
+const Ic_t Ic = Ic_t();
+
+} //end namespace cga
+
+} //end namespace gaalet
+
+#endif
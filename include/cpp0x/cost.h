@@ -0,0 +1,233 @@
+#ifndef __GAALET_COST_H
+#define __GAALET_COST_H
+
+#include "multivector.h"
+#include "multiplication_list.h"
+
+#include <ostream>
+#include <type_traits>
+
+namespace gaalet
+{
+
+//numbers of arithmetic operations, subtractions counted as additions (negations, sign flips, absolute values and comparisons not counted)
+struct operation_count
+{
+   unsigned long long add;
+   unsigned long long mul;
+   unsigned long long div;
+   unsigned long long sqrt;
+   unsigned long long trig;
+   unsigned long long exp;
+
+   unsigned long long flops() const {
+      return add + mul + div + sqrt + trig + exp;
+   }
+
+   operation_count& operator+=(const operation_count& c) {
+      add += c.add; mul += c.mul; div += c.div; sqrt += c.sqrt; trig += c.trig; exp += c.exp;
+      return *this;
+   }
+   operation_count& operator-=(const operation_count& c) {
+      add -= c.add; mul -= c.mul; div -= c.div; sqrt -= c.sqrt; trig -= c.trig; exp -= c.exp;
+      return *this;
+   }
+};
+
+inline
+operation_count operator+(operation_count l, const operation_count& r) {
+   return l += r;
+}
+inline
+operation_count operator-(operation_count l, const operation_count& r) {
+   return l -= r;
+}
+
+template<class E, class TR>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const operation_count& c)
+{
+   //decimal regardless of format flags left by multivector streaming
+   const typename std::basic_ostream<E, TR>::fmtflags flags = os.flags();
+   os << std::dec << "add: " << c.add << ", mul: " << c.mul << ", div: " << c.div << ", sqrt: " << c.sqrt
+      << ", trig: " << c.trig << ", exp: " << c.exp << ", flops: " << c.flops();
+   os.flags(flags);
+   return os;
+}
+
+//operation counts known at compile time
+template<unsigned long long Add = 0, unsigned long long Mul = 0, unsigned long long Div = 0,
+         unsigned long long Sqrt = 0, unsigned long long Trig = 0, unsigned long long Exp = 0>
+struct operations
+{
+   static const unsigned long long add = Add;
+   static const unsigned long long mul = Mul;
+   static const unsigned long long div = Div;
+   static const unsigned long long sqrt = Sqrt;
+   static const unsigned long long trig = Trig;
+   static const unsigned long long exp = Exp;
+
+   static const unsigned long long transcendental = Sqrt + Trig + Exp;
+   static const unsigned long long flops = Add + Mul + Div + Sqrt + Trig + Exp;
+
+   static operation_count count() {
+      const operation_count c = { Add, Mul, Div, Sqrt, Trig, Exp };
+      return c;
+   }
+};
+
+template<class... O>
+struct operations_sum;
+template<>
+struct operations_sum<>
+{
+   typedef operations<> type;
+};
+template<class O, class... OO>
+struct operations_sum<O, OO...>
+{
+   typedef typename operations_sum<OO...>::type T;
+   typedef operations<O::add + T::add, O::mul + T::mul, O::div + T::div, O::sqrt + T::sqrt, O::trig + T::trig, O::exp + T::exp> type;
+};
+
+template<class O, unsigned long long n>
+struct operations_times
+{
+   typedef operations<O::add*n, O::mul*n, O::div*n, O::sqrt*n, O::trig*n, O::exp*n> type;
+};
+
+//element cost model: operations of element<conf>() of expression E, excluding init() (worst case, operands read lazily are counted per read)
+// --- specialized by the expression nodes, next to their state traits
+template<class E, conf_t conf>
+struct element_cost
+{
+   static_assert(sizeof(E)==0, "element_cost: no cost model for this expression type");
+};
+
+//operations of init() of expression E, once per evaluation
+template<class E>
+struct init_cost
+{
+   static_assert(sizeof(E)==0, "init_cost: no cost model for this expression type");
+};
+//nodes with operand types as only template parameters: initialization of operands
+template<template<class...> class N, class... A>
+struct init_cost<N<A...>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type...>::type type;
+};
+
+//multivectors: loads
+template<typename CL, typename M, typename T, conf_t conf>
+struct element_cost<multivector<CL, M, T>, conf>
+{
+   typedef operations<> type;
+};
+template<typename CL, typename M, typename T>
+struct init_cost<multivector<CL, M, T>>
+{
+   typedef operations<> type;
+};
+
+//expression type of operand storage
+template<class S>
+struct operand_type
+{
+   typedef typename std::remove_cv<typename std::remove_reference<S>::type>::type type;
+};
+
+//operations of all elements of configuration list CL of expression E, each read once
+template<class E, typename CL = typename E::clist, conf_t index = 0, bool end = (index==CL::size)>
+struct elements_cost
+{
+   typedef typename operations_sum<typename element_cost<E, get_element<index, CL>::value>::type,
+                                   typename elements_cost<E, CL, index+1>::type>::type type;
+};
+template<class E, typename CL, conf_t index>
+struct elements_cost<E, CL, index, true>
+{
+   typedef operations<> type;
+};
+
+//sum list of a product element: multiplication_sum_list, or the head of a multiplication_element_list entry (operands not flat)
+template<class list>
+struct product_terms
+{
+   template<class T> static typename T::head test(int);
+   template<class T> static T test(...);
+
+   typedef decltype(test<list>(0)) type;
+};
+
+//terms of a multiplication sum list (layout shared by gp, ip and op): operand elements, one multiplication per term (signs folded), sum of terms
+template<class list, class L, class R, bool end = (list::size==0)>
+struct sum_list_cost
+{
+   typedef typename operations_sum<typename element_cost<L, list::left>::type,
+                                   typename element_cost<R, list::right>::type,
+                                   operations<(list::size>1) ? 1 : 0, 1>,
+                                   typename sum_list_cost<typename list::tail, L, R>::type>::type type;
+};
+template<class list, class L, class R>
+struct sum_list_cost<list, L, R, true>
+{
+   typedef operations<> type;
+};
+
+//terms of a flat sum list, expanded from its bitmap
+template<class list, class L, class R, class I = typename list::terms>
+struct flat_sum_list_cost;
+template<class list, class L, class R, conf_t... I>
+struct flat_sum_list_cost<list, L, R, index_list<I...>>
+{
+   typedef typename operations_sum<typename element_cost<L, (select_bit(list::bitmap, I)^list::conf)>::type...,
+                                   typename element_cost<R, select_bit(list::bitmap, I)>::type...,
+                                   operations<list::size-1, list::size>>::type type;
+};
+template<class P, conf_t C, conf_t RB, class L, class R>
+struct sum_list_cost<flat_sum_list<P, C, RB>, L, R, false> : public flat_sum_list_cost<flat_sum_list<P, C, RB>, L, R>
+{ };
+
+//element of product expression E (gp, ip, op) with product policy, melist and operand storage types
+template<class E, conf_t conf>
+struct product_element_cost
+{
+   typedef typename operand_type<typename E::l_storage_t>::type L;
+   typedef typename operand_type<typename E::r_storage_t>::type R;
+   typedef typename product_sum_list<typename E::product_policy, conf, typename L::clist, typename R::clist, typename E::melist>::list list;
+
+   typedef typename sum_list_cost<typename product_terms<list>::type, L, R>::type type;
+};
+
+//initialization of operand storage of product expression E
+template<class E>
+struct product_init_cost
+{
+   typedef typename operations_sum<typename init_cost<typename operand_type<typename E::l_storage_t>::type>::type,
+                                   typename init_cost<typename operand_type<typename E::r_storage_t>::type>::type>::type type;
+};
+
+/// Static cost model of an expression type: operations of one full evaluation.
+/**
+ * Counts the operations of init() and of one read of every element of the configuration list, as done by assignment to a multivector.
+ * Operands of lazy nodes are counted per read, thus repeated evaluation of shared sub-expressions is included.
+ * Worst case of the element type double: multiplications by signs (integers plus or minus one) are folded, multiplications by constant elements are counted,
+ * elements of sums absent in an operand are skipped (not counted), branches of init() count the more expensive path.
+ * Evaluation kernels (table-driven products, sandwich kernels) perform about the same operations.
+ * Example: static_assert(gaalet::expression_cost<decltype(a*b)>::mul <= 16, "budget exceeded");
+ */
+template<class E>
+struct expression_cost : public operations_sum<typename init_cost<E>::type, typename elements_cost<E>::type>::type
+{
+   typedef typename init_cost<E>::type init;
+   typedef typename elements_cost<E>::type elements;
+};
+
+//cost model of expression as runtime operation counts, e.g. for printing a table
+template<class E> inline
+operation_count cost_of(const expression<E>&) {
+   return expression_cost<E>::count();
+}
+
+} //end namespace gaalet
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef __GAALET_COUNTING_H
+#define __GAALET_COUNTING_H
+
+#include "multivector_element.h"
+#include "cost.h"
+
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+namespace gaalet
+{
+
+//operations of counting elements performed by the calling thread since its start
+inline
+operation_count& operation_counters() {
+   static thread_local operation_count counters = { 0, 0, 0, 0, 0, 0 };
+   return counters;
+}
+
+/// Operations of counting elements performed by the calling thread during lifetime of scope.
+class operation_scope
+{
+public:
+   operation_scope()
+      :  start(operation_counters())
+   { }
+
+   operation_count counts() const {
+      return operation_counters() - start;
+   }
+
+   void reset() {
+      start = operation_counters();
+   }
+
+protected:
+   operation_count start;
+};
+
+/// Scope writing its operation counts to a stream at its end.
+template<class E, class TR>
+class basic_operation_report : public operation_scope
+{
+public:
+   basic_operation_report(std::basic_ostream<E, TR>& os_, const char* name_)
+      :  os(os_), name(name_)
+   { }
+
+   ~basic_operation_report() {
+      os << name << ": " << counts() << std::endl;
+   }
+
+protected:
+   std::basic_ostream<E, TR>& os;
+   const char* name;
+};
+typedef basic_operation_report<char, std::char_traits<char>> operation_report;
+
+//instrumented element type and its counted operations (own namespace for argument-dependent lookup of math functions, which are expression names in gaalet)
+namespace instrumented
+{
+
+/// Instrumented element type: value of type T with every arithmetic operation tallied in operation_counters().
+/**
+ * Usable as element type of an algebra, e.g. algebra<signature<4,1>, counting<double>>, mixing with plain scalar factors.
+ * Scalar factors of the library (constants) are counted as operations on the element type, integer signs are not.
+ */
+template<typename T>
+struct counting
+{
+   typedef T value_type;
+
+   constexpr counting()
+      :  value(0)
+   { }
+
+   constexpr counting(const T& v)
+      :  value(v)
+   { }
+
+   counting& operator+=(const counting& c) {
+      return *this = *this + c;
+   }
+   counting& operator-=(const counting& c) {
+      return *this = *this - c;
+   }
+   counting& operator*=(const counting& c) {
+      return *this = *this * c;
+   }
+   counting& operator/=(const counting& c) {
+      return *this = *this / c;
+   }
+
+   T value;
+};
+
+//integer signs of the library (products, reverse) are folded by the compiler for plain element types, thus not counted
+template<typename S> inline
+bool is_sign(S s) {
+   return std::is_integral<S>::value && (s==S(1) || s==S(-1));
+}
+
+//arithmetic
+#define GAALET_COUNTING_OPERATOR(op, counter) \
+template<typename T> inline \
+counting<T> operator op(const counting<T>& l, const counting<T>& r) { \
+   ++operation_counters().counter; \
+   return counting<T>(l.value op r.value); \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, counting<T>>::type \
+operator op(const counting<T>& l, S r) { \
+   operation_counters().counter += !is_sign(r); \
+   return counting<T>(l.value op T(r)); \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, counting<T>>::type \
+operator op(S l, const counting<T>& r) { \
+   operation_counters().counter += !is_sign(l); \
+   return counting<T>(T(l) op r.value); \
+}
+GAALET_COUNTING_OPERATOR(+, add)
+GAALET_COUNTING_OPERATOR(-, add)
+GAALET_COUNTING_OPERATOR(*, mul)
+GAALET_COUNTING_OPERATOR(/, div)
+#undef GAALET_COUNTING_OPERATOR
+
+template<typename T> inline
+counting<T> operator-(const counting<T>& a) {
+   return counting<T>(-a.value);
+}
+
+//comparison
+#define GAALET_COUNTING_COMPARISON(op) \
+template<typename T> inline \
+bool operator op(const counting<T>& l, const counting<T>& r) { \
+   return l.value op r.value; \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(const counting<T>& l, S r) { \
+   return l.value op T(r); \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(S l, const counting<T>& r) { \
+   return T(l) op r.value; \
+}
+GAALET_COUNTING_COMPARISON(==)
+GAALET_COUNTING_COMPARISON(!=)
+GAALET_COUNTING_COMPARISON(<)
+GAALET_COUNTING_COMPARISON(<=)
+GAALET_COUNTING_COMPARISON(>)
+GAALET_COUNTING_COMPARISON(>=)
+#undef GAALET_COUNTING_COMPARISON
+
+//functions
+#define GAALET_COUNTING_FUNCTION(f, counter) \
+template<typename T> inline \
+counting<T> f(const counting<T>& a) { \
+   ++operation_counters().counter; \
+   return counting<T>(std::f(a.value)); \
+}
+GAALET_COUNTING_FUNCTION(sqrt, sqrt)
+GAALET_COUNTING_FUNCTION(sin, trig)
+GAALET_COUNTING_FUNCTION(cos, trig)
+GAALET_COUNTING_FUNCTION(tan, trig)
+GAALET_COUNTING_FUNCTION(asin, trig)
+GAALET_COUNTING_FUNCTION(acos, trig)
+GAALET_COUNTING_FUNCTION(atan, trig)
+GAALET_COUNTING_FUNCTION(sinh, trig)
+GAALET_COUNTING_FUNCTION(cosh, trig)
+GAALET_COUNTING_FUNCTION(exp, exp)
+GAALET_COUNTING_FUNCTION(log, exp)
+#undef GAALET_COUNTING_FUNCTION
+
+template<typename T> inline
+counting<T> atan2(const counting<T>& y, const counting<T>& x) {
+   ++operation_counters().trig;
+   return counting<T>(std::atan2(y.value, x.value));
+}
+
+template<typename T> inline
+counting<T> fabs(const counting<T>& a) {
+   return counting<T>(std::fabs(a.value));
+}
+
+template<class E, class TR, typename T>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const counting<T>& c)
+{
+   os << c.value;
+   return os;
+}
+
+}  //end namespace instrumented
+
+using instrumented::counting;
+
+//element type combination: counting elements dominate plain scalars
+template<typename T, typename E>
+struct element_type_combination_traits<counting<T>, E>
+{
+   typedef counting<T> element_t;
+};
+template<typename E, typename T>
+struct element_type_combination_traits<E, counting<T>>
+{
+   typedef counting<T> element_t;
+};
+template<typename T>
+struct element_type_combination_traits<counting<T>, counting<T>>
+{
+   typedef counting<T> element_t;
+};
+
+template<typename T>
+struct null_element<counting<T>> {
+   static constexpr counting<T> value() {
+      return counting<T>();
+   }
+};
+
+} //end namespace gaalet
+
+#endif
@@ -0,0 +1,457 @@
+#ifndef __GAALET_DATASET_H
+#define __GAALET_DATASET_H
+
+#include "algebra.h"
+#include "multivector_array.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+//binary multivector datasets (POSIX): header, blade list and payload aligned to GAALET_ARRAY_ALIGNMENT, native byte order
+//   aos payload: count multivectors of size elements each, readable in place as multivectors
+//   soa payload: blocks of block_lanes lanes, one array of block_lanes elements per blade, readable in place as multivector_array_view
+
+namespace gaalet
+{
+
+enum dataset_layout
+{
+   dataset_aos = 0,
+   dataset_soa = 1
+};
+
+//element type codes of datasets, stored element types (storage_t) supported only
+template<typename T>
+struct dataset_element;
+template<>
+struct dataset_element<float>
+{
+   static const std::uint32_t code = 1;
+};
+template<>
+struct dataset_element<double>
+{
+   static const std::uint32_t code = 2;
+};
+template<>
+struct dataset_element<std::int32_t>
+{
+   static const std::uint32_t code = 3;
+};
+template<>
+struct dataset_element<std::int64_t>
+{
+   static const std::uint32_t code = 4;
+};
+
+struct dataset_header
+{
+   char magic[8];                //"GAALETMV"
+   std::uint32_t version;
+   std::uint32_t byte_order;     //0x01020304 in byte order of writer
+   std::uint32_t layout;         //dataset_layout
+   std::uint32_t p, q, r;        //signature of algebra
+   std::uint32_t element_type;   //dataset_element<storage_t>::code
+   std::uint32_t element_size;
+   std::uint32_t size;           //elements per multivector, followed by blade list of size uint32_t
+   std::uint64_t count;          //multivectors
+   std::uint64_t block_lanes;    //lanes per block (soa), 0 (aos)
+   std::uint64_t payload;        //offset of payload in bytes
+};
+
+/// Error opening, validating or writing a dataset file.
+struct dataset_error : public std::runtime_error
+{
+   dataset_error(const std::string& path, const std::string& what)
+      :  std::runtime_error("gaalet dataset " + path + ": " + what)
+   { }
+};
+
+//header of multivector type MV, blade list appended
+template<typename CL, typename M, typename T>
+dataset_header make_dataset_header(dataset_layout layout, std::size_t block_lanes)
+{
+   typedef typename element_precision<T>::storage_t storage_t;
+
+   dataset_header h;
+   std::memset(&h, 0, sizeof(h));
+   std::memcpy(h.magic, "GAALETMV", 8);
+   h.version = 1;
+   h.byte_order = 0x01020304;
+   h.layout = layout;
+   h.p = M::p;
+   h.q = M::q;
+   h.r = M::r;
+   h.element_type = dataset_element<storage_t>::code;
+   h.element_size = sizeof(storage_t);
+   h.size = CL::size;
+   h.count = 0;
+   h.block_lanes = (layout==dataset_soa) ? block_lanes : 0;
+   const std::size_t end = sizeof(dataset_header) + CL::size*sizeof(std::uint32_t);
+   h.payload = (end + GAALET_ARRAY_ALIGNMENT - 1)/GAALET_ARRAY_ALIGNMENT*GAALET_ARRAY_ALIGNMENT;
+   return h;
+}
+
+//blade list of configuration list CL as stored in datasets
+template<typename CL, conf_t... I>
+std::array<std::uint32_t, CL::size> make_dataset_blade_list(index_list<I...>)
+{
+   return std::array<std::uint32_t, CL::size>{{ std::uint32_t(get_element<I, CL>::value)... }};
+}
+template<typename CL>
+std::array<std::uint32_t, CL::size> dataset_blade_list()
+{
+   return make_dataset_blade_list<CL>(typename make_index_list<CL::size>::type());
+}
+
+template<class MV>
+class dataset_reader;
+
+/// Memory-mapped dataset of multivectors of type multivector<CL, M, T>, e.g. dataset_reader<algebra::mv<...>::type>.
+/**
+ * Opening checks signature, element type and blade list against the requested type. Elements are read in place:
+ * aos datasets as array of multivectors (begin(), end()), soa datasets as blocks of batch operands (block()).
+ * Pages are mapped private: writes to the views modify the mapping only, never the file.
+ */
+template<typename CL, typename M, typename T>
+class dataset_reader<multivector<CL, M, T>>
+{
+public:
+   typedef multivector<CL, M, T> value_t;
+   typedef multivector_array_view<CL, M, T> view_t;
+   typedef typename value_t::storage_t storage_t;
+
+   static_assert(sizeof(value_t)==CL::size*sizeof(storage_t), "dataset_reader: multivector storage not contiguous");
+
+   explicit dataset_reader(const std::string& path_)
+      :  path(path_), fd(-1), address(MAP_FAILED), bytes(0)
+   {
+      fd = ::open(path.c_str(), O_RDONLY);
+      if(fd < 0) throw dataset_error(path, "cannot open");
+      struct stat s;
+      if(::fstat(fd, &s) != 0 || std::size_t(s.st_size) < sizeof(dataset_header)) {
+         close();
+         throw dataset_error(path, "no dataset header");
+      }
+      bytes = s.st_size;
+      address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+      if(address == MAP_FAILED) {
+         close();
+         throw dataset_error(path, "cannot map");
+      }
+      try {
+         check();
+      }
+      catch(...) {
+         close();
+         throw;
+      }
+   }
+
+   ~dataset_reader() {
+      close();
+   }
+
+   dataset_reader(const dataset_reader&) = delete;
+   dataset_reader& operator=(const dataset_reader&) = delete;
+
+   dataset_layout layout() const {
+      return dataset_layout(header().layout);
+   }
+
+   //number of multivectors
+   std::size_t length() const {
+      return header().count;
+   }
+
+   //multivector i (gathered from blade arrays for soa)
+   value_t operator[](std::size_t i) const {
+      if(layout()==dataset_aos) {
+         return begin()[i];
+      }
+      const std::size_t lanes = header().block_lanes;
+      return block(i/lanes)[i%lanes];
+   }
+
+   //aos: multivectors in place
+   const value_t* begin() const {
+      return reinterpret_cast<const value_t*>(payload());
+   }
+   const value_t* end() const {
+      return begin() + length();
+   }
+
+   //soa: lanes per block, number of blocks and view of block b in place
+   std::size_t block_lanes() const {
+      return header().block_lanes;
+   }
+   std::size_t blocks() const {
+      const std::size_t lanes = header().block_lanes;
+      return (layout()==dataset_soa) ? (length() + lanes - 1)/lanes : 0;
+   }
+   view_t block(std::size_t b) const {
+      const std::size_t lanes = header().block_lanes;
+      storage_t* base = reinterpret_cast<storage_t*>(payload()) + b*CL::size*lanes;
+      std::array<storage_t*, CL::size> blades;
+      for(conf_t index = 0; index < CL::size; ++index) {
+         blades[index] = base + index*lanes;
+      }
+      return view_t(blades, std::min<std::size_t>(lanes, length() - b*lanes));
+   }
+
+protected:
+   const dataset_header& header() const {
+      return *reinterpret_cast<const dataset_header*>(address);
+   }
+   char* payload() const {
+      return static_cast<char*>(address) + header().payload;
+   }
+
+   void check() const {
+      const dataset_header& h = header();
+      const dataset_header e = make_dataset_header<CL, M, T>(dataset_aos, 0);
+      if(std::memcmp(h.magic, e.magic, 8) != 0) throw dataset_error(path, "not a gaalet dataset");
+      if(h.version != e.version) throw dataset_error(path, "unsupported version");
+      if(h.byte_order != e.byte_order) throw dataset_error(path, "byte order differs");
+      if(h.p != e.p || h.q != e.q || h.r != e.r) throw dataset_error(path, "signature differs from requested algebra");
+      if(h.element_type != e.element_type || h.element_size != e.element_size) throw dataset_error(path, "element type differs from requested algebra");
+      if(h.size != e.size || h.payload != e.payload) throw dataset_error(path, "blade list differs from requested multivector");
+      const std::array<std::uint32_t, CL::size> blades = dataset_blade_list<CL>();
+      if(std::memcmp(static_cast<const char*>(address) + sizeof(dataset_header), blades.data(), sizeof(blades)) != 0) {
+         throw dataset_error(path, "blade list differs from requested multivector");
+      }
+      //multivectors of count in payload, without overflow of byte counts for corrupt headers
+      if(h.layout != dataset_aos && (h.layout != dataset_soa || h.block_lanes == 0)) throw dataset_error(path, "unknown layout");
+      if(h.payload > bytes) throw dataset_error(path, "truncated payload");
+      const std::uint64_t capacity = (bytes - h.payload)/sizeof(value_t);
+      const std::uint64_t stored = (h.layout == dataset_aos) ? h.count
+                                   : (h.count/h.block_lanes + (h.count%h.block_lanes != 0 ? 1 : 0));
+      const std::uint64_t multiplier = (h.layout == dataset_aos) ? 1 : h.block_lanes;
+      if(multiplier > capacity || stored > capacity/multiplier) throw dataset_error(path, "truncated payload");
+   }
+
+   void close() {
+      if(address != MAP_FAILED) ::munmap(address, bytes);
+      if(fd >= 0) ::close(fd);
+      address = MAP_FAILED;
+      fd = -1;
+   }
+
+   std::string path;
+   int fd;
+   void* address;
+   std::size_t bytes;
+};
+
+template<class MV>
+class dataset_writer;
+
+/// Streaming writer of a dataset of multivectors of type multivector<CL, M, T>.
+/**
+ * Multivectors are appended by push() (evaluated expressions) or write() (arrays and batches), collected in one block buffer
+ * of block_lanes multivectors (aos) or lanes (soa) written by one system call per block. Arrays of aos datasets and full
+ * soa blocks of batches are written from the memory of the caller, arrays of soa datasets copied blade by blade into the block.
+ * The number of multivectors is written into the header by close().
+ */
+template<typename CL, typename M, typename T>
+class dataset_writer<multivector<CL, M, T>>
+{
+public:
+   typedef multivector<CL, M, T> value_t;
+   typedef multivector_array_view<CL, M, T> view_t;
+   typedef typename value_t::storage_t storage_t;
+
+   static_assert(sizeof(value_t)==CL::size*sizeof(storage_t), "dataset_writer: multivector storage not contiguous");
+
+   //block_lanes rounded up to multiple of alignment, stored in header of soa datasets
+   dataset_writer(const std::string& path_, dataset_layout layout = dataset_soa, std::size_t block_lanes = 4096)
+      :  path(path_), fd(-1),
+         header(make_dataset_header<CL, M, T>(layout, round_lanes(block_lanes))),
+         lanes(round_lanes(block_lanes)),
+         buffer((layout==dataset_soa) ? lanes : 0), aos_buffer((layout==dataset_aos) ? lanes : 0), pending(0)
+   {
+      fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if(fd < 0) throw dataset_error(path, "cannot create");
+
+      //header, blade list and padding to payload
+      const std::array<std::uint32_t, CL::size> blades = dataset_blade_list<CL>();
+      static const char padding[GAALET_ARRAY_ALIGNMENT] = { };
+      struct iovec head[3];
+      head[0].iov_base = &header;
+      head[0].iov_len = sizeof(dataset_header);
+      head[1].iov_base = const_cast<std::uint32_t*>(blades.data());
+      head[1].iov_len = CL::size*sizeof(std::uint32_t);
+      head[2].iov_base = const_cast<char*>(padding);
+      head[2].iov_len = header.payload - sizeof(dataset_header) - CL::size*sizeof(std::uint32_t);
+      write_vector(head, 3, header.payload);
+   }
+
+   ~dataset_writer() {
+      if(fd >= 0) {
+         try {
+            close();
+         }
+         catch(...) { }
+      }
+   }
+
+   dataset_writer(const dataset_writer&) = delete;
+   dataset_writer& operator=(const dataset_writer&) = delete;
+
+   //number of multivectors appended
+   std::size_t length() const {
+      return header.count;
+   }
+
+   //append evaluated expression
+   template<class E>
+   void push(const expression<E>& e) {
+      if(header.layout==dataset_aos) {
+         aos_buffer[pending] = e;
+      }
+      else {
+         buffer.set(pending, e);
+      }
+      ++header.count;
+      if(++pending == lanes) flush();
+   }
+
+   //append array of multivectors
+   void write(const value_t* m, std::size_t n) {
+      if(header.layout==dataset_aos) {
+         //pending block and array by one system call
+         struct iovec v[2];
+         v[0].iov_base = aos_buffer.data();
+         v[0].iov_len = pending*sizeof(value_t);
+         v[1].iov_base = const_cast<value_t*>(m);
+         v[1].iov_len = n*sizeof(value_t);
+         write_vector(v, 2, (pending + n)*sizeof(value_t));
+         pending = 0;
+         header.count += n;
+         return;
+      }
+      //soa: lanes copied blade by blade into block buffer
+      const storage_t* s = reinterpret_cast<const storage_t*>(m);
+      while(n > 0) {
+         const std::size_t k = std::min(n, lanes - pending);
+         for(conf_t index = 0; index < CL::size; ++index) {
+            storage_t* b = buffer.blade(index) + pending;
+            for(std::size_t i = 0; i < k; ++i) {
+               b[i] = s[i*CL::size + index];
+            }
+         }
+         s += k*CL::size;
+         n -= k;
+         header.count += k;
+         pending += k;
+         if(pending == lanes) flush();
+      }
+   }
+
+   //append batch of multivectors: full blocks of soa datasets gathered from blade arrays by one system call
+   void write(const view_t& a) {
+      std::size_t i = 0;
+      if(header.layout==dataset_soa) {
+         for(; pending > 0 && i < a.length(); ++i) push(a[i]);
+         for(; i + lanes <= a.length(); i += lanes) {
+            struct iovec blades[CL::size];
+            for(conf_t index = 0; index < CL::size; ++index) {
+               blades[index].iov_base = a.blade(index) + i;
+               blades[index].iov_len = lanes*sizeof(storage_t);
+            }
+            write_vector(blades, CL::size, CL::size*lanes*sizeof(storage_t));
+            header.count += lanes;
+         }
+      }
+      for(; i < a.length(); ++i) push(a[i]);
+   }
+
+   //pending block (padded with null elements for soa), count written into header
+   void close() {
+      if(pending > 0) {
+         if(header.layout==dataset_soa) {
+            for(conf_t index = 0; index < CL::size; ++index) {
+               std::fill(buffer.blade(index) + pending, buffer.blade(index) + lanes, storage_t());
+            }
+            pending = lanes;
+         }
+         flush();
+      }
+      if(::pwrite(fd, &header, sizeof(dataset_header), 0) != ssize_t(sizeof(dataset_header))) {
+         ::close(fd);
+         fd = -1;
+         throw dataset_error(path, "cannot write header");
+      }
+      ::close(fd);
+      fd = -1;
+   }
+
+protected:
+   static std::size_t round_lanes(std::size_t lanes) {
+      const std::size_t align = (GAALET_ARRAY_ALIGNMENT%sizeof(storage_t)==0) ? GAALET_ARRAY_ALIGNMENT/sizeof(storage_t) : 1;
+      return (std::max<std::size_t>(lanes, 1) + align - 1)/align*align;
+   }
+
+   //pending multivectors (aos) or full block (soa)
+   void flush() {
+      if(header.layout==dataset_aos) {
+         struct iovec v;
+         v.iov_base = aos_buffer.data();
+         v.iov_len = pending*sizeof(value_t);
+         write_vector(&v, 1, v.iov_len);
+      }
+      else {
+         struct iovec blades[CL::size];
+         for(conf_t index = 0; index < CL::size; ++index) {
+            blades[index].iov_base = buffer.blade(index);
+            blades[index].iov_len = lanes*sizeof(storage_t);
+         }
+         write_vector(blades, CL::size, CL::size*lanes*sizeof(storage_t));
+      }
+      pending = 0;
+   }
+
+   //complete write of n bytes, continued after partial writes
+   void write_vector(struct iovec* v, int count, std::size_t n) {
+      while(n > 0) {
+         const ssize_t written = ::writev(fd, v, count);
+         if(written <= 0) throw dataset_error(path, "cannot write");
+         n -= written;
+         for(std::size_t w = written; w > 0 && count > 0; ) {
+            if(w >= v->iov_len) {
+               w -= v->iov_len;
+               ++v;
+               --count;
+            }
+            else {
+               v->iov_base = static_cast<char*>(v->iov_base) + w;
+               v->iov_len -= w;
+               w = 0;
+            }
+         }
+      }
+   }
+
+   std::string path;
+   int fd;
+   dataset_header header;
+   std::size_t lanes;
+   multivector_array<CL, M, T> buffer;
+   std::vector<value_t> aos_buffer;
+   std::size_t pending;
+};
+
+} //end namespace gaalet
+
+#endif
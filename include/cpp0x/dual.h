@@ -2,20 +2,38 @@
 #define __GAALET_DUAL_H
 
 #include "utility.h"
+#include "materialization.h"
 
 namespace gaalet {
 
+//elements of bitmap b multiplied by pseudoscalar bitmap I, I<64
+constexpr conf_t dual_bits(conf_t b, conf_t I) {
+   return b ? ((conf_t(1)<<(lowest_bit(b)^I)) | dual_bits(b & (b-1), I)) : 0;
+}
+
+//dual by recursion through list
 template<conf_t I, typename list, typename colist = cl_null>
-struct dual_list
+struct dual_list_elements
 {
-   typedef typename dual_list<I, typename list::tail, typename insert_element< I ^ list::head, colist>::clist>::clist clist;
+   typedef typename dual_list_elements<I, typename list::tail, typename insert_element< I ^ list::head, colist>::clist>::clist clist;
 };
 template<conf_t I, typename colist>
-struct dual_list<I, cl_null, colist>
+struct dual_list_elements<I, cl_null, colist>
 {
    typedef colist clist;
 };
 
+template<conf_t I, typename list, bool flat = (list::flat && I<64)>
+struct dual_list
+{
+   typedef typename bitmap_clist<dual_bits(list::bitmap, I)>::clist clist;
+};
+template<conf_t I, typename list>
+struct dual_list<I, list, false>
+{
+   typedef typename dual_list_elements<I, list>::clist clist;
+};
+
 template<class A>
 struct dual : public expression<dual<A>>
 {
@@ -27,20 +45,51 @@ struct dual : public expression<dual<A>>
    
    typedef typename A::element_t element_t;
 
-   dual(const A& a_)
+   constexpr dual(const A& a_)
       :  a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return (search_element<conf, clist>::index>=clist::size) ? 0.0 : a.template element< I ^ conf >()
                                                                      * (Power<-1, BitCount<I>::value*(BitCount<I>::value-1)/2>::value
                                                                      * CanonicalReorderingSign<I ^ conf, I>::value
                                                                      * ((BitCount<metric::signature_bitmap&((I ^ conf) & I)>::value % 2) ? -1 : 1));
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+};
+template<class A>
+struct is_cheap_expression<dual<A>>
+{
+   static const bool value = is_cheap_expression<A>::value;
+};
+//aliasing: element conf reads element I^conf
+template<class A, class D, conf_t conf>
+struct alias_source<dual<A>, D, conf>
+{
+   static const conf_t value = (search_element<conf, typename dual<A>::clist>::index<dual<A>::clist::size) ? alias_source<A, D, dual<A>::I ^ conf>::value : alias_none;
+};
+
+//cost model: signs folded
+template<class A, conf_t conf>
+struct element_cost<dual<A>, conf>
+{
+   typedef typename std::conditional<(search_element<conf, typename dual<A>::clist>::index<dual<A>::clist::size),
+                                     typename element_cost<A, dual<A>::I ^ conf>::type, operations<>>::type type;
 };
 
 
@@ -52,7 +101,7 @@ protected:
   */
 /// \ingroup ga_ops
 
-template <class A> inline
+template <class A> constexpr
 gaalet::dual<A>
 dual(const gaalet::expression<A>& a) {
    return gaalet::dual<A>(a);
@@ -0,0 +1,78 @@
+#ifndef __GAALET_ELEMENT_FUNCTIONS_H
+#define __GAALET_ELEMENT_FUNCTIONS_H
+
+#include <cmath>
+
+namespace gaalet
+{
+
+//scalar factors of the multivector functions (exp, sinh, cosh, log): analytic in their arguments, removable singularities resolved by branches on values
+// --- overloaded by element types carrying derivatives (ad::fvar), which need the derivatives at the branch points as well
+// --- math functions of element types found by argument-dependent lookup (using-declarations hide expression names of gaalet)
+
+//cosh(sqrt(s)) and sinh(sqrt(s))/sqrt(s), continued to s<0 by cos(sqrt(-s)) and sin(sqrt(-s))/sqrt(-s): exp(b) = c + b*sc for bivector b with b*b = s
+template<typename T> inline
+void cosh_sinhc_sqrt(const T& s, T& c, T& sc)
+{
+   using std::sqrt; using std::cos; using std::sin; using std::cosh; using std::sinh;
+
+   if(s < 0.0) {
+      T alpha = sqrt(-s);
+      c = cos(alpha);
+      sc = sin(alpha)/alpha;
+   }
+   else if(s == 0.0 || s == -0.0) {
+      c = 1.0;
+      sc = 1.0;
+   }
+   else {
+      T alpha = sqrt(s);
+      c = cosh(alpha);
+      sc = sinh(alpha)/alpha;
+   }
+}
+
+//cosh(sqrt(s)), continued to s<0 by cos(sqrt(-s))
+template<typename T> inline
+T cosh_sqrt(const T& s)
+{
+   using std::sqrt; using std::cos; using std::cosh;
+
+   return (s < 0.0) ? T(cos(sqrt(-s))) : T(cosh(sqrt(s)));
+}
+
+//sinh(sqrt(s))/sqrt(s), continued to s<0 by sin(sqrt(-s))/sqrt(-s), one at s=0
+template<typename T> inline
+T sinhc_sqrt(const T& s)
+{
+   using std::sqrt; using std::sin; using std::sinh;
+
+   if(s < 0.0) {
+      T alpha = sqrt(-s);
+      return sin(alpha)/alpha;
+   }
+   else if(s == 0.0 || s == -0.0) {
+      return T(1.0);
+   }
+   else {
+      T alpha = sqrt(s);
+      return sinh(alpha)/alpha;
+   }
+}
+
+//atan2(sqrt(q), r)/sqrt(q): angle of spinor r + b divided by magnitude of bivector b with q = |b|^2, 1/r at q=0
+template<typename T> inline
+T atan2_div_sqrt(const T& r, const T& q)
+{
+   using std::sqrt; using std::atan2;
+
+   if(q == 0.0) {
+      return 1.0/r;
+   }
+   T b = sqrt(q);
+   return atan2(b, r)/b;
+}
+
+} //end namespace gaalet
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "grade.h"
 #include "geometric_product.h"
+#include "element_functions.h"
 
 namespace gaalet {
 
@@ -27,13 +28,22 @@ struct check_scalar
    static const bool value = (CL::size==1 && BitCount<CL::head>::value==0) ? true : false;
 };
 
+//multivectors with vanishing square known at compile time (specialized by constant multivectors)
+template<class A>
+struct is_nilpotent
+{
+   static const bool value = false;
+};
+
 //go through inversion evaluation type checks
+//value=2 - nilpotent bivector exponential
 //value=1 - bivector exponential
-//value=2 - scalar exponential
+//value=0 - scalar exponential
 template<class A>
 struct exponential_evaluation_type
 {
-   static const int value = (check_bivector<typename A::clist>::value) ? 1 :
+   static const int value = (check_bivector<typename A::clist>::value && is_nilpotent<A>::value) ? 2 :
+                            (check_bivector<typename A::clist>::value) ? 1 :
                             (check_scalar<typename A::clist>::value) ? 0 :
                             -1;
 };
@@ -54,50 +64,69 @@ struct exponential<A, 1> : public expression<exponential<A>>
 
    typedef typename A::element_t element_t;
 
-   //dangerous implementation: constructor only called when expression is defined, not when evaluated
    exponential(const A& a_)
-      :  a(a_),
-         first_eval(true)
+      :  a(a_)
    { }
 
-   //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
    template<conf_t conf>
    element_t element() const {
-      if(first_eval) {
-         element_t alpha_square = eval(grade<0, decltype(a*a)>(a*a));
-         if(alpha_square < 0.0) {
-            element_t alpha = sqrt(-alpha_square);
-            ca = cos(alpha);
-            sada = sin(alpha)/alpha;
-         }
-         else if(alpha_square == 0.0 || alpha_square == -0.0) {
-            ca = 1.0;
-            sada = 1.0;
-         }
-         //else if(alpha_square > 0.0) {
-         else {
-            element_t alpha = sqrt(alpha_square);
-            ca = cosh(alpha);
-            sada = sinh(alpha)/alpha;
-         }
-         first_eval = false;
-      }
-
-      if(conf!=0)
-         return a.template element<conf>()*sada;
-      else
-         return ca;
+      return (conf!=0) ? a.template element<conf>()*sada : ca;
+   }
+
+   //scalar factors computed once per evaluation
+   void init() {
+      a.init();
+      element_t alpha_square = self_scalar_product<A, self_product_square>::value(a);
+      cosh_sinhc_sqrt(alpha_square, ca, sada);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
+protected:
+   typename expression_storage<A>::type a;
+   element_t ca;
+   element_t sada;
+};
+
+//nilpotent bivector exponential: exp(a) = 1 + a, free of trigonometric functions
+template<class A>
+struct exponential<A, 2> : public expression<exponential<A>>
+{
+   typedef typename insert_element<0, typename A::clist>::clist clist;
+
+   typedef typename A::metric metric;
+
+   typedef typename A::element_t element_t;
+
+   constexpr exponential(const A& a_)
+      :  a(a_)
+   { }
+
+   template<conf_t conf>
+   constexpr element_t element() const {
+      return (conf!=0) ? a.template element<conf>() : element_t(1);
+   }
+
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
    }
-   /*template<>
-   element_t element<0>() const {
-      return ca;
-   }*/
 
 protected:
-   const A& a;
-   mutable element_t ca;
-   mutable element_t sada;
-   mutable bool first_eval;
+   typename expression_storage<A>::type a;
 };
 
 //scalar exponential
@@ -119,11 +148,72 @@ struct exponential<A, 0> : public expression<exponential<A>>
       return (conf==0) ? exp(a.template element<conf>()) : 0.0;
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
 };
 
 
+//factors computed by init()
+template<class A>
+struct has_state<exponential<A, 1>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_state<exponential<A, 2>>
+{
+   static const bool value = has_state<A>::value;
+};
+template<class A>
+struct has_state<exponential<A, 0>>
+{
+   static const bool value = has_state<A>::value;
+};
+
+//cost model: scalar square a*a, trigonometric or hyperbolic factors once per evaluation
+template<class A, conf_t conf>
+struct element_cost<exponential<A, 1>, conf>
+{
+   typedef typename std::conditional<(conf!=0), typename operations_sum<typename element_cost<A, conf>::type, operations<0, 1>>::type, operations<>>::type type;
+};
+template<class A>
+struct init_cost<exponential<A, 1>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_square>::cost, operations<0, 0, 1, 1, 2>>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<exponential<A, 2>, conf>
+{
+   typedef typename std::conditional<(conf!=0), typename element_cost<A, conf>::type, operations<>>::type type;
+};
+template<class A>
+struct init_cost<exponential<A, 2>>
+{
+   typedef typename init_cost<A>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<exponential<A, 0>, conf>
+{
+   typedef typename std::conditional<(conf==0), typename operations_sum<typename element_cost<A, conf>::type, operations<0, 0, 0, 0, 0, 1>>::type, operations<>>::type type;
+};
+template<class A>
+struct init_cost<exponential<A, 0>>
+{
+   typedef typename init_cost<A>::type type;
+};
+
 }  //end namespace gaalet
 
 /// Exponential of a multivector.
@@ -131,7 +221,7 @@ protected:
  * Only implemented for scalars and bivectors.
  */
 /// \ingroup ga_ops
-template <class A> inline
+template <class A> constexpr
 gaalet::exponential<A>
 exp(const gaalet::expression<A>& a) {
    return gaalet::exponential<A>(a);
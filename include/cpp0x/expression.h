@@ -4,6 +4,7 @@
 #include "configuration_list.h"
 
 
+#include <cstddef>
 #include <iostream>
 #include <iomanip>
 
@@ -14,11 +15,80 @@ namespace gaalet
 //Wrapper class for CRTP
 template <class E>
 struct expression {
-   operator const E& () const {
+   constexpr operator const E& () const {
       return *static_cast<const E*>(this);
    }
+
+   //pre-evaluation hook: called once per evaluation on a private copy of the expression tree, before any element is evaluated
+   void init() { }
+
+   //aliasing hook: expression reads multivector storage at address d by reference (conservative default for nodes not forwarding)
+   constexpr bool aliases(const void*) const {
+      return true;
+   }
+
+   //lane hook: batch operands (multivector_array_view) read lane l by subsequent element evaluation, forwarded to operands
+   void bind_lane(std::size_t) const { }
+};
+
+//storage of operands in expression nodes: sub-expressions by value (copied with the tree), multivectors by reference
+template<class E>
+struct expression_storage
+{
+   typedef E type;
+};
+
+//expressions with state computed by init(): elements are valid only on a prepared copy, thus not evaluable in constant expressions
+template<class E>
+struct has_state
+{
+   static const bool value = false;
+};
+
+template<class... A>
+struct any_state;
+template<>
+struct any_state<>
+{
+   static const bool value = false;
+};
+template<class A, class... AA>
+struct any_state<A, AA...>
+{
+   static const bool value = has_state<A>::value || any_state<AA...>::value;
+};
+
+//nodes with operand types as only template parameters: state of operands
+template<template<class...> class N, class... A>
+struct has_state<N<A...>>
+{
+   static const bool value = any_state<A...>::value;
 };
 
+//aliasing of destination multivector of type D by operands: element of D read by element conf of expression E
+//   alias_none: no element of D, alias_several: several or unknown elements (default, decided at runtime by aliases())
+const conf_t alias_none = conf_t(-1);
+const conf_t alias_several = conf_t(-2);
+
+template<class E, class D, conf_t conf>
+struct alias_source
+{
+   static const conf_t value = alias_several;
+};
+
+//element read by element-wise combination of operands reading elements l and r
+constexpr conf_t alias_combine(conf_t l, conf_t r) {
+   return (l==alias_none) ? r : ((r==alias_none || r==l) ? l : alias_several);
+}
+
+//private copy of expression tree, prepared for element evaluation
+template<class E> inline
+E prepare(const expression<E>& e_) {
+   E e(static_cast<const E&>(e_));
+   e.init();
+   return e;
+}
+
 } //end namespace gaalet
 
 
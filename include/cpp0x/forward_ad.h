@@ -0,0 +1,338 @@
+#ifndef __GAALET_FORWARD_AD_H
+#define __GAALET_FORWARD_AD_H
+
+#include "multivector.h"
+#include "element_functions.h"
+
+#include <array>
+#include <cmath>
+#include <ostream>
+#include <type_traits>
+
+namespace gaalet
+{
+
+//automatic differentiation element types (own namespace for argument-dependent lookup of math functions, which are expression names in gaalet)
+namespace ad
+{
+
+/// Forward-mode automatic differentiation element type: value of type T with its derivatives in N directions.
+/**
+ * Usable as element type of an algebra, e.g. algebra<signature<3,0>, ad::fvar<double, 3>>: one evaluation of an expression
+ * yields the values and the Jacobian of all elements with respect to N seeded variables (see variables() and jacobian()).
+ * Branches of the library evaluate on values, derivatives at branch points given by the overloaded element functions.
+ */
+template<typename T, unsigned int N>
+struct fvar
+{
+   typedef T value_type;
+
+   static const unsigned int size = N;
+
+   constexpr fvar()
+      :  value(0), tangent()
+   { }
+
+   constexpr fvar(const T& v)
+      :  value(v), tangent()
+   { }
+
+   //independent variable: unit derivative in direction i
+   fvar(const T& v, unsigned int i)
+      :  value(v), tangent()
+   {
+      tangent[i] = 1;
+   }
+
+   fvar& operator+=(const fvar& a) {
+      value += a.value;
+      for(unsigned int i = 0; i < N; ++i) tangent[i] += a.tangent[i];
+      return *this;
+   }
+   fvar& operator-=(const fvar& a) {
+      value -= a.value;
+      for(unsigned int i = 0; i < N; ++i) tangent[i] -= a.tangent[i];
+      return *this;
+   }
+   fvar& operator*=(const fvar& a) {
+      return *this = *this * a;
+   }
+   fvar& operator/=(const fvar& a) {
+      return *this = *this / a;
+   }
+
+   T value;
+   T tangent[N];
+};
+
+//value f(a) with derivative df by value of a: chain rule
+template<typename T, unsigned int N> inline
+fvar<T, N> chain(const fvar<T, N>& a, const T& f, const T& df) {
+   fvar<T, N> r(f);
+   for(unsigned int i = 0; i < N; ++i) r.tangent[i] = df*a.tangent[i];
+   return r;
+}
+
+//arithmetic
+template<typename T, unsigned int N> inline
+fvar<T, N> operator+(const fvar<T, N>& l, const fvar<T, N>& r) {
+   fvar<T, N> s(l);
+   return s += r;
+}
+template<typename T, unsigned int N> inline
+fvar<T, N> operator-(const fvar<T, N>& l, const fvar<T, N>& r) {
+   fvar<T, N> s(l);
+   return s -= r;
+}
+template<typename T, unsigned int N> inline
+fvar<T, N> operator*(const fvar<T, N>& l, const fvar<T, N>& r) {
+   fvar<T, N> p(l.value*r.value);
+   for(unsigned int i = 0; i < N; ++i) p.tangent[i] = l.tangent[i]*r.value + l.value*r.tangent[i];
+   return p;
+}
+template<typename T, unsigned int N> inline
+fvar<T, N> operator/(const fvar<T, N>& l, const fvar<T, N>& r) {
+   T inv_r = T(1)/r.value;
+   fvar<T, N> q(l.value*inv_r);
+   for(unsigned int i = 0; i < N; ++i) q.tangent[i] = (l.tangent[i] - q.value*r.tangent[i])*inv_r;
+   return q;
+}
+
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator+(const fvar<T, N>& l, S r) {
+   fvar<T, N> s(l);
+   s.value += T(r);
+   return s;
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator+(S l, const fvar<T, N>& r) {
+   return r + l;
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator-(const fvar<T, N>& l, S r) {
+   fvar<T, N> s(l);
+   s.value -= T(r);
+   return s;
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator-(S l, const fvar<T, N>& r) {
+   return chain(r, T(l) - r.value, T(-1));
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator*(const fvar<T, N>& l, S r) {
+   return chain(l, l.value*T(r), T(r));
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator*(S l, const fvar<T, N>& r) {
+   return chain(r, T(l)*r.value, T(l));
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator/(const fvar<T, N>& l, S r) {
+   T inv_r = T(1)/T(r);
+   return chain(l, l.value*inv_r, inv_r);
+}
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+operator/(S l, const fvar<T, N>& r) {
+   T q = T(l)/r.value;
+   return chain(r, q, -q/r.value);
+}
+
+template<typename T, unsigned int N> inline
+fvar<T, N> operator-(const fvar<T, N>& a) {
+   return chain(a, -a.value, T(-1));
+}
+
+//comparison of values
+#define GAALET_FVAR_COMPARISON(op) \
+template<typename T, unsigned int N> inline \
+bool operator op(const fvar<T, N>& l, const fvar<T, N>& r) { \
+   return l.value op r.value; \
+} \
+template<typename T, unsigned int N, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(const fvar<T, N>& l, S r) { \
+   return l.value op T(r); \
+} \
+template<typename T, unsigned int N, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(S l, const fvar<T, N>& r) { \
+   return T(l) op r.value; \
+}
+GAALET_FVAR_COMPARISON(==)
+GAALET_FVAR_COMPARISON(!=)
+GAALET_FVAR_COMPARISON(<)
+GAALET_FVAR_COMPARISON(<=)
+GAALET_FVAR_COMPARISON(>)
+GAALET_FVAR_COMPARISON(>=)
+#undef GAALET_FVAR_COMPARISON
+
+//functions: value y = f(x) and derivative by x
+#define GAALET_FVAR_FUNCTION(f, df) \
+template<typename T, unsigned int N> inline \
+fvar<T, N> f(const fvar<T, N>& a) { \
+   const T x = a.value; \
+   const T y = std::f(x); \
+   return chain(a, y, T(df)); \
+}
+GAALET_FVAR_FUNCTION(sqrt, 0.5/y)
+GAALET_FVAR_FUNCTION(sin, std::cos(x))
+GAALET_FVAR_FUNCTION(cos, -std::sin(x))
+GAALET_FVAR_FUNCTION(tan, 1.0 + y*y)
+GAALET_FVAR_FUNCTION(asin, 1.0/std::sqrt(1.0 - x*x))
+GAALET_FVAR_FUNCTION(acos, -1.0/std::sqrt(1.0 - x*x))
+GAALET_FVAR_FUNCTION(atan, 1.0/(1.0 + x*x))
+GAALET_FVAR_FUNCTION(sinh, std::cosh(x))
+GAALET_FVAR_FUNCTION(cosh, std::sinh(x))
+GAALET_FVAR_FUNCTION(tanh, 1.0 - y*y)
+GAALET_FVAR_FUNCTION(exp, y)
+GAALET_FVAR_FUNCTION(log, 1.0/x)
+GAALET_FVAR_FUNCTION(fabs, (x < 0.0) ? -1.0 : 1.0)
+#undef GAALET_FVAR_FUNCTION
+
+template<typename T, unsigned int N, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, fvar<T, N>>::type
+pow(const fvar<T, N>& a, S p) {
+   return chain(a, T(std::pow(a.value, T(p))), T(p*std::pow(a.value, T(p) - 1)));
+}
+
+//element functions of the multivector functions with their derivatives, also at the branch points
+
+//derivative of sinh(sqrt(s))/sqrt(s) by s from c = cosh(sqrt(s)) and sc = sinh(sqrt(s))/sqrt(s), Taylor series where (c-sc)/(2s) cancels
+template<typename T> inline
+T sinhc_sqrt_derivative(const T& s, const T& c, const T& sc) {
+   if(std::fabs(s) < 1e-3) {
+      return 1.0/6.0 + s*(1.0/60.0 + s*(1.0/1680.0 + s/90720.0));
+   }
+   return (c - sc)/(2.0*s);
+}
+
+template<typename T, unsigned int N> inline
+void cosh_sinhc_sqrt(const fvar<T, N>& s, fvar<T, N>& c, fvar<T, N>& sc) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   c = chain(s, c_v, T(0.5*sc_v));
+   sc = chain(s, sc_v, sinhc_sqrt_derivative(s.value, c_v, sc_v));
+}
+
+template<typename T, unsigned int N> inline
+fvar<T, N> cosh_sqrt(const fvar<T, N>& s) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   return chain(s, c_v, T(0.5*sc_v));
+}
+
+template<typename T, unsigned int N> inline
+fvar<T, N> sinhc_sqrt(const fvar<T, N>& s) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   return chain(s, sc_v, sinhc_sqrt_derivative(s.value, c_v, sc_v));
+}
+
+//g = atan2(sqrt(q), r)/sqrt(q): dg/dr = -1/m^2, dg/dq = (r - g*m^2)/(2*q*m^2) with m^2 = r*r+q, series in q/r^2 where it cancels
+template<typename T> inline
+void atan2_div_sqrt_derivatives(const T& r, const T& q, const T& g, T& dg_dr, T& dg_dq) {
+   const T m_square = r*r + q;
+   dg_dr = -1.0/m_square;
+   if(r > 0.0 && q < 1e-4*r*r) {
+      const T u = q/(r*r);
+      dg_dq = (-1.0/3.0 + u*(2.0/5.0 - u*3.0/7.0))/(r*r*r);
+   }
+   else {
+      dg_dq = (r - g*m_square)/(2.0*q*m_square);
+   }
+}
+
+template<typename T, unsigned int N> inline
+fvar<T, N> atan2_div_sqrt(const fvar<T, N>& r, const fvar<T, N>& q) {
+   const T g = gaalet::atan2_div_sqrt(r.value, q.value);
+   T dg_dr, dg_dq;
+   atan2_div_sqrt_derivatives(r.value, q.value, g, dg_dr, dg_dq);
+
+   fvar<T, N> a(g);
+   for(unsigned int i = 0; i < N; ++i) a.tangent[i] = dg_dr*r.tangent[i] + dg_dq*q.tangent[i];
+   return a;
+}
+
+template<class E, class TR, typename T, unsigned int N>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const fvar<T, N>& a)
+{
+   os << a.value << '[';
+   for(unsigned int i = 0; i < N; ++i) {
+      os << ((i==0) ? "" : ",") << a.tangent[i];
+   }
+   os << ']';
+   return os;
+}
+
+/// Multivector of independent variables: element k of m seeded as direction first+k.
+template<unsigned int N, typename CL, typename M, typename T> inline
+multivector<CL, M, fvar<T, N>> variables(const multivector<CL, M, T>& m, unsigned int first = 0)
+{
+   multivector<CL, M, fvar<T, N>> v;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      v[k] = fvar<T, N>(m[k], first + k);
+   }
+   return v;
+}
+
+/// Values of the elements of a multivector of fvar elements.
+template<typename CL, typename M, typename T, unsigned int N> inline
+multivector<CL, M, T> values(const multivector<CL, M, fvar<T, N>>& m)
+{
+   multivector<CL, M, T> v;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      v[k] = m[k].value;
+   }
+   return v;
+}
+
+/// Jacobian of a multivector of fvar elements: derivative of element k in direction i at [k][i].
+template<typename CL, typename M, typename T, unsigned int N> inline
+std::array<std::array<T, N>, CL::size> jacobian(const multivector<CL, M, fvar<T, N>>& m)
+{
+   std::array<std::array<T, N>, CL::size> J;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      for(unsigned int i = 0; i < N; ++i) {
+         J[k][i] = m[k].tangent[i];
+      }
+   }
+   return J;
+}
+
+}  //end namespace ad
+
+//element type combination: fvar elements dominate plain scalars
+template<typename T, unsigned int N, typename E>
+struct element_type_combination_traits<ad::fvar<T, N>, E>
+{
+   typedef ad::fvar<T, N> element_t;
+};
+template<typename E, typename T, unsigned int N>
+struct element_type_combination_traits<E, ad::fvar<T, N>>
+{
+   typedef ad::fvar<T, N> element_t;
+};
+template<typename T, unsigned int N>
+struct element_type_combination_traits<ad::fvar<T, N>, ad::fvar<T, N>>
+{
+   typedef ad::fvar<T, N> element_t;
+};
+
+template<typename T, unsigned int N>
+struct null_element<ad::fvar<T, N>> {
+   static constexpr ad::fvar<T, N> value() {
+      return ad::fvar<T, N>();
+   }
+};
+
+} //end namespace gaalet
+
+#endif
@@ -16,6 +16,11 @@
 
 
 #include "multivector.h"
+#include "multivector_array.h"
+#include "simd.h"
+#include "counting.h"
+#include "forward_ad.h"
+#include "reverse_ad.h"
 #include "algebra.h"
 #include "streaming.h"
 
@@ -31,5 +36,9 @@
 #include "scalar.h"
 #include "magnitude.h"
 #include "dual.h"
+#include "materialization.h"
+#include "sandwich.h"
+#include "versor_map.h"
+#include "constant.h"
 
 #endif
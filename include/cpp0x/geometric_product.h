@@ -2,6 +2,9 @@
 #define __GAALET_GEOMETRIC_PRODUCT_H
 
 #include "utility.h"
+#include "materialization.h"
+#include "product_table.h"
+#include "multiplication_list.h"
 
 namespace gaalet
 {
@@ -15,7 +18,7 @@ struct msl_null
    static const conf_t size = 0;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L&, const R&)
+   static constexpr element_t product_sum(const L&, const R&)
    {
       return 0.0;
    }
@@ -26,19 +29,20 @@ struct multiplication_sum_list
 {
    static const conf_t left = LC;
    static const conf_t right = RC;
+   static const int reordering_sign = canonical_reordering_sign(LC, RC);
 
    typedef T tail;
 
    static const conf_t size = T::size + 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
 
       return
          l.template element<left>()*r.template element<right>()
-         *CanonicalReorderingSign<left, right>::value
+         *reordering_sign
          *((BitCount<metric::signature_bitmap&(left&right)>::value % 2) ? -1 : 1)
          + tail::template product_sum<element_t>(l, r);
    }
@@ -48,19 +52,20 @@ struct multiplication_sum_list<LC, RC, msl_null>
 {
    static const conf_t left = LC;
    static const conf_t right = RC;
+   static const int reordering_sign = canonical_reordering_sign(LC, RC);
 
    typedef msl_null tail;
 
    static const conf_t size = 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
 
       return
          l.template element<left>()*r.template element<right>()
-         *CanonicalReorderingSign<left, right>::value
+         *reordering_sign
          *((BitCount<metric::signature_bitmap&(left&right)>::value % 2) ? -1 : 1);
    }
 };
@@ -78,7 +83,7 @@ struct multiplication_element_list
    static const conf_t size = T::size + 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       return head::template product_sum<element_t>(l, r);
    }
@@ -92,7 +97,7 @@ struct mel_null
    static const conf_t size = 0;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L&, const R&)
+   static constexpr element_t product_sum(const L&, const R&)
    {
       return 0.0;
    }
@@ -189,6 +194,31 @@ struct search_conf_in_melist<conf, mel_null, true>
    typedef mel_null melist;
 };
 
+//product policy for construction of multiplication element lists: element multiplications of non-degenerate basis vectors
+template<typename metric>
+struct product
+{
+   static constexpr bool contributes(conf_t l, conf_t r) {
+      return !(metric::degenerate_bitmap & l & r);
+   }
+
+   static constexpr int sign(conf_t l, conf_t r) {
+      return canonical_reordering_sign(l, r)*((bit_count(metric::signature_bitmap&(l&r)) % 2) ? -1 : 1);
+   }
+
+   template<typename LCL, typename RCL>
+   struct recursive_list
+   {
+      typedef typename build_multiplication_element_list<LCL, RCL, metric>::melist melist;
+   };
+
+   template<conf_t C, typename melist>
+   struct search_list
+   {
+      typedef typename search_conf_in_melist<C, melist>::melist list;
+   };
+};
+
 }  //end namespace gp
 
 template<class L, class R>
@@ -197,22 +227,86 @@ struct geometric_product : public expression<geometric_product<L, R>>
    typedef typename element_type_combination_traits<typename L::element_t, typename R::element_t>::element_t element_t;
    typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
 
-   typedef typename gp::build_multiplication_element_list<typename L::clist, typename R::clist, metric>::melist melist;
+   typedef gp::product<metric> product_policy;
+   typedef typename build_product_melist<product_policy, typename L::clist, typename R::clist>::melist melist;
    typedef typename melist::clist clist;
 
+   typedef product_table<melist, metric, typename L::clist, typename R::clist> table;
+
+   typedef typename operand_storage<L, melist>::type l_storage_t;
+   typedef typename operand_storage<R, melist>::type r_storage_t;
 
-   geometric_product(const L& l_ , const R& r_)
+
+   constexpr geometric_product(const L& l_ , const R& r_)
       :  l(l_), r(r_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
-      return gp::search_conf_in_melist<conf, melist>::melist::template product_sum<element_t>(l, r);
+   constexpr element_t element() const {
+      return product_sum_list<product_policy, conf, typename L::clist, typename R::clist, melist>::list::template product_sum<element_t>(l, r);
+   }
+
+   void init() {
+      l.init();
+      r.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return l.aliases(d) || r.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      l.bind_lane(lane);
+      r.bind_lane(lane);
+   }
+
+   //table-driven evaluation, operands with multivector storage only
+   template<typename DCL, typename T, typename D>
+   void evaluate(D& data) const {
+      table::template evaluate<DCL, T>(data, storage_of(l), storage_of(r));
    }
 
 protected:
-   const L& l;
-   const R& r;
+   l_storage_t l;
+   r_storage_t r;
+};
+
+template<class L, class R>
+struct evaluation_kernel<geometric_product<L, R>>
+{
+   typedef geometric_product<L, R> E;
+
+   static const bool value = has_storage<typename std::remove_cv<typename std::remove_reference<typename E::l_storage_t>::type>::type>::value
+                             && has_storage<typename std::remove_cv<typename std::remove_reference<typename E::r_storage_t>::type>::type>::value;
+};
+
+//state of operand storage
+template<class L, class R>
+struct has_state<geometric_product<L, R>>
+{
+   typedef geometric_product<L, R> E;
+
+   static const bool value = has_state<typename std::remove_cv<typename std::remove_reference<typename E::l_storage_t>::type>::type>::value
+                             || has_state<typename std::remove_cv<typename std::remove_reference<typename E::r_storage_t>::type>::type>::value;
+};
+
+//product of operands with elements carried in the type
+template<class L, class R>
+struct has_constant_elements<geometric_product<L, R>>
+{
+   static const bool value = has_constant_elements<L>::value && has_constant_elements<R>::value;
+};
+
+//cost model: element multiplications of operand storage
+template<class L, class R, conf_t conf>
+struct element_cost<geometric_product<L, R>, conf>
+{
+   typedef typename product_element_cost<geometric_product<L, R>, conf>::type type;
+};
+template<class L, class R>
+struct init_cost<geometric_product<L, R>>
+{
+   typedef typename product_init_cost<geometric_product<L, R>>::type type;
 };
 
 template<class A>
@@ -224,25 +318,117 @@ struct scalar_multivector_product : public expression<scalar_multivector_product
 
    typedef typename A::element_t element_t;
 
-   scalar_multivector_product(const element_t& s_, const A& a_)
+   constexpr scalar_multivector_product(const element_t& s_, const A& a_)
       :  s(s_), a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return s*a.template element<conf>();
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const element_t& s;
-   const A& a;
+   element_t s;
+   typename expression_storage<A>::type a;
+};
+
+template<class A>
+struct is_cheap_expression<scalar_multivector_product<A>>
+{
+   static const bool value = is_cheap_expression<A>::value;
+};
+
+template<class A, class D, conf_t conf>
+struct alias_source<scalar_multivector_product<A>, D, conf>
+{
+   static const conf_t value = alias_source<A, D, conf>::value;
+};
+
+template<class A, conf_t conf>
+struct element_cost<scalar_multivector_product<A>, conf>
+{
+   typedef typename operations_sum<typename element_cost<A, conf>::type, operations<0, 1>>::type type;
+};
+
+//scalar products of an expression with itself, summed from its elements once: for init() of stateful nodes on their already prepared operand
+// --- self_product_square: scalar element of a*a, self_product_reverse: scalar element of (~a)*a,
+//     self_product_bivector: sum of squares of the elements of grade 2
+const int self_product_square = 0;
+const int self_product_reverse = 1;
+const int self_product_bivector = 2;
+
+template<class A, int mode, typename CL = typename A::clist, bool end = (CL::size==0)>
+struct self_scalar_product
+{
+   typedef typename A::element_t element_t;
+   typedef typename A::metric metric;
+   typedef self_scalar_product<A, mode, typename CL::tail> tail;
+
+   static const conf_t conf = CL::head;
+
+   //sign of term a_conf*a_conf, 0 if vanishing (reordering sign of a*a cancelled by reversion in (~a)*a)
+   static const int sign = (mode==self_product_bivector) ? ((BitCount<conf>::value==2) ? 1 : 0) :
+                           (metric::degenerate_bitmap&conf) ? 0 :
+                           ((mode==self_product_square) ? CanonicalReorderingSign<conf, conf>::value : 1)
+                              *((BitCount<metric::signature_bitmap&conf>::value % 2) ? -1 : 1);
+
+   static element_t value(const A& a) {
+      return first(a);
+   }
+
+   static element_t first(const A& a) {
+      return sign ? tail::next((sign>0) ? square(a) : element_t(-square(a)), a) : tail::first(a);
+   }
+
+   static element_t next(const element_t& s, const A& a) {
+      return sign ? tail::next((sign>0) ? element_t(s + square(a)) : element_t(s - square(a)), a) : tail::next(s, a);
+   }
+
+   static element_t square(const A& a) {
+      const element_t e = a.template element<conf>();
+      return e*e;
+   }
+
+   //cost model: one read and multiplication per term, one addition per term after the first
+   static const unsigned long long terms = (sign ? 1 : 0) + tail::terms;
+   typedef typename operations_sum<typename std::conditional<(sign!=0), typename element_cost<A, conf>::type, operations<>>::type,
+                                   typename tail::reads>::type reads;
+   typedef typename operations_sum<reads, operations<(terms>1) ? terms-1 : 0, terms>>::type cost;
+};
+template<class A, int mode, typename CL>
+struct self_scalar_product<A, mode, CL, true>
+{
+   typedef typename A::element_t element_t;
+
+   static element_t first(const A&) {
+      return null_element<element_t>::value();
+   }
+
+   static element_t next(const element_t& s, const A&) {
+      return s;
+   }
+
+   static const unsigned long long terms = 0;
+   typedef operations<> reads;
 };
 
 } //end namespace gaalet
 
 /// \brief Geometric product of two multivectors.
 /// \ingroup ga_ops
-template <class L, class R> inline
+template <class L, class R> constexpr
 gaalet::geometric_product<L, R>
 operator*(const gaalet::expression<L>& l, const gaalet::expression<R>& r) {
    return gaalet::geometric_product<L, R>(l, r);
@@ -250,7 +436,7 @@ operator*(const gaalet::expression<L>& l, const gaalet::expression<R>& r) {
 
 /// \brief Geometric product of a scalar and a multivector.
 /// \ingroup ga_ops
-template <class A> inline
+template <class A> constexpr
 gaalet::scalar_multivector_product<A>
 operator*(const typename A::element_t& s, const gaalet::expression<A>& a) {
    return gaalet::scalar_multivector_product<A>(s, a);
@@ -258,10 +444,32 @@ operator*(const typename A::element_t& s, const gaalet::expression<A>& a) {
 
 /// \brief Geometric product of a multivector and a scalar.
 /// \ingroup ga_ops
-template <class A> inline
+template <class A> constexpr
 gaalet::scalar_multivector_product<A>
 operator*(const gaalet::expression<A>& a, const typename A::element_t& s) {
    return gaalet::scalar_multivector_product<A>(s, a);
 }
 
+/// \brief Geometric product of a multivector and a multivector in place.
+/**
+ * Evaluated as l = l*r: elements outside the configuration list of l are discarded. The product reads several
+ * elements of l per element, thus it is evaluated into a temporary (see multivector::Aliasing).
+ */
+/// \ingroup ga_ops
+template <class CL, class M, class T, class R> inline
+gaalet::multivector<CL, M, T>&
+operator*=(gaalet::multivector<CL, M, T>& l, const gaalet::expression<R>& r) {
+   l = l*r;
+   return l;
+}
+
+/// \brief Geometric product of a multivector and a scalar in place.
+/// \ingroup ga_ops
+template <class CL, class M, class T> inline
+gaalet::multivector<CL, M, T>&
+operator*=(gaalet::multivector<CL, M, T>& l, const typename gaalet::multivector<CL, M, T>::element_t& s) {
+   l = l*s;
+   return l;
+}
+
 #endif
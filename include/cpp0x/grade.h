@@ -2,31 +2,49 @@
 #define __GAALET_GRADE_H
 
 #include "utility.h"
+#include "materialization.h"
 #include "configuration_list.h"
 
 namespace gaalet {
 
+//elements of bitmap b with grade g
+constexpr conf_t grade_bits(conf_t b, conf_t g) {
+   return b ? (((bit_count(lowest_bit(b))==g) ? (b & (~b+1)) : 0) | grade_bits(b & (b-1), g)) : 0;
+}
+
+//filter by recursion through list
 template<typename list, conf_t grade, bool pass = (BitCount<list::head>::value==grade)>
-struct filter_clist_for_grade
+struct filter_list_for_grade
 {
-   typedef configuration_list<list::head, typename filter_clist_for_grade<typename list::tail, grade>::clist> clist;
+   typedef configuration_list<list::head, typename filter_list_for_grade<typename list::tail, grade>::clist> clist;
 };
 template<typename list, conf_t grade>
-struct filter_clist_for_grade<list, grade, false>
+struct filter_list_for_grade<list, grade, false>
 {
-   typedef typename filter_clist_for_grade<typename list::tail, grade>::clist clist;
+   typedef typename filter_list_for_grade<typename list::tail, grade>::clist clist;
 };
 template<conf_t grade, bool pass>
-struct filter_clist_for_grade<cl_null, grade, pass>
+struct filter_list_for_grade<cl_null, grade, pass>
 {
    typedef cl_null clist;
 };
 template<conf_t grade>
-struct filter_clist_for_grade<cl_null, grade, false>
+struct filter_list_for_grade<cl_null, grade, false>
 {
    typedef cl_null clist;
 };
 
+template<typename list, conf_t grade, bool flat = list::flat>
+struct filter_clist_for_grade
+{
+   typedef typename bitmap_clist<grade_bits(list::bitmap, grade)>::clist clist;
+};
+template<typename list, conf_t grade>
+struct filter_clist_for_grade<list, grade, false>
+{
+   typedef typename filter_list_for_grade<list, grade>::clist clist;
+};
+
 template<conf_t G, class A>
 struct grade : public expression<grade<G, A>>
 {
@@ -36,17 +54,57 @@ struct grade : public expression<grade<G, A>>
 
    typedef typename A::element_t element_t;
 
-   grade(const A& a_)
+   constexpr grade(const A& a_)
       :  a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return (gaalet::search_element<conf, clist>::index!=clist::size) ? a.template element<conf>() : gaalet::null_element<element_t>::value();
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+};
+template<conf_t G, class A>
+struct is_cheap_expression<grade<G, A>>
+{
+   static const bool value = is_cheap_expression<A>::value;
+};
+template<conf_t G, class A, class D, conf_t conf>
+struct alias_source<grade<G, A>, D, conf>
+{
+   static const conf_t value = (search_element<conf, typename grade<G, A>::clist>::index<grade<G, A>::clist::size) ? alias_source<A, D, conf>::value : alias_none;
+};
+template<conf_t G, class A>
+struct has_state<grade<G, A>>
+{
+   static const bool value = has_state<A>::value;
+};
+
+//cost model: elements of grade G read from operand
+template<conf_t G, class A, conf_t conf>
+struct element_cost<grade<G, A>, conf>
+{
+   typedef typename std::conditional<(search_element<conf, typename grade<G, A>::clist>::index!=grade<G, A>::clist::size),
+                                     typename element_cost<A, conf>::type, operations<>>::type type;
+};
+template<conf_t G, class A>
+struct init_cost<grade<G, A>>
+{
+   typedef typename init_cost<A>::type type;
 };
 
 
@@ -58,7 +116,7 @@ protected:
  * \param G Grade of sub-spaces to project onto.
  */
 /// \ingroup ga_ops
-template <gaalet::conf_t G, class A> inline
+template <gaalet::conf_t G, class A> constexpr
 gaalet::grade<G, A>
 grade(const gaalet::expression<A>& a) {
    return gaalet::grade<G, A>(a);
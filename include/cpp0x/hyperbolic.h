@@ -5,6 +5,7 @@
 
 #include "grade.h"
 #include "geometric_product.h"
+#include "element_functions.h"
 
 namespace gaalet {
 
@@ -35,34 +36,33 @@ struct sinh<A, 1> : public expression<sinh<A>>
 
    typedef typename A::element_t element_t;
 
-   //dangerous implementation: constructor only called when expression is defined, not when evaluated
    sinh(const A& a_)
-      :  a(a_),
-         first_eval(true)
+      :  a(a_)
    { }
 
-   //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
    template<conf_t conf>
    element_t element() const {
-      if(first_eval) {
-         element_t alpha_square = eval(grade<0, decltype(a*a)>(a*a));
-         if(alpha_square == 0.0 || alpha_square == -0.0) {
-            sada = 0.0;
-         }
-         else {
-            element_t alpha = sqrt(-alpha_square);
-            sada = sin(alpha)/alpha;
-         }
-         first_eval = false;
-      }
-
       return a.template element<conf>()*sada;
    }
 
+   //scalar factor computed once per evaluation
+   void init() {
+      a.init();
+      element_t alpha_square = self_scalar_product<A, self_product_square>::value(a);
+      sada = sinhc_sqrt(alpha_square);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
-   mutable element_t sada;
-   mutable bool first_eval;
+   typename expression_storage<A>::type a;
+   element_t sada;
 };
 
 //scalar sinh
@@ -81,11 +81,24 @@ struct sinh<A, 0> : public expression<sinh<A>>
 
    template<conf_t conf>
    element_t element() const {
+      using std::sinh;
       return (conf==0) ? sinh(a.template element<conf>()) : 0.0;
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
 };
 
 
@@ -106,21 +119,32 @@ struct cosh<A, 1> : public expression<cosh<A>>
 
    typedef typename A::element_t element_t;
 
-   //dangerous implementation: constructor only called when expression is defined, not when evaluated
    cosh(const A& a_)
       :  a(a_)
    { }
 
-   //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
    template<conf_t conf>
    element_t element() const {
-      element_t alpha_square = eval(grade<0, decltype(a*a)>(a*a));
-      element_t alpha = sqrt(-alpha_square);
-      return (conf==0) ? cos(alpha) : 0.0;
+      return (conf==0) ? ca : 0.0;
+   }
+
+   //scalar computed once per evaluation
+   void init() {
+      a.init();
+      ca = cosh_sqrt(self_scalar_product<A, self_product_square>::value(a));
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
    }
 
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+   element_t ca;
 };
 
 //scalar cosh
@@ -139,15 +163,92 @@ struct cosh<A, 0> : public expression<cosh<A>>
 
    template<conf_t conf>
    element_t element() const {
+      using std::cosh;
       return (conf==0) ? cosh(a.template element<conf>()) : 0.0;
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
 };
 
 
 
+//factors computed by init()
+template<class A>
+struct has_state<sinh<A, 1>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_state<sinh<A, 0>>
+{
+   static const bool value = has_state<A>::value;
+};
+template<class A>
+struct has_state<cosh<A, 1>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_state<cosh<A, 0>>
+{
+   static const bool value = has_state<A>::value;
+};
+
+//cost model: scalar square a*a and factors once per evaluation
+template<class A, conf_t conf>
+struct element_cost<sinh<A, 1>, conf>
+{
+   typedef typename operations_sum<typename element_cost<A, conf>::type, operations<0, 1>>::type type;
+};
+template<class A>
+struct init_cost<sinh<A, 1>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_square>::cost, operations<0, 0, 1, 1, 1>>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<sinh<A, 0>, conf>
+{
+   typedef typename std::conditional<(conf==0), typename operations_sum<typename element_cost<A, conf>::type, operations<0, 0, 0, 0, 1>>::type, operations<>>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<cosh<A, 1>, conf>
+{
+   typedef operations<> type;
+};
+template<class A>
+struct init_cost<cosh<A, 1>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_square>::cost, operations<0, 0, 0, 1, 1>>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<cosh<A, 0>, conf>
+{
+   typedef typename std::conditional<(conf==0), typename operations_sum<typename element_cost<A, conf>::type, operations<0, 0, 0, 0, 1>>::type, operations<>>::type type;
+};
+template<class A, int ET>
+struct init_cost<sinh<A, ET>>
+{
+   typedef typename init_cost<A>::type type;
+};
+template<class A, int ET>
+struct init_cost<cosh<A, ET>>
+{
+   typedef typename init_cost<A>::type type;
+};
+
 }  //end namespace gaalet
 
 /// Hyperbolic sine of a multivector.
@@ -3,6 +3,7 @@
 
 #include "part.h"
 #include "reverse.h"
+#include "geometric_product.h"
 
 namespace gaalet {
 
@@ -46,27 +47,54 @@ struct inverse<A, 1> : public expression<inverse<A>>
    typedef typename A::element_t element_t;
 
    inverse(const A& a_)
-      :  a(a_),
-         first_eval(true)
+      :  a(a_)
    { }
 
    template<conf_t conf>
    element_t element() const {
-      //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
-      if(first_eval) {
-         div = 1.0/((~a)*a).template element<0x00>();
-         first_eval=false;
-      };
       return a.template element<conf>() * div * Power<-1, BitCount<conf>::value*(BitCount<conf>::value-1)/2>::value;
    }
 
+   //scalar factor computed once per evaluation
+   void init() {
+      a.init();
+      div = 1.0/self_scalar_product<A, self_product_reverse>::value(a);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
-   mutable element_t div;
-   mutable bool first_eval;
+   typename expression_storage<A>::type a;
+   element_t div;
 };
 
 
+//factor computed by init()
+template<class A>
+struct has_state<inverse<A, 1>>
+{
+   static const bool value = true;
+};
+
+//cost model: scalar element of (~a)*a and its reciprocal once per evaluation
+template<class A, conf_t conf>
+struct element_cost<inverse<A, 1>, conf>
+{
+   typedef typename operations_sum<typename element_cost<A, conf>::type, operations<0, 1>>::type type;
+};
+template<class A>
+struct init_cost<inverse<A, 1>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_reverse>::cost,
+                                   operations<0, 0, 1>>::type type;
+};
+
 }  //end namespace gaalet
 
 /// Inverse of a multivector.
@@ -7,6 +7,7 @@
 #include "geometric_product.h"
 #include "inverse.h"
 #include "magnitude.h"
+#include "element_functions.h"
 
 namespace gaalet {
 
@@ -52,40 +53,36 @@ struct logarithm<A, 1> : public expression<logarithm<A>>
 
    typedef typename A::element_t element_t;
 
-   //dangerous implementation: constructor only called when expression is defined, not when evaluated
    logarithm(const A& a_)
-      :  a(a_),
-         first_eval(true)
+      :  a(a_)
    { }
 
-   //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
    template<conf_t conf>
    element_t element() const {
-      if(first_eval) {
-         auto b = eval(::grade<2>(a));
-         typedef decltype(b) b_type;
-         element_t b_square = 0.0;
-         for(int bIt = 0; bIt < b_type::size; ++bIt) {
-            b_square += b[bIt]*b[bIt];
-         }
-         inv_mag_b = 1.0/sqrt(b_square);
-         element_t r = a.template element<0>();
-         mag_s = sqrt(r*r+b_square);
-         first_eval = false;
-      }
-
       return conf==0x00 ? log(mag_s) : a.template element<conf>()*inv_mag_b*acos(0);
    }
-   /*template<>
-   element_t element<0>() const {
-      return ca;
-   }*/
+
+   //scalar factors computed once per evaluation
+   void init() {
+      a.init();
+      element_t b_square = self_scalar_product<A, self_product_bivector>::value(a);
+      inv_mag_b = 1.0/sqrt(b_square);
+      element_t r = a.template element<0>();
+      mag_s = sqrt(r*r+b_square);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
 
 protected:
-   const A& a;
-   mutable element_t mag_s;
-   mutable element_t inv_mag_b;
-   mutable bool first_eval;
+   typename expression_storage<A>::type a;
+   element_t mag_s;
+   element_t inv_mag_b;
 };
 
 //scalar logarithm
@@ -107,8 +104,20 @@ struct logarithm<A, 0> : public expression<logarithm<A>>
       return (conf==0) ? log(a.template element<conf>()) : 0.0;
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
 };
 
 //spinor logarithm
@@ -121,44 +130,92 @@ struct logarithm<A, 2> : public expression<logarithm<A>>
 
    typedef typename A::element_t element_t;
 
-   //dangerous implementation: constructor only called when expression is defined, not when evaluated
    logarithm(const A& a_)
-      :  a(a_),
-         first_eval(true)
+      :  a(a_)
    { }
 
-   //review: don't evaluate on definition workaround: will only work if arguments stay the same (thus attention with variables)
    template<conf_t conf>
    element_t element() const {
-      if(first_eval) {
-         //element_t b_square = eval(::magnitude(::grade<2>(a)));
-         auto b = eval(::grade<2>(a));
-         typedef decltype(b) b_type;
-         element_t b_square = 0.0;
-         for(unsigned int bIt = 0; bIt < b_type::size; ++bIt) {
-            b_square += b[bIt]*b[bIt];
-         }
-         element_t r = a.template element<0>();
-         mag_s = sqrt(r*r+b_square);
-         b_acos_r_s = acos(r/mag_s)/sqrt(b_square);
-         first_eval = false;
-      }
-
-      return conf==0x00 ? log(mag_s) : a.template element<conf>()*b_acos_r_s;
+      return conf==0x00 ? log(mag_s) : a.template element<conf>()*angle_mag_b;
+   }
+
+   //scalar factors computed once per evaluation
+   void init() {
+      a.init();
+      element_t b_square = self_scalar_product<A, self_product_bivector>::value(a);
+      element_t r = a.template element<0>();
+      mag_s = sqrt(r*r+b_square);
+      angle_mag_b = atan2_div_sqrt(r, b_square);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
    }
-   /*template<>
-   element_t element<0>() const {
-      return ca;
-   }*/
 
 protected:
-   const A& a;
-   mutable element_t mag_s;
-   mutable element_t b_acos_r_s;
-   mutable bool first_eval;
+   typename expression_storage<A>::type a;
+   element_t mag_s;
+   element_t angle_mag_b;
 };
 
 
+//factors computed by init()
+template<class A>
+struct has_state<logarithm<A, 1>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_state<logarithm<A, 2>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_state<logarithm<A, 0>>
+{
+   static const bool value = has_state<A>::value;
+};
+
+//cost model: squared norm of bivector part and factors once per evaluation
+template<class A, conf_t conf>
+struct element_cost<logarithm<A, 1>, conf>
+{
+   typedef typename std::conditional<(conf==0), operations<0, 0, 0, 0, 0, 1>,
+                                     typename operations_sum<typename element_cost<A, conf>::type, operations<0, 2>>::type>::type type;
+};
+template<class A>
+struct init_cost<logarithm<A, 1>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_bivector>::cost, typename element_cost<A, 0>::type,
+                                   operations<1, 1, 1, 2>>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<logarithm<A, 0>, conf>
+{
+   typedef typename std::conditional<(conf==0), typename operations_sum<typename element_cost<A, conf>::type, operations<0, 0, 0, 0, 0, 1>>::type, operations<>>::type type;
+};
+template<class A>
+struct init_cost<logarithm<A, 0>>
+{
+   typedef typename init_cost<A>::type type;
+};
+template<class A, conf_t conf>
+struct element_cost<logarithm<A, 2>, conf>
+{
+   typedef typename std::conditional<(conf==0), operations<0, 0, 0, 0, 0, 1>,
+                                     typename operations_sum<typename element_cost<A, conf>::type, operations<0, 1>>::type>::type type;
+};
+template<class A>
+struct init_cost<logarithm<A, 2>>
+{
+   typedef typename operations_sum<typename init_cost<A>::type, typename self_scalar_product<A, self_product_bivector>::cost, typename element_cost<A, 0>::type,
+                                   operations<1, 1, 1, 2, 1>>::type type;
+};
+
 }  //end namespace gaalet
 
 /// Logarithm of a multivector.
@@ -22,11 +22,31 @@ struct magnitude : public expression<magnitude<A>>
 
    template<conf_t conf>
    element_t element() const {
-      return (conf==0x00) ? sqrt(eval(::grade<0>((~a)*a))) : 0.0;
+      return (conf==0x00) ? sqrt(self_scalar_product<A, self_product_reverse>::value(a)) : 0.0;
+   }
+
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
    }
 
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+};
+
+//cost model: scalar part of (~a)*a summed from elements of a per element read
+template<class A, conf_t conf>
+struct element_cost<magnitude<A>, conf>
+{
+   typedef typename std::conditional<(conf==0x00), typename operations_sum<typename self_scalar_product<A, self_product_reverse>::cost, operations<0, 0, 0, 1>>::type,
+                                     operations<>>::type type;
 };
 
 }  //end namespace gaalet
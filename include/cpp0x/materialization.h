@@ -0,0 +1,168 @@
+#ifndef __GAALET_MATERIALIZATION_H
+#define __GAALET_MATERIALIZATION_H
+
+#include "multivector.h"
+#include "cost.h"
+
+#include <type_traits>
+
+//global materialization policy:
+//0 - lazy evaluation of all operands (default)
+//1 - automatic materialization of compound operands which are read more than once per evaluation of a product
+#ifndef GAALET_AUTO_MATERIALIZATION
+#define GAALET_AUTO_MATERIALIZATION 0
+#endif
+
+namespace gaalet
+{
+
+template<class A>
+struct materialization : public expression<materialization<A>>
+{
+   typedef typename A::clist clist;
+
+   typedef typename A::metric metric;
+
+   typedef typename A::element_t element_t;
+
+   typedef multivector<clist, metric, element_t> storage_t;
+
+   materialization(const A& a_)
+      :  a(a_)
+   { }
+
+   template<conf_t conf>
+   element_t element() const {
+      return value.template element<conf>();
+   }
+
+   //evaluation of expression into storage, once per evaluation pass
+   void init() {
+      a.init();
+      value.assign_prepared(a);
+   }
+
+   //operand read by init() only
+   constexpr bool aliases(const void*) const {
+      return false;
+   }
+
+   //operand evaluated for bound lane by following init()
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
+   const storage_t& storage() const {
+      return value;
+   }
+
+protected:
+   typename expression_storage<A>::type a;
+   storage_t value;
+};
+
+
+//expressions with cheap element access: reading an element costs a load and possibly a sign flip or scaling
+template<class E>
+struct is_cheap_expression
+{
+   static const bool value = false;
+};
+template<typename CL, typename M, typename T>
+struct is_cheap_expression<multivector<CL, M, T>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct is_cheap_expression<materialization<A>>
+{
+   static const bool value = true;
+};
+
+//storage filled by init()
+template<class A>
+struct has_state<materialization<A>>
+{
+   static const bool value = true;
+};
+
+//cost model: full evaluation of operand by init(), loads
+template<class A, conf_t conf>
+struct element_cost<materialization<A>, conf>
+{
+   typedef operations<> type;
+};
+template<class A>
+struct init_cost<materialization<A>>
+{
+   typedef typename operations_sum<expression_cost<A>>::type type;
+};
+
+//expressions with elements accessible by storage index (get<index>()), e.g. multivector storage
+template<class E>
+struct has_storage
+{
+   static const bool value = false;
+};
+template<typename CL, typename M, typename T>
+struct has_storage<multivector<CL, M, T>>
+{
+   static const bool value = true;
+};
+template<class A>
+struct has_storage<materialization<A>>
+{
+   static const bool value = true;
+};
+
+template<typename CL, typename M, typename T> inline
+const multivector<CL, M, T>& storage_of(const multivector<CL, M, T>& m) {
+   return m;
+}
+template<class A> inline
+const typename materialization<A>::storage_t& storage_of(const materialization<A>& m) {
+   return m.storage();
+}
+
+//number of element multiplications in a multiplication element list (gp, ip and op melists share this layout)
+template<typename list, bool empty = (list::size==0)>
+struct multiplication_count
+{
+   static const conf_t value = list::head::size + multiplication_count<typename list::tail>::value;
+};
+template<typename list>
+struct multiplication_count<list, true>
+{
+   static const conf_t value = 0;
+};
+
+//operand storage of product expressions
+// --- operand elements are read once per element multiplication, thus more than once per evaluation if there are more multiplications than operand elements
+template<class E, typename melist, bool materialize = (GAALET_AUTO_MATERIALIZATION && !is_cheap_expression<E>::value
+                                                      && (multiplication_count<melist>::value > E::clist::size))>
+struct operand_storage
+{
+   typedef typename expression_storage<E>::type type;
+};
+template<class E, typename melist>
+struct operand_storage<E, melist, true>
+{
+   typedef materialization<E> type;
+};
+
+} //end namespace gaalet
+
+
+/// Materialization of a multivector expression.
+/**
+ * The expression is evaluated once into a multivector temporary, which is read by the enclosing expression instead of evaluating the expression again for every element access.
+ * Automatic materialization of product operands is enabled by defining GAALET_AUTO_MATERIALIZATION to 1 before including gaalet.h.
+ */
+/// \ingroup ga_ops
+template <class A> inline
+gaalet::materialization<A>
+materialize(const gaalet::expression<A>& a) {
+   return gaalet::materialization<A>(a);
+}
+
+#endif
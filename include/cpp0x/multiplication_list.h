@@ -0,0 +1,192 @@
+#ifndef __GAALET_MULTIPLICATION_LIST_H
+#define __GAALET_MULTIPLICATION_LIST_H
+
+#include "configuration_list.h"
+#include "product_table.h"
+
+#include <type_traits>
+
+namespace gaalet
+{
+
+//construction of multiplication element lists (layout shared by gp, ip and op) from configuration bitmaps of flat operand lists
+//product policy P:
+// --- P::contributes(l, r): element multiplication l*r is part of the product
+// --- P::sign(l, r): sign of element multiplication l*r (canonical reordering and metric)
+// --- P::recursive_list<LCL, RCL>::melist, P::search_list<C, melist>::list: construction and search by recursion through lists (operands not flat)
+// flat operands: one sum list type per result element and one element list type per remaining result bitmap, terms of a sum list expanded
+// from its bitmap of right elements, no type per element multiplication
+
+//result bitmap of element multiplications of left element l with right elements of bitmap r
+template<class P>
+constexpr conf_t product_row_bits(conf_t l, conf_t r) {
+   return r ? ((P::contributes(l, lowest_bit(r)) ? (conf_t(1)<<(l^lowest_bit(r))) : 0) | product_row_bits<P>(l, r & (r-1))) : 0;
+}
+
+//result bitmap of element multiplications of left elements of bitmap l with right elements of bitmap r
+template<class P>
+constexpr conf_t product_bits(conf_t l, conf_t r) {
+   return l ? (product_row_bits<P>(lowest_bit(l), r) | product_bits<P>(l & (l-1), r)) : 0;
+}
+
+//right elements of bitmap r multiplied with left elements of bitmap l into result element c
+template<class P>
+constexpr conf_t product_sum_bits(conf_t c, conf_t l, conf_t r) {
+   return r ? (((bit_test(l, c ^ lowest_bit(r)) && P::contributes(c ^ lowest_bit(r), lowest_bit(r))) ? (conf_t(1)<<lowest_bit(r)) : 0)
+               | product_sum_bits<P>(c, l, r & (r-1))) : 0;
+}
+
+//number of element multiplications of result elements of bitmap c
+template<class P>
+constexpr conf_t product_term_count(conf_t c, conf_t l, conf_t r) {
+   return c ? bit_count(product_sum_bits<P>(lowest_bit(c), l, r)) + product_term_count<P>(c & (c-1), l, r) : 0;
+}
+
+//sum of terms, nested as by recursive sum lists: t0 + (t1 + (... + tn))
+template<typename element_t> constexpr
+element_t term_sum() {
+   return 0.0;
+}
+template<typename element_t, typename T> constexpr
+element_t term_sum(const T& t) {
+   return t;
+}
+template<typename element_t, typename T, typename... TT> constexpr
+element_t term_sum(const T& t, const TT&... tt) {
+   return t + term_sum<element_t>(tt...);
+}
+
+//element multiplications with result element C and right elements RB (product_sum_bits), in ascending order of right element
+//(summation order of recursive construction), expanded from the bitmap in one pass
+template<class P, conf_t C, conf_t RB>
+struct flat_sum_list
+{
+   static const conf_t conf = C;
+   static const conf_t bitmap = RB;
+   static const conf_t size = bit_count(RB);
+
+   typedef typename make_index_list<size>::type terms;
+
+   //operand elements read by configuration
+   template<typename element_t, class L, class R>
+   static constexpr element_t product_sum(const L& l, const R& r) {
+      return conf_sum<element_t>(l, r, terms());
+   }
+
+   //operand elements read by storage index in flat configuration lists LCL and RCL
+   template<typename element_t, typename LCL, typename RCL, class L, class R>
+   static element_t indexed_sum(const L& l, const R& r) {
+      return index_sum<element_t, LCL, RCL>(l, r, terms());
+   }
+
+protected:
+   template<typename element_t, class L, class R, conf_t... I>
+   static constexpr element_t conf_sum(const L& l, const R& r, index_list<I...>) {
+      return term_sum<element_t>(l.template element<(select_bit(RB, I)^C)>()*r.template element<select_bit(RB, I)>()
+                                 *std::integral_constant<int, P::sign(select_bit(RB, I)^C, select_bit(RB, I))>::value...);
+   }
+
+   template<typename element_t, typename LCL, typename RCL, class L, class R, conf_t... I>
+   static element_t index_sum(const L& l, const R& r, index_list<I...>) {
+      return term_sum<element_t>(l.template get<bit_rank(LCL::bitmap, select_bit(RB, I)^C)>()*r.template get<bit_rank(RCL::bitmap, select_bit(RB, I))>()
+                                 *std::integral_constant<int, P::sign(select_bit(RB, I)^C, select_bit(RB, I))>::value...);
+   }
+};
+
+//multiplication element list of result elements CB, ascending: head and tail computed from the bitmaps on access
+template<class P, conf_t CB, conf_t LB, conf_t RB>
+struct flat_element_list
+{
+   static const conf_t conf = CB ? lowest_bit(CB) : 0;
+   typedef flat_sum_list<P, conf, product_sum_bits<P>(conf, LB, RB)> head;
+   typedef flat_element_list<P, (CB & (CB-1)), LB, RB> tail;
+
+   typedef configuration_bitmap<CB> clist;
+
+   static const conf_t size = bit_count(CB);
+   //number of element multiplications
+   static const conf_t terms = product_term_count<P>(CB, LB, RB);
+
+   template<typename element_t, class L, class R>
+   static constexpr element_t product_sum(const L& l, const R& r)
+   {
+      return head::template product_sum<element_t>(l, r);
+   }
+};
+
+//multiplication element list of product of operands with configuration lists LCL and RCL
+template<class P, typename LCL, typename RCL, bool flat = (LCL::flat && RCL::flat)>
+struct build_product_melist
+{
+   typedef flat_element_list<P, product_bits<P>(LCL::bitmap, RCL::bitmap), LCL::bitmap, RCL::bitmap> melist;
+};
+template<class P, typename LCL, typename RCL>
+struct build_product_melist<P, LCL, RCL, false>
+{
+   typedef typename P::template recursive_list<LCL, RCL>::melist melist;
+};
+
+//element multiplications with result element C: multiplication_sum_list (flat operands) or multiplication_element_list entry, both providing product_sum()
+template<class P, conf_t C, typename LCL, typename RCL, typename melist, bool flat = (LCL::flat && RCL::flat)>
+struct product_sum_list
+{
+   typedef flat_sum_list<P, C, product_sum_bits<P>(C, LCL::bitmap, RCL::bitmap)> list;
+};
+template<class P, conf_t C, typename LCL, typename RCL, typename melist>
+struct product_sum_list<P, C, LCL, RCL, melist, false>
+{
+   typedef typename P::template search_list<C, melist>::list list;
+};
+
+//table entry k of flat product: rows of result elements c ascending (row index row), element multiplications of a row in descending
+//order of right element (summation order of product_sum())
+template<class P>
+constexpr product_table_entry flat_row_entry(conf_t c, conf_t row, conf_t l, conf_t r, conf_t terms, conf_t k) {
+   return product_table_entry{c, row, bit_rank(l, select_bit(terms, bit_count(terms)-1-k)^c), bit_rank(r, select_bit(terms, bit_count(terms)-1-k)),
+                              P::sign(select_bit(terms, bit_count(terms)-1-k)^c, select_bit(terms, bit_count(terms)-1-k)), k==0};
+}
+template<class P>
+constexpr product_table_entry flat_table_entry(conf_t c, conf_t row, conf_t l, conf_t r, conf_t k) {
+   return (k < bit_count(product_sum_bits<P>(lowest_bit(c), l, r))) ? flat_row_entry<P>(lowest_bit(c), row, l, r, product_sum_bits<P>(lowest_bit(c), l, r), k)
+                                                                    : flat_table_entry<P>(c & (c-1), row+1, l, r, k - bit_count(product_sum_bits<P>(lowest_bit(c), l, r)));
+}
+
+template<class P, conf_t CB, conf_t LB, conf_t RB>
+struct flat_table_entries
+{
+   constexpr product_table_entry operator[](conf_t k) const {
+      return flat_table_entry<P>(CB, 0, LB, RB, k);
+   }
+};
+
+//table-driven evaluation of flat products: one straight-line sum per result row, expanded from the bitmaps
+template<class P, conf_t CB, conf_t LB, conf_t RB, typename metric, typename LCL, typename RCL>
+struct product_table<flat_element_list<P, CB, LB, RB>, metric, LCL, RCL>
+{
+   static const conf_t size = flat_element_list<P, CB, LB, RB>::terms;
+
+   static constexpr flat_table_entries<P, CB, LB, RB> entries = {};
+
+   //evaluation of product into multivector storage of configuration DCL, operands indexed by storage index
+   template<typename DCL, typename element_t, typename D, class L, class R>
+   static void evaluate(D& data, const L& l, const R& r) {
+      std::array<element_t, bit_count(CB)> acc;
+      evaluate_rows<element_t>(acc, l, r, typename make_index_list<bit_count(CB)>::type());
+      product_table_null_elements<DCL, configuration_bitmap<CB>>::template apply<element_t>(data);
+      product_table_store<DCL, configuration_bitmap<CB>, typename make_index_list<bit_count(CB)>::type>::apply(data, acc);
+   }
+
+protected:
+   template<typename element_t, typename A, class L, class R, conf_t... I>
+   static void evaluate_rows(A& acc, const L& l, const R& r, index_list<I...>) {
+      typedef int swallow[];
+      (void)swallow{0, (std::get<I>(acc) = flat_sum_list<P, select_bit(CB, I), product_sum_bits<P>(select_bit(CB, I), LB, RB)>
+                                              ::template indexed_sum<element_t, LCL, RCL>(l, r), 0)...};
+   }
+};
+template<class P, conf_t CB, conf_t LB, conf_t RB, typename metric, typename LCL, typename RCL>
+constexpr flat_table_entries<P, CB, LB, RB> product_table<flat_element_list<P, CB, LB, RB>, metric, LCL, RCL>::entries;
+
+} //end namespace gaalet
+
+#endif
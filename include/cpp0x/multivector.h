@@ -7,11 +7,26 @@
 
 #include <algorithm>
 #include <array>
+#include <type_traits>
 
 
 namespace gaalet
 {
 
+//dedicated evaluation kernels: specialized by expressions which evaluate into multivector storage at once
+template<class E>
+struct evaluation_kernel
+{
+   static const bool value = false;
+};
+
+//expressions with elements carried in the type (no storage): expressions of identical type have identical elements
+template<class A>
+struct has_constant_elements
+{
+   static const bool value = false;
+};
+
 //multivector struct
 //template<typename CL, typename SL=sl::sl_null>
 //struct multivector : public expression<multivector<CL, SL>>
@@ -23,50 +38,46 @@ struct multivector : public expression<multivector<CL, M, T>>
    
    typedef M metric;
    
-   typedef T element_t;
+   //elements computed in element_t, stored in storage_t (equal unless T is a precision policy)
+   typedef typename element_precision<T>::element_t element_t;
+   typedef typename element_precision<T>::storage_t storage_t;
+
+   //element read by storage index: reference to storage, or value converted to element_t
+   typedef typename std::conditional<std::is_same<storage_t, element_t>::value, const element_t&, element_t>::type element_read_t;
 
    //initialization
-   multivector()
-   {
-      //std::fill(data, data+size, 0.0);
-      //std::fill(data.begin(), data.end(), null_element);
-      for(unsigned int i=0; i<size; ++i) data[i] = null_element<element_t>::value();
-   }
+   constexpr multivector()
+      :  data(null_data(typename make_index_list<size>::type()))
+   { }
 
-   multivector(std::initializer_list<element_t> s)
-   {
-      //element_t* last = std::copy(s.begin(), (s.size()<=size) ? s.end() : (s.begin()+size), data);
-      typename std::array<element_t, size>::iterator last = std::copy(s.begin(), (s.size()<=size) ? s.end() : (s.begin()+size), data.begin());
-      //std::fill(last, data+size, 0.0);
-      //std::fill(last, data.end(), null_element);
-      for(typename std::array<element_t, size>::iterator it = last; it!=data.end(); ++it) (*it) = null_element<element_t>::value();
-   }
+   constexpr multivector(std::initializer_list<element_t> s)
+      :  data(list_data(s, typename make_index_list<size>::type()))
+   { }
 
    //return element by index, index known at runtime
-   const element_t& operator[](const conf_t& index) const {
+   constexpr const storage_t& operator[](const conf_t& index) const {
       return data[index];
    }
-   element_t& operator[](const conf_t& index) {
+   storage_t& operator[](const conf_t& index) {
       return data[index];
    }
 
    //return element by index, index known at compile time
    template<conf_t index>
-   const element_t& get() const {
+   constexpr element_read_t get() const {
       return data[index];
    }
    template<conf_t index>
-   element_t& get() {
+   storage_t& get() {
       return data[index];
    }
 
    //return element by configuration (basis vector), configuration known at compile time
    template<conf_t conf>
    ////reference return (const element_t& element() const) not applicable because of possible return of 0.0;
-   element_t element() const {
-      static const conf_t index = search_element<conf, clist>::index;
+   constexpr element_t element() const {
       //static_assert(index<size, "element<conf_t>(): no such element in configuration list");
-      return (index<size) ? data[index] : null_element<element_t>::value();
+      return (search_element<conf, clist>::index<size) ? element_t(data[search_element<conf, clist>::index]) : null_element<element_t>::value();
    }
 
    //evaluation
@@ -92,13 +103,81 @@ struct multivector : public expression<multivector<CL, M, T>>
          std::get<size-1>(data) = e.template element<get_element<size-1, clist>::value>();
       }
    };
+   template<typename E>
+   struct ElementEvaluation<E, 0>
+   {
+      static void eval(std::array<element_t, size>&, const E&) { }
+   };
+
+   template<typename E, bool kernel = evaluation_kernel<E>::value>
+   struct Evaluation
+   {
+      static void eval(std::array<element_t, size>& data, const E& e) {
+         ElementEvaluation<E>::eval(data, e);
+      }
+   };
+   template<typename E>
+   struct Evaluation<E, true>
+   {
+      static void eval(std::array<element_t, size>& data, const E& e) {
+         e.template evaluate<clist, element_t>(data);
+      }
+   };
+
+   //evaluation into storage: directly, or into temporary of element_t rounded once to storage_t
+   template<typename E, bool direct = std::is_same<storage_t, element_t>::value>
+   struct Storing
+   {
+      static void eval(std::array<storage_t, size>& data, const E& e) {
+         Evaluation<E>::eval(data, e);
+      }
+   };
+   template<typename E>
+   struct Storing<E, false>
+   {
+      static void eval(std::array<storage_t, size>& data, const E& e) {
+         std::array<element_t, size> temp_data;
+         Evaluation<E>::eval(temp_data, e);
+         std::copy(temp_data.begin(), temp_data.end(), data.begin());
+      }
+   };
+
+   //   constructor evaluation: expressions without state element-wise (usable in constant expressions), expressions with evaluation
+   //   kernel by kernel (unless of constant elements, folded element-wise), others on a prepared copy
+   template<typename E, int strategy = has_state<E>::value ? 2 : (evaluation_kernel<E>::value && !has_constant_elements<E>::value) ? 1 : 0>
+   struct Construction
+   {
+      template<conf_t... I>
+      static constexpr std::array<storage_t, size> eval(const E& e, index_list<I...>) {
+         return std::array<storage_t, size>{{ storage_t(e.template element<get_element<I, clist>::value>())... }};
+      }
+   };
+   template<typename E>
+   struct Construction<E, 1>
+   {
+      template<conf_t... I>
+      static std::array<storage_t, size> eval(const E& e, index_list<I...>) {
+         std::array<storage_t, size> data;
+         Storing<E>::eval(data, e);
+         return data;
+      }
+   };
+   template<typename E>
+   struct Construction<E, 2>
+   {
+      template<conf_t... I>
+      static std::array<storage_t, size> eval(const E& e_, index_list<I...>) {
+         std::array<storage_t, size> data;
+         const E e(prepare(e_));
+         Storing<E>::eval(data, e);
+         return data;
+      }
+   };
 
-   //   constructor evaluation
    template<class E>
-   multivector(const expression<E>& e_) {
-      const E& e(e_);
-      ElementEvaluation<E>::eval(data, e);
-   }
+   constexpr multivector(const expression<E>& e_)
+      :  data(Construction<E>::eval(e_, typename make_index_list<size>::type()))
+   { }
 
    //copy --- seems slower with global eval function (overrides rvalue reference assignment operator?)
    /*void operator=(const multivector& mv)
@@ -106,37 +185,140 @@ struct multivector : public expression<multivector<CL, M, T>>
       std::copy(mv.data, mv.data+size, data);
    }*/
 
-   //assignment evaluation
+   //aliasing of this multivector by expression E, elements evaluated in order of the configuration list:
+   //   in_place: every element reads no element of this multivector, or only one not written yet
+   //   buffered: number of elements reading one element of this multivector already written
+   //   several: some element reads several or unknown elements of this multivector
+   template<typename E, conf_t index = 0, bool end = (index==size)>
+   struct Aliasing
+   {
+      static const conf_t source = alias_source<E, multivector, get_element<index, clist>::value>::value;
+      static const bool safe = (source==alias_none) || (source!=alias_several && search_element<source, clist>::index>=index);
+
+      static const bool in_place = safe && Aliasing<E, index+1>::in_place;
+      static const conf_t buffered = (safe ? 0 : 1) + Aliasing<E, index+1>::buffered;
+      static const bool several = (source==alias_several) || Aliasing<E, index+1>::several;
+   };
+   template<typename E, conf_t index>
+   struct Aliasing<E, index, true>
+   {
+      static const bool in_place = true;
+      static const conf_t buffered = 0;
+      static const bool several = false;
+   };
+
+   //   elements read after being written evaluated into buffer first, all others in place
+   template<typename E, conf_t index = 0, conf_t slot = 0, bool end = (index==size)>
+   struct BufferedEvaluation
+   {
+      static const bool safe = Aliasing<E, index>::safe;
+      typedef BufferedEvaluation<E, index+1, slot + (safe ? 0 : 1)> next;
+
+      template<typename B>
+      static void buffer(B& b, const E& e) {
+         if(!safe) std::get<(safe ? 0 : slot)>(b) = e.template element<get_element<index, clist>::value>();
+         next::buffer(b, e);
+      }
+      template<typename B>
+      static void store(std::array<storage_t, size>& data, const B& b, const E& e) {
+         std::get<index>(data) = safe ? e.template element<get_element<index, clist>::value>() : std::get<(safe ? 0 : slot)>(b);
+         next::store(data, b, e);
+      }
+   };
+   template<typename E, conf_t index, conf_t slot>
+   struct BufferedEvaluation<E, index, slot, true>
+   {
+      template<typename B>
+      static void buffer(B&, const E&) { }
+      template<typename B>
+      static void store(std::array<storage_t, size>&, const B&, const E&) { }
+   };
+
+   //   strategy of assignment: in place if safe by type, else by addresses of operands: in place, buffered or temporary
+   //   (evaluation kernels and mixed precision: in place if no operand aliases, temporary otherwise)
+   template<typename E, bool direct = std::is_same<storage_t, element_t>::value,
+            bool elementwise = !evaluation_kernel<E>::value && !Aliasing<E>::several>
+   struct Assignment
+   {
+      static void eval(std::array<storage_t, size>& data, const E& e, const void* self) {
+         if(Aliasing<E>::in_place || !e.aliases(self)) {
+            Evaluation<E>::eval(data, e);
+         }
+         else {
+            std::array<element_t, (Aliasing<E>::buffered ? Aliasing<E>::buffered : 1)> b;
+            BufferedEvaluation<E>::buffer(b, e);
+            BufferedEvaluation<E>::store(data, b, e);
+         }
+      }
+   };
+   template<typename E>
+   struct Assignment<E, true, false>
+   {
+      static void eval(std::array<storage_t, size>& data, const E& e, const void* self) {
+         if((Aliasing<E>::in_place && !evaluation_kernel<E>::value) || !e.aliases(self)) {
+            Evaluation<E>::eval(data, e);
+         }
+         else {
+            std::array<element_t, size> temp_data;
+            Evaluation<E>::eval(temp_data, e);
+            data = temp_data;
+         }
+      }
+   };
+   template<typename E, bool elementwise>
+   struct Assignment<E, false, elementwise>
+   {
+      static void eval(std::array<storage_t, size>& data, const E& e, const void*) {
+         Storing<E>::eval(data, e);
+      }
+   };
+
+   //assignment evaluation: expression may read this multivector (a = b*a*!b), strategy by Assignment
    template<class E>
    void operator=(const expression<E>& e_) {
-      //const E& e(e_);
-      //ElementEvaluation<E>::eval(data, e);
-      //multivector mv(e_);
-      //*this = std::move(mv);
-      *this = multivector(e_);
-      //data = std::move(mv.data);
-      //std::copy(mv.data, mv.data+size, data);
-
-      //element_t temp_data[size];
-      //std::copy(temp_data, temp_data+size, data);
-      //
-      //std::array<element_t, size> temp_data;
-      //ElementEvaluation<E>::eval(temp_data, e);
-      //std::copy(temp_data.begin(), temp_data.end(), data.begin());
-      //data = std::move(temp_data);
+      const E e(prepare(e_));
+      Assignment<E>::eval(data, e, this);
    }
 
    //assignment without temporary
    template<class E>
    void assign(const expression<E>& e_) {
-      const E& e(e_);
-      ElementEvaluation<E>::eval(data, e);
+      const E e(prepare(e_));
+      Storing<E>::eval(data, e);
+   }
+
+   //assignment of expression already prepared by init()
+   template<class E>
+   void assign_prepared(const E& e) {
+      Storing<E>::eval(data, e);
    }
 
+   //multivector: nothing to prepare
+   void init() const { }
+
+   //operand stored by reference: aliasing of destination at address d
+   constexpr bool aliases(const void* d) const {
+      return this==d;
+   }
 
 protected:
+   template<conf_t index>
+   static constexpr storage_t null_data_element() {
+      return null_element<storage_t>::value();
+   }
+   template<conf_t... I>
+   static constexpr std::array<storage_t, size> null_data(index_list<I...>) {
+      return std::array<storage_t, size>{{ null_data_element<I>()... }};
+   }
+
+   //elements missing in initializer list are null elements, surplus ones are ignored
+   template<conf_t... I>
+   static constexpr std::array<storage_t, size> list_data(std::initializer_list<element_t> s, index_list<I...>) {
+      return std::array<storage_t, size>{{ storage_t((I<s.size()) ? s.begin()[I] : null_element<element_t>::value())... }};
+   }
+
    //element_t data[size];
-   std::array<element_t, size> data;
+   std::array<storage_t, size> data;
 };
 
 //specialization for scalar multivector type
@@ -148,18 +330,21 @@ struct multivector<configuration_list<0x00, cl_null>, M, T> : public expression<
    
    typedef M metric;
 
-   typedef T element_t;
+   typedef typename element_precision<T>::element_t element_t;
+   typedef typename element_precision<T>::storage_t storage_t;
+
+   typedef typename std::conditional<std::is_same<storage_t, element_t>::value, const element_t&, element_t>::type element_read_t;
 
    //initialization
-   multivector()
-      :  value(null_element<element_t>::value())
+   constexpr multivector()
+      :  value(null_element<storage_t>::value())
    { }
 
-   multivector(const element_t& setValue)
+   constexpr multivector(const element_t& setValue)
       :  value(setValue)
    { }
 
-   multivector(std::initializer_list<element_t> s)
+   constexpr multivector(std::initializer_list<element_t> s)
       :  value(*s.begin())
    { }
 
@@ -169,50 +354,97 @@ struct multivector<configuration_list<0x00, cl_null>, M, T> : public expression<
    }
 
    //return element by index, index known at runtime
-   const element_t& operator[](const conf_t&) const {
+   constexpr const storage_t& operator[](const conf_t&) const {
       return value;
    }
-   element_t& operator[](const conf_t& index) {
+   storage_t& operator[](const conf_t& index) {
       return value;
    }
 
    //return element by index, index known at compile time
    template<conf_t index>
-   const element_t& get() const {
+   constexpr element_read_t get() const {
       return value;
    }
 
    //return element by configuration (basis vector), configuration known at compile time
    template<conf_t conf>
    ////reference return (const element_t& element() const) not applicable because of possible return of 0.0;
-   element_t element() const {
+   constexpr element_t element() const {
       //static const conf_t index = search_element<conf, clist>::index;
       //static_assert(index<size, "element<conf_t>(): no such element in configuration list");
-      return (conf==0x00) ? value : null_element<element_t>::value();
+      return (conf==0x00) ? element_t(value) : null_element<element_t>::value();
    }
 
-   //   constructor evaluation
+   //   constructor evaluation: expressions without state element-wise (usable in constant expressions), others on a prepared copy
+   template<typename E, bool state = has_state<E>::value>
+   struct Construction
+   {
+      static constexpr element_t eval(const E& e) {
+         return e.template element<0x00>();
+      }
+   };
+   template<typename E>
+   struct Construction<E, true>
+   {
+      static element_t eval(const E& e) {
+         return prepare(e).template element<0x00>();
+      }
+   };
+
    template<class E>
-   multivector(const expression<E>& e_) {
-      const E& e(e_);
-      value = e.template element<0x00>();
-   }
+   constexpr multivector(const expression<E>& e_)
+      :  value(Construction<E>::eval(e_))
+   { }
 
    //   assignment evaluation
    template<class E>
    void operator=(const expression<E>& e_) {
-      const E& e(e_);
+      value = prepare(e_).template element<0x00>();
+   }
+
+   //assignment without temporary
+   template<class E>
+   void assign(const expression<E>& e_) {
+      value = prepare(e_).template element<0x00>();
+   }
+
+   //assignment of expression already prepared by init()
+   template<class E>
+   void assign_prepared(const E& e) {
       value = e.template element<0x00>();
    }
 
+   //multivector: nothing to prepare
+   void init() const { }
+
+   //operand stored by reference: aliasing of destination at address d
+   constexpr bool aliases(const void* d) const {
+      return this==d;
+   }
+
 protected:
-   element_t value;
+   storage_t value;
 };
 
 
+//multivector operands are stored by reference
+template<typename CL, typename M, typename T>
+struct expression_storage<multivector<CL, M, T>>
+{
+   typedef const multivector<CL, M, T>& type;
+};
+
+//multivector operand read by destination of same type: same element only
+template<typename CL, typename M, typename T, class D, conf_t conf>
+struct alias_source<multivector<CL, M, T>, D, conf>
+{
+   static const conf_t value = (std::is_same<multivector<CL, M, T>, D>::value && search_element<conf, CL>::index<CL::size) ? conf : alias_none;
+};
+
 } //end namespace gaalet
 
-template<class A> inline
+template<class A> constexpr
 gaalet::multivector<typename A::clist, typename A::metric, typename A::element_t>
 eval(const gaalet::expression<A>& a) {
    return gaalet::multivector<typename A::clist, typename A::metric, typename A::element_t>(a);
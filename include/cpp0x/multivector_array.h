@@ -0,0 +1,304 @@
+#ifndef __GAALET_MULTIVECTOR_ARRAY_H
+#define __GAALET_MULTIVECTOR_ARRAY_H
+
+#include "multivector.h"
+#include "cost.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//alignment of blade arrays in bytes
+#ifndef GAALET_ARRAY_ALIGNMENT
+#define GAALET_ARRAY_ALIGNMENT 64
+#endif
+
+//number of lanes evaluated per block by assignment (block temporary: clist::size*GAALET_ARRAY_BLOCK elements on the stack)
+#ifndef GAALET_ARRAY_BLOCK
+#define GAALET_ARRAY_BLOCK 128
+#endif
+
+namespace gaalet
+{
+
+//view of a structure-of-arrays batch of multivectors: one contiguous array per element of the configuration list
+template<typename CL, typename M, typename T>
+struct multivector_array_view : public expression<multivector_array_view<CL, M, T>>
+{
+   typedef CL clist;
+   static const conf_t size = clist::size;
+
+   typedef M metric;
+
+   //elements computed in element_t, stored in storage_t (equal unless T is a precision policy)
+   typedef typename element_precision<T>::element_t element_t;
+   typedef typename element_precision<T>::storage_t storage_t;
+
+   typedef multivector<clist, metric, T> value_t;
+
+   multivector_array_view()
+      :  blades(), lanes(0), lane(0)
+   { }
+
+   multivector_array_view(const std::array<storage_t*, size>& blades_, std::size_t lanes_)
+      :  blades(blades_), lanes(lanes_), lane(0)
+   { }
+
+   //number of multivectors
+   std::size_t length() const {
+      return lanes;
+   }
+
+   //array of element by index, index known at runtime
+   storage_t* blade(const conf_t& index) const {
+      return blades[index];
+   }
+
+   //array of element by index, index known at compile time
+   template<conf_t index>
+   storage_t* get() const {
+      return std::get<index>(blades);
+   }
+
+   //element of bound lane by configuration, configuration known at compile time
+   template<conf_t conf>
+   element_t element() const {
+      return (search_element<conf, clist>::index<size) ? element_t(blades[search_element<conf, clist>::index][lane]) : null_element<element_t>::value();
+   }
+
+   //multivector of lane i (gathered)
+   value_t operator[](std::size_t i) const {
+      value_t m;
+      for(conf_t index = 0; index < size; ++index) {
+         m[index] = blades[index][i];
+      }
+      return m;
+   }
+
+   //evaluation of expression into lane i (scattered)
+   template<class E>
+   void set(std::size_t i, const expression<E>& e_) {
+      const value_t m(e_);
+      for(conf_t index = 0; index < size; ++index) {
+         blades[index][i] = m[index];
+      }
+   }
+
+   //view of lanes [begin, begin+n)
+   multivector_array_view view(std::size_t begin, std::size_t n) const {
+      std::array<storage_t*, size> sub_blades;
+      for(conf_t index = 0; index < size; ++index) {
+         sub_blades[index] = blades[index] + begin;
+      }
+      return multivector_array_view(sub_blades, n);
+   }
+
+   //lane bound to private copy of expression tree: batch operands of the copy read lane l
+   void bind_lane(std::size_t l) {
+      lane = l;
+   }
+
+   //evaluation of lanes [begin, begin+n) into data[index][0, n), data of element_t (temporaries) or storage_t (blades)
+   //   expressions without state: blade loop outside, lane loop inside
+   template<typename E, conf_t index = 0, bool end = (index==size)>
+   struct BladeEvaluation
+   {
+      template<typename U>
+      static void eval(U* const* data, std::size_t begin, std::size_t n, E& e) {
+         U* const out = data[index];
+         for(std::size_t i = 0; i < n; ++i) {
+            e.bind_lane(begin + i);
+            out[i] = e.template element<get_element<index, clist>::value>();
+         }
+         BladeEvaluation<E, index+1>::eval(data, begin, n, e);
+      }
+   };
+   template<typename E, conf_t index>
+   struct BladeEvaluation<E, index, true>
+   {
+      template<typename U>
+      static void eval(U* const*, std::size_t, std::size_t, E&) { }
+   };
+
+   //   expressions with state: state computed by init() may depend on lane, thus prepared once per lane
+   template<typename E, bool state = has_state<E>::value>
+   struct Evaluation
+   {
+      template<typename U>
+      static void eval(U* const* data, std::size_t begin, std::size_t n, const E& e_) {
+         E e(e_);
+         BladeEvaluation<E>::eval(data, begin, n, e);
+      }
+   };
+   template<typename E>
+   struct Evaluation<E, true>
+   {
+      template<typename U>
+      static void eval(U* const* data, std::size_t begin, std::size_t n, const E& e_) {
+         std::array<element_t, size> lane_data;
+         E l(e_);
+         for(std::size_t i = 0; i < n; ++i) {
+            l.bind_lane(begin + i);
+            const E e(prepare(l));
+            multivector<clist, metric, element_t>::template Evaluation<E>::eval(lane_data, e);
+            for(conf_t index = 0; index < size; ++index) {
+               data[index][i] = lane_data[index];
+            }
+         }
+      }
+   };
+
+   //assignment evaluation: blocks of lanes evaluated into temporary, expression may read lanes of this array
+   template<class E>
+   void operator=(const expression<E>& e) {
+      assign_lanes(0, lanes, e);
+   }
+
+   //assignment evaluation of lanes [begin, begin+n) only (e.g. one chunk of a parallel evaluation)
+   template<class E>
+   void assign_lanes(std::size_t begin, std::size_t n, const expression<E>& e_) {
+      const E& e(e_);
+      element_t temp_data[size][GAALET_ARRAY_BLOCK];
+      element_t* temp[size];
+      for(conf_t index = 0; index < size; ++index) {
+         temp[index] = temp_data[index];
+      }
+
+      for(std::size_t block = begin; block < begin+n; block += GAALET_ARRAY_BLOCK) {
+         const std::size_t m = std::min<std::size_t>(GAALET_ARRAY_BLOCK, begin+n-block);
+         Evaluation<E>::eval(temp, block, m, e);
+         for(conf_t index = 0; index < size; ++index) {
+            std::copy(temp[index], temp[index]+m, blades[index]+block);
+         }
+      }
+   }
+
+   //assignment without temporary, expression must not read this array
+   template<class E>
+   void assign(const expression<E>& e_) {
+      const E& e(e_);
+      Evaluation<E>::eval(blades.data(), 0, lanes, e);
+   }
+
+   //assignment of multivector to all lanes
+   void fill(const value_t& m) {
+      for(conf_t index = 0; index < size; ++index) {
+         std::fill(blades[index], blades[index]+lanes, m[index]);
+      }
+   }
+
+   //batch operand: nothing to prepare
+   void init() const { }
+
+   //blade arrays never alias multivector storage
+   constexpr bool aliases(const void*) const {
+      return false;
+   }
+
+protected:
+   std::array<storage_t*, size> blades;
+   std::size_t lanes;
+   //lane read by element(), bound per lane on private copies of expression trees
+   std::size_t lane;
+};
+
+//structure-of-arrays batch of multivectors owning its storage, blade arrays aligned to GAALET_ARRAY_ALIGNMENT
+template<typename CL, typename M, typename T>
+struct multivector_array : public multivector_array_view<CL, M, T>
+{
+   typedef multivector_array_view<CL, M, T> view_t;
+   typedef typename view_t::element_t element_t;
+   typedef typename view_t::storage_t storage_t;
+   typedef typename view_t::value_t value_t;
+   static const conf_t size = view_t::size;
+
+   explicit multivector_array(std::size_t lanes_ = 0)
+   {
+      allocate(lanes_);
+   }
+
+   multivector_array(std::size_t lanes_, const value_t& m)
+   {
+      allocate(lanes_);
+      this->fill(m);
+   }
+
+   template<class E>
+   multivector_array(std::size_t lanes_, const expression<E>& e)
+   {
+      allocate(lanes_);
+      view_t::operator=(e);
+   }
+
+   multivector_array(const multivector_array& a)
+      :  view_t()
+   {
+      allocate(a.lanes);
+      copy(a);
+   }
+
+   multivector_array& operator=(const multivector_array& a) {
+      if(this != &a) {
+         allocate(a.lanes);
+         copy(a);
+      }
+      return *this;
+   }
+
+   template<class E>
+   void operator=(const expression<E>& e) {
+      view_t::operator=(e);
+   }
+
+   //change number of multivectors, elements are not preserved
+   void resize(std::size_t lanes_) {
+      allocate(lanes_);
+   }
+
+protected:
+   void allocate(std::size_t lanes_) {
+      //blade arrays padded to multiples of alignment
+      static const std::size_t align = (GAALET_ARRAY_ALIGNMENT%sizeof(storage_t)==0) ? GAALET_ARRAY_ALIGNMENT/sizeof(storage_t) : 1;
+      const std::size_t stride = (lanes_+align-1)/align*align;
+
+      buffer.assign(stride*size + align, storage_t());
+      const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer.data());
+      const std::uintptr_t alignment = align*sizeof(storage_t);
+      storage_t* base = buffer.data() + ((alignment - address%alignment)%alignment)/sizeof(storage_t);
+
+      for(conf_t index = 0; index < size; ++index) {
+         this->blades[index] = base + index*stride;
+      }
+      this->lanes = lanes_;
+   }
+
+   void copy(const multivector_array& a) {
+      for(conf_t index = 0; index < size; ++index) {
+         std::copy(a.blades[index], a.blades[index]+a.lanes, this->blades[index]);
+      }
+   }
+
+   std::vector<storage_t> buffer;
+};
+
+template<typename CL, typename M, typename T, class D, conf_t conf>
+struct alias_source<multivector_array_view<CL, M, T>, D, conf>
+{
+   static const conf_t value = alias_none;
+};
+
+//cost model: loads of current lane
+template<typename CL, typename M, typename T, conf_t conf>
+struct element_cost<multivector_array_view<CL, M, T>, conf>
+{
+   typedef operations<> type;
+};
+template<typename CL, typename M, typename T>
+struct init_cost<multivector_array_view<CL, M, T>>
+{
+   typedef operations<> type;
+};
+
+} //end namespace gaalet
+
+#endif
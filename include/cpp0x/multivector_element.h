@@ -9,6 +9,32 @@ namespace gaalet
 //default multivector element type
 typedef double default_element_t;
 
+/// Precision policy as element type: multivectors store elements of type S, expressions compute and accumulate in type C.
+/**
+ * Usable as element type of an algebra, e.g. algebra<signature<4,1>, precision<float, double>>:
+ * products are summed in C and rounded to S once on assignment, evaluated temporaries (eval()) are of type C.
+ */
+template<typename S, typename C>
+struct precision
+{
+   typedef S storage_t;
+   typedef C element_t;
+};
+
+//element type T of multivector: type of computation (element_t) and of storage (storage_t)
+template<typename T>
+struct element_precision
+{
+   typedef T storage_t;
+   typedef T element_t;
+};
+template<typename S, typename C>
+struct element_precision<precision<S, C>>
+{
+   typedef S storage_t;
+   typedef C element_t;
+};
+
 
 template<typename EL, typename ER, bool EL_SIZE = (sizeof(EL) >= sizeof(ER))>
 struct element_type_size_compare_traits;
@@ -2,6 +2,9 @@
 #define __GAALET_OUTER_PRODUCT_H
 
 #include "utility.h"
+#include "materialization.h"
+#include "product_table.h"
+#include "multiplication_list.h"
 
 namespace gaalet
 {
@@ -15,7 +18,7 @@ struct msl_null
    static const conf_t size = 0;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L&, const R&)
+   static constexpr element_t product_sum(const L&, const R&)
    {
       return 0.0;
    }
@@ -26,17 +29,18 @@ struct multiplication_sum_list
 {
    static const conf_t left = LC;
    static const conf_t right = RC;
+   static const int reordering_sign = canonical_reordering_sign(LC, RC);
 
    typedef T tail;
 
    static const conf_t size = T::size + 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       return
          l.template element<left>()*r.template element<right>()
-         *CanonicalReorderingSign<left, right>::value
+         *reordering_sign
          + tail::template product_sum<element_t>(l, r);
    }
 };
@@ -45,17 +49,18 @@ struct multiplication_sum_list<LC, RC, msl_null>
 {
    static const conf_t left = LC;
    static const conf_t right = RC;
+   static const int reordering_sign = canonical_reordering_sign(LC, RC);
 
    typedef msl_null tail;
 
    static const conf_t size = 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       return
          l.template element<left>()*r.template element<right>()
-         *CanonicalReorderingSign<left, right>::value;
+         *reordering_sign;
    }
 };
 
@@ -72,7 +77,7 @@ struct multiplication_element_list
    static const conf_t size = T::size + 1;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L& l, const R& r)
+   static constexpr element_t product_sum(const L& l, const R& r)
    {
       return head::template product_sum<element_t>(l, r);
    }
@@ -86,7 +91,7 @@ struct mel_null
    static const conf_t size = 0;
 
    template<typename element_t, class L, class R>
-   static element_t product_sum(const L&, const R&)
+   static constexpr element_t product_sum(const L&, const R&)
    {
       return 0.0;
    }
@@ -191,6 +196,31 @@ struct search_conf_in_melist<conf, mel_null, true>
    typedef mel_null melist;
 };
 
+//product policy for construction of multiplication element lists: element multiplications of non-degenerate basis vectors with grade of result grade(l)+grade(r)
+template<typename metric>
+struct product
+{
+   static constexpr bool contributes(conf_t l, conf_t r) {
+      return !(metric::degenerate_bitmap & l & r) && bit_count(l^r)==bit_count(l)+bit_count(r);
+   }
+
+   static constexpr int sign(conf_t l, conf_t r) {
+      return canonical_reordering_sign(l, r);
+   }
+
+   template<typename LCL, typename RCL>
+   struct recursive_list
+   {
+      typedef typename build_multiplication_element_list<LCL, RCL, metric>::melist melist;
+   };
+
+   template<conf_t C, typename melist>
+   struct search_list
+   {
+      typedef typename search_conf_in_melist<C, melist>::melist list;
+   };
+};
+
 }  //end namespace op
 
 template<class L, class R>
@@ -199,22 +229,86 @@ struct outer_product : public expression<outer_product<L, R>>
    typedef typename element_type_combination_traits<typename L::element_t, typename R::element_t>::element_t element_t;
    typedef typename metric_combination_traits<typename L::metric, typename R::metric>::metric metric;
 
-   typedef typename op::build_multiplication_element_list<typename L::clist, typename R::clist, metric>::melist melist;
+   typedef op::product<metric> product_policy;
+   typedef typename build_product_melist<product_policy, typename L::clist, typename R::clist>::melist melist;
    typedef typename melist::clist clist;
 
+   typedef product_table<melist, metric, typename L::clist, typename R::clist> table;
+
+   typedef typename operand_storage<L, melist>::type l_storage_t;
+   typedef typename operand_storage<R, melist>::type r_storage_t;
+
 
-   outer_product(const L& l_ , const R& r_)
+   constexpr outer_product(const L& l_ , const R& r_)
       :  l(l_), r(r_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
-      return op::search_conf_in_melist<conf, melist>::melist::template product_sum<element_t>(l, r);
+   constexpr element_t element() const {
+      return product_sum_list<product_policy, conf, typename L::clist, typename R::clist, melist>::list::template product_sum<element_t>(l, r);
+   }
+
+   void init() {
+      l.init();
+      r.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return l.aliases(d) || r.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      l.bind_lane(lane);
+      r.bind_lane(lane);
+   }
+
+   //table-driven evaluation, operands with multivector storage only
+   template<typename DCL, typename T, typename D>
+   void evaluate(D& data) const {
+      table::template evaluate<DCL, T>(data, storage_of(l), storage_of(r));
    }
 
 protected:
-   const L& l;
-   const R& r;
+   l_storage_t l;
+   r_storage_t r;
+};
+
+template<class L, class R>
+struct evaluation_kernel<outer_product<L, R>>
+{
+   typedef outer_product<L, R> E;
+
+   static const bool value = has_storage<typename std::remove_cv<typename std::remove_reference<typename E::l_storage_t>::type>::type>::value
+                             && has_storage<typename std::remove_cv<typename std::remove_reference<typename E::r_storage_t>::type>::type>::value;
+};
+
+//state of operand storage
+template<class L, class R>
+struct has_state<outer_product<L, R>>
+{
+   typedef outer_product<L, R> E;
+
+   static const bool value = has_state<typename std::remove_cv<typename std::remove_reference<typename E::l_storage_t>::type>::type>::value
+                             || has_state<typename std::remove_cv<typename std::remove_reference<typename E::r_storage_t>::type>::type>::value;
+};
+
+//product of operands with elements carried in the type
+template<class L, class R>
+struct has_constant_elements<outer_product<L, R>>
+{
+   static const bool value = has_constant_elements<L>::value && has_constant_elements<R>::value;
+};
+
+//cost model: element multiplications of operand storage
+template<class L, class R, conf_t conf>
+struct element_cost<outer_product<L, R>, conf>
+{
+   typedef typename product_element_cost<outer_product<L, R>, conf>::type type;
+};
+template<class L, class R>
+struct init_cost<outer_product<L, R>>
+{
+   typedef typename product_init_cost<outer_product<L, R>>::type type;
 };
 
 } //end namespace gaalet
@@ -224,10 +318,22 @@ protected:
  * Following Hestenes' defintion.
  */
 /// \ingroup ga_ops
-template <class L, class R> inline
+template <class L, class R> constexpr
 gaalet::outer_product<L, R>
 operator^(const gaalet::expression<L>& l, const gaalet::expression<R>& r) {
    return gaalet::outer_product<L, R>(l, r);
 }
 
+/// \brief Outer product of a multivector and a multivector in place.
+/**
+ * Evaluated as l = l^r: elements outside the configuration list of l are discarded, evaluated into a temporary.
+ */
+/// \ingroup ga_ops
+template <class CL, class M, class T, class R> inline
+gaalet::multivector<CL, M, T>&
+operator^=(gaalet::multivector<CL, M, T>& l, const gaalet::expression<R>& r) {
+   l = l^r;
+   return l;
+}
+
 #endif
@@ -0,0 +1,288 @@
+#ifndef __GAALET_PARALLEL_H
+#define __GAALET_PARALLEL_H
+
+#include "multivector_array.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//lanes of destination array per chunk of parallel_assign targeted to this size in bytes (second level cache)
+#ifndef GAALET_PARALLEL_CHUNK_BYTES
+#define GAALET_PARALLEL_CHUNK_BYTES 262144
+#endif
+
+namespace gaalet
+{
+
+//work-stealing deque of consecutive chunk indices [top, bottom) (Chase-Lev: owner pops at bottom, thieves steal at top)
+struct chunk_deque
+{
+   static const std::ptrdiff_t empty = -1;
+   static const std::ptrdiff_t abort = -2;
+
+   //not concurrent with pop() or steal()
+   void reset(std::ptrdiff_t begin, std::ptrdiff_t end) {
+      top.store(begin, std::memory_order_relaxed);
+      bottom.store(end, std::memory_order_relaxed);
+   }
+
+   //owner only
+   std::ptrdiff_t pop() {
+      const std::ptrdiff_t b = bottom.load(std::memory_order_relaxed) - 1;
+      bottom.store(b, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+      if(t < b) {
+         return b;
+      }
+      if(t == b) {
+         //last chunk: race with thieves
+         const bool taken = top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed);
+         bottom.store(b+1, std::memory_order_relaxed);
+         return taken ? b : empty;
+      }
+      bottom.store(b+1, std::memory_order_relaxed);
+      return empty;
+   }
+
+   //any thread
+   std::ptrdiff_t steal() {
+      std::ptrdiff_t t = top.load(std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      const std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+      if(t < b) {
+         return top.compare_exchange_strong(t, t+1, std::memory_order_seq_cst, std::memory_order_relaxed) ? t : abort;
+      }
+      return empty;
+   }
+
+   std::atomic<std::ptrdiff_t> top;
+   std::atomic<std::ptrdiff_t> bottom;
+   //deques of different participants on different cache lines (padding instead of extended alignment, no aligned new in c++0x)
+   char padding[128 - 2*sizeof(std::atomic<std::ptrdiff_t>)];
+};
+
+/// Pool of worker threads evaluating chunks of a range with work stealing.
+/**
+ * The calling thread takes part in the evaluation, thus a pool of size n runs n-1 worker threads.
+ * Every participant owns a deque of consecutive chunks; idle participants steal chunks from the others.
+ * Calls of parallel_for() on one pool are serialized, nested calls from within a chunk are not supported.
+ * An exception thrown by a chunk skips the remaining chunks and is rethrown on the calling thread once all participants left.
+ */
+class thread_pool
+{
+public:
+   //size 0: one participant per hardware thread
+   explicit thread_pool(unsigned int threads = 0)
+      :  participants(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+         deques(new chunk_deque[participants]),
+         generation(0), active(0), stop(false)
+   {
+      for(unsigned int id = 1; id < participants; ++id) {
+         workers.push_back(std::thread(&thread_pool::work, this, id));
+      }
+   }
+
+   ~thread_pool() {
+      {
+         std::lock_guard<std::mutex> lock(wait_mutex);
+         stop = true;
+      }
+      wake.notify_all();
+      for(std::size_t i = 0; i < workers.size(); ++i) {
+         workers[i].join();
+      }
+   }
+
+   unsigned int size() const {
+      return participants;
+   }
+
+   //f(begin, end) for chunks [begin, end) of [0, n) of grain elements
+   template<class F>
+   void parallel_for(std::size_t n, std::size_t grain, const F& f) {
+      grain = std::max<std::size_t>(grain, 1);
+      const std::size_t chunks = (n + grain - 1)/grain;
+      if(participants==1 || chunks<=1) {
+         if(n) f(0, n);
+         return;
+      }
+
+      std::lock_guard<std::mutex> call_lock(call_mutex);
+      job.chunk = &run_chunk<F>;
+      job.f = &f;
+      job.n = n;
+      job.grain = grain;
+      job.error = std::exception_ptr();
+      job.failed.store(false, std::memory_order_relaxed);
+
+      //contiguous blocks of chunks per participant
+      for(unsigned int id = 0; id < participants; ++id) {
+         deques[id].reset(std::ptrdiff_t(chunks*id/participants), std::ptrdiff_t(chunks*(id+1)/participants));
+      }
+
+      active.store(participants-1, std::memory_order_relaxed);
+      {
+         std::lock_guard<std::mutex> lock(wait_mutex);
+         ++generation;
+      }
+      wake.notify_all();
+
+      participate(0);
+
+      //job data in use until all workers left
+      {
+         std::unique_lock<std::mutex> lock(wait_mutex);
+         while(active.load(std::memory_order_acquire) != 0) {
+            done.wait(lock);
+         }
+      }
+
+      if(job.error) {
+         std::rethrow_exception(job.error);
+      }
+   }
+
+   //pool shared by parallel_assign() and parallel_for() without explicit pool
+   static thread_pool& global() {
+      static thread_pool pool;
+      return pool;
+   }
+
+protected:
+   struct job_t
+   {
+      void (*chunk)(job_t&, std::size_t);
+      const void* f;
+      std::size_t n;
+      std::size_t grain;
+
+      //first exception thrown by a chunk, remaining chunks are drained without evaluation
+      std::atomic<bool> failed;
+      std::mutex error_mutex;
+      std::exception_ptr error;
+   };
+
+   template<class F>
+   static void run_chunk(job_t& j, std::size_t c) {
+      if(j.failed.load(std::memory_order_relaxed)) {
+         return;
+      }
+      const std::size_t begin = c*j.grain;
+      const std::size_t end = std::min(begin + j.grain, j.n);
+      try {
+         (*static_cast<const F*>(j.f))(begin, end);
+      }
+      catch(...) {
+         std::lock_guard<std::mutex> lock(j.error_mutex);
+         if(!j.error) {
+            j.error = std::current_exception();
+         }
+         j.failed.store(true, std::memory_order_relaxed);
+      }
+   }
+
+   //own chunks first, then chunks stolen from others until all deques are empty
+   void participate(unsigned int id) {
+      for(;;) {
+         std::ptrdiff_t c = deques[id].pop();
+         if(c == chunk_deque::empty) {
+            c = steal(id);
+            if(c == chunk_deque::empty) {
+               return;
+            }
+         }
+         job.chunk(job, std::size_t(c));
+      }
+   }
+
+   std::ptrdiff_t steal(unsigned int id) {
+      bool contended = true;
+      while(contended) {
+         contended = false;
+         for(unsigned int k = 1; k < participants; ++k) {
+            const std::ptrdiff_t c = deques[(id + k) % participants].steal();
+            if(c >= 0) {
+               return c;
+            }
+            contended |= (c == chunk_deque::abort);
+         }
+      }
+      return chunk_deque::empty;
+   }
+
+   void work(unsigned int id) {
+      std::size_t seen = 0;
+      for(;;) {
+         {
+            std::unique_lock<std::mutex> lock(wait_mutex);
+            while(!stop && generation==seen) {
+               wake.wait(lock);
+            }
+            if(stop) {
+               return;
+            }
+            seen = generation;
+         }
+         participate(id);
+         {
+            //decrement under wait_mutex: no lost wakeup of the waiting caller
+            std::lock_guard<std::mutex> lock(wait_mutex);
+            active.fetch_sub(1, std::memory_order_release);
+         }
+         done.notify_one();
+      }
+   }
+
+   const unsigned int participants;
+   std::unique_ptr<chunk_deque[]> deques;
+   std::vector<std::thread> workers;
+
+   job_t job;
+   std::mutex call_mutex;
+
+   std::mutex wait_mutex;
+   std::condition_variable wake;
+   std::condition_variable done;
+   std::size_t generation;
+   std::atomic<unsigned int> active;
+   bool stop;
+};
+
+//parallel_for on global pool
+template<class F> inline
+void parallel_for(std::size_t n, std::size_t grain, const F& f) {
+   thread_pool::global().parallel_for(n, grain, f);
+}
+
+//lanes per chunk: whole blocks of assignment evaluation, destination chunk about GAALET_PARALLEL_CHUNK_BYTES, at least four chunks per participant
+template<typename T> inline
+std::size_t parallel_grain(std::size_t lanes, conf_t size, unsigned int participants) {
+   const std::size_t block = GAALET_ARRAY_BLOCK;
+   const std::size_t cache = std::max<std::size_t>(1, GAALET_PARALLEL_CHUNK_BYTES/(sizeof(T)*std::max<conf_t>(size, 1))/block)*block;
+   const std::size_t balance = ((lanes + 4*participants - 1)/(4*participants) + block - 1)/block*block;
+   return std::max(block, std::min(cache, balance));
+}
+
+/// Parallel assignment evaluation of an expression to a multivector array.
+/**
+ * Lanes are evaluated in chunks by the participants of the pool, within a chunk as by assignment (expression may read the lanes it assigns).
+ */
+template<typename CL, typename M, typename T, class E> inline
+void parallel_assign(multivector_array_view<CL, M, T>& dst, const expression<E>& e, thread_pool& pool = thread_pool::global())
+{
+   const std::size_t grain = parallel_grain<typename multivector_array_view<CL, M, T>::storage_t>(dst.length(), CL::size, pool.size());
+   pool.parallel_for(dst.length(), grain, [&dst, &e](std::size_t begin, std::size_t end) {
+      dst.assign_lanes(begin, end-begin, e);
+   });
+}
+
+} //end namespace gaalet
+
+#endif
@@ -2,6 +2,7 @@
 #define __GAALET_PART_H
 
 #include "utility.h"
+#include "materialization.h"
 
 namespace gaalet {
 
@@ -14,17 +15,29 @@ struct part : public expression<part<A, elements...>>
 
    typedef typename A::element_t element_t;
 
-   part(const A& a_)
+   constexpr part(const A& a_)
       :  a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return (search_element<conf, clist>::index>=clist::size) ? 0.0 : a.template element<conf>();
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
 };
 
 template<class T, class A>
@@ -36,17 +49,81 @@ struct part_type: public expression<part_type<T, A>>
 
    typedef typename A::element_t element_t;
 
-   part_type(const A& a_)
+   constexpr part_type(const A& a_)
       :  a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return (search_element<conf, clist>::index>=clist::size) ? 0.0 : a.template element<conf>();
    }
 
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+};
+
+template<class A, conf_t... elements>
+struct is_cheap_expression<part<A, elements...>>
+{
+   static const bool value = is_cheap_expression<A>::value;
+};
+template<class T, class A>
+struct is_cheap_expression<part_type<T, A>>
+{
+   static const bool value = is_cheap_expression<A>::value;
+};
+template<class A, conf_t... elements, class D, conf_t conf>
+struct alias_source<part<A, elements...>, D, conf>
+{
+   typedef typename part<A, elements...>::clist clist;
+   static const conf_t value = (search_element<conf, clist>::index<clist::size) ? alias_source<A, D, conf>::value : alias_none;
+};
+template<class T, class A, class D, conf_t conf>
+struct alias_source<part_type<T, A>, D, conf>
+{
+   typedef typename part_type<T, A>::clist clist;
+   static const conf_t value = (search_element<conf, clist>::index<clist::size) ? alias_source<A, D, conf>::value : alias_none;
+};
+template<class A, conf_t... elements>
+struct has_state<part<A, elements...>>
+{
+   static const bool value = has_state<A>::value;
+};
+
+//cost model: elements of sub-space read from operand
+template<class A, conf_t... elements, conf_t conf>
+struct element_cost<part<A, elements...>, conf>
+{
+   typedef typename part<A, elements...>::clist clist;
+   typedef typename std::conditional<(search_element<conf, clist>::index<clist::size), typename element_cost<A, conf>::type, operations<>>::type type;
+};
+template<class A, conf_t... elements>
+struct init_cost<part<A, elements...>>
+{
+   typedef typename init_cost<A>::type type;
+};
+template<class T, class A, conf_t conf>
+struct element_cost<part_type<T, A>, conf>
+{
+   typedef typename part_type<T, A>::clist clist;
+   typedef typename std::conditional<(search_element<conf, clist>::index<clist::size), typename element_cost<A, conf>::type, operations<>>::type type;
+};
+template<class T, class A>
+struct init_cost<part_type<T, A>>
+{
+   typedef typename init_cost<A>::type type;
 };
 
 
@@ -58,7 +135,7 @@ protected:
  * \param elements List of elements defining the sub-spaces to project onto.
  */
 /// \ingroup ga_ops
-template<gaalet::conf_t... elements, class A> inline
+template<gaalet::conf_t... elements, class A> constexpr
 gaalet::part<A, elements...>
 part(const gaalet::expression<A>& a) {
    return gaalet::part<A, elements...>(a);
@@ -70,7 +147,7 @@ part(const gaalet::expression<A>& a) {
  * \param T Multivector with configuration list defining the sub-spaces to project onto.
  */
 /// \ingroup ga_ops
-template<class T, class A> inline
+template<class T, class A> constexpr
 gaalet::part_type<T, A>
 part_type(const gaalet::expression<A>& a) {
    return gaalet::part_type<T, A>(a);
@@ -0,0 +1,462 @@
+#ifndef __GAALET_PIPELINE_H
+#define __GAALET_PIPELINE_H
+
+#include "gaalet.h"
+#include "dataset.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//streaming transformation of point clouds by a versor (POSIX): reader, lift, versor application, projection and writer stages,
+//one thread per stage, connected by bounded single-producer single-consumer rings of blocks
+//   blocks are allocated once and cycle from the writer back to the reader, no allocation at steady state
+//   full rings block the producing stage (back-pressure), reader and writer run at the pace of the slowest stage
+
+namespace gaalet
+{
+
+/// Bounded lock-free ring of values between one producer and one consumer thread.
+/**
+ * push() waits while the ring is full, pop() while it is empty (spinning shortly, then blocking until the other side
+ * popped or pushed); close() ends the stream after the values pushed, cancel() releases waiting threads immediately
+ * (push() and pop() return false).
+ */
+template<typename T>
+class spsc_ring
+{
+public:
+   //capacity rounded up to power of two
+   explicit spsc_ring(std::size_t capacity)
+      :  head(0), tail(0), closed(false), cancelled(false), waiters(0)
+   {
+      std::size_t c = 1;
+      while(c < capacity) c <<= 1;
+      slots.resize(c);
+      mask = c - 1;
+   }
+
+   spsc_ring(const spsc_ring&) = delete;
+   spsc_ring& operator=(const spsc_ring&) = delete;
+
+   //producer only
+   bool try_push(const T& v) {
+      const std::size_t t = tail.load(std::memory_order_relaxed);
+      if(t - head.load(std::memory_order_acquire) > mask) return false;
+      slots[t & mask] = v;
+      tail.store(t + 1, std::memory_order_release);
+      notify();
+      return true;
+   }
+
+   bool push(const T& v) {
+      for(unsigned int spin = 0; !try_push(v); ++spin) {
+         if(cancelled.load(std::memory_order_relaxed)) return false;
+         wait(spin, [this]() {
+            return tail.load(std::memory_order_relaxed) - head.load(std::memory_order_acquire) <= mask;
+         });
+      }
+      return true;
+   }
+
+   //consumer only
+   bool try_pop(T& v) {
+      const std::size_t h = head.load(std::memory_order_relaxed);
+      if(h == tail.load(std::memory_order_acquire)) return false;
+      v = slots[h & mask];
+      head.store(h + 1, std::memory_order_release);
+      notify();
+      return true;
+   }
+
+   //false at end of stream (closed and empty) or if cancelled
+   bool pop(T& v) {
+      for(unsigned int spin = 0; !try_pop(v); ++spin) {
+         if(cancelled.load(std::memory_order_relaxed)) return false;
+         if(closed.load(std::memory_order_acquire)) return try_pop(v);
+         wait(spin, [this]() {
+            return head.load(std::memory_order_relaxed) != tail.load(std::memory_order_acquire) || closed.load(std::memory_order_acquire);
+         });
+      }
+      return true;
+   }
+
+   void close() {
+      closed.store(true, std::memory_order_release);
+      notify();
+   }
+
+   void cancel() {
+      cancelled.store(true, std::memory_order_relaxed);
+      notify();
+   }
+
+   std::size_t capacity() const {
+      return mask + 1;
+   }
+
+protected:
+   //short spinning, then yield to other stages, then blocking until ready() or cancelled (stalled stage, more stages than cores)
+   template<class P>
+   void wait(unsigned int spin, const P& ready) {
+      if(spin < 64) return;
+      if(spin < 128) {
+         std::this_thread::yield();
+         return;
+      }
+      std::unique_lock<std::mutex> lock(wait_mutex);
+      waiters.fetch_add(1, std::memory_order_seq_cst);
+      while(!ready() && !cancelled.load(std::memory_order_relaxed)) {
+         changed.wait(lock);
+      }
+      waiters.fetch_sub(1, std::memory_order_relaxed);
+   }
+
+   //wake blocked side after push, pop, close or cancel: either the waiter sees the change or the change sees the waiter
+   void notify() {
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if(waiters.load(std::memory_order_relaxed) != 0) {
+         {
+            std::lock_guard<std::mutex> lock(wait_mutex);
+         }
+         changed.notify_all();
+      }
+   }
+
+   //indices of consumer and producer on different cache lines
+   std::atomic<std::size_t> head;
+   char head_padding[128 - sizeof(std::atomic<std::size_t>)];
+   std::atomic<std::size_t> tail;
+   char tail_padding[128 - sizeof(std::atomic<std::size_t>)];
+
+   std::vector<T> slots;
+   std::size_t mask;
+   std::atomic<bool> closed;
+   std::atomic<bool> cancelled;
+
+   std::mutex wait_mutex;
+   std::condition_variable changed;
+   std::atomic<unsigned int> waiters;
+};
+
+/// Point cloud transformation x -> V*(x + 0.5*(x&x)*einf + e0)*~V, projected to Euclidean points, as pipeline of stages.
+/**
+ * V is a versor of the conformal algebra (e.g. a motor), applied by its precomputed versor_map.
+ * Sources fill euclidean_view blocks and return the number of points read (0 at end), sinks consume them,
+ * see raw_point_source, raw_point_sink, dataset_point_source and dataset_point_sink.
+ */
+template<class V>
+class point_pipeline
+{
+public:
+   typedef typename V::element_t element_t;
+   typedef algebra<cga::metric, element_t> algebra_t;
+   typedef typename algebra_t::template mv<1, 2, 4>::type euclidean_t;
+   typedef typename algebra_t::template mv<1, 2, 4, 8, 0x10>::type conformal_t;
+   typedef multivector_array<typename euclidean_t::clist, cga::metric, element_t> euclidean_array;
+   typedef multivector_array<typename conformal_t::clist, cga::metric, element_t> conformal_array;
+   typedef multivector_array_view<typename euclidean_t::clist, cga::metric, element_t> euclidean_view;
+   typedef multivector_array_view<typename conformal_t::clist, cga::metric, element_t> conformal_view;
+
+   typedef cga::basis<element_t> basis;
+
+   static_assert(std::is_same<typename V::metric, cga::metric>::value, "point_pipeline: versor not of conformal algebra");
+
+   //blocks of block_lanes points in flight between stages, stages pinned to consecutive cores from first_core if pin
+   template<class E>
+   point_pipeline(const expression<E>& v, std::size_t block_lanes_ = 4096, std::size_t blocks_ = 8, bool pin_ = false, unsigned int first_core_ = 0)
+      :  map(v), block_lanes(block_lanes_), pin(pin_), first_core(first_core_)
+   {
+      for(std::size_t b = 0; b < std::max<std::size_t>(blocks_, 2); ++b) {
+         blocks.push_back(std::unique_ptr<block>(new block(block_lanes)));
+      }
+   }
+
+   /// Streams all points of source through the stages into sink, returns number of points.
+   template<class Source, class Sink>
+   std::size_t run(Source& source, Sink& sink) {
+      //free -> reader -> lifted -> applied -> projected -> writer -> free
+      spsc_ring<block*> free(blocks.size()), read(blocks.size()), lifted(blocks.size()), applied(blocks.size()), projected(blocks.size());
+      spsc_ring<block*>* rings[] = { &free, &read, &lifted, &applied, &projected };
+      for(std::size_t b = 0; b < blocks.size(); ++b) {
+         free.push(blocks[b].get());
+      }
+
+      std::exception_ptr error;
+      std::atomic<bool> failed(false);
+      std::size_t count = 0;
+
+      //stage body f(block&) between rings in and out, end of stream passed on, first error cancels all rings
+      auto stage = [&](unsigned int id, spsc_ring<block*>& in, spsc_ring<block*>* out, std::function<bool(block&)> f) {
+         pin_stage(id);
+         try {
+            block* b;
+            while(in.pop(b)) {
+               const bool more = f(*b);
+               if(!more) break;
+               if(out && !out->push(b)) break;
+            }
+         }
+         catch(...) {
+            if(!failed.exchange(true)) {
+               error = std::current_exception();
+               for(spsc_ring<block*>* r : rings) r->cancel();
+            }
+         }
+         if(out) out->close();
+      };
+
+      const versor_map<V, conformal_t>& m = map;
+      std::vector<std::thread> threads;
+      threads.push_back(std::thread(stage, 0, std::ref(free), &read, [&source](block& b) {
+         b.length = source(b.x.view(0, b.x.length()));
+         return b.length > 0;
+      }));
+      threads.push_back(std::thread(stage, 1, std::ref(read), &lifted, [](block& b) {
+         using ::operator+;
+         const euclidean_view x = b.x.view(0, b.length);
+         b.p.view(0, b.length).assign(x + 0.5*(x&x)*basis::einf + basis::e0);
+         return true;
+      }));
+      threads.push_back(std::thread(stage, 2, std::ref(lifted), &applied, [&m](block& b) {
+         conformal_view p = b.p.view(0, b.length);
+         p = m(p);
+         return true;
+      }));
+      threads.push_back(std::thread(stage, 3, std::ref(applied), &projected, [](block& b) {
+         using ::part;
+         const conformal_view p = b.p.view(0, b.length);
+         b.x.view(0, b.length).assign(part<1, 2, 4>(p)*(-1.0)*!(p&basis::einf));
+         return true;
+      }));
+      stage(4, projected, nullptr, [&sink, &free, &count](block& b) {
+         sink(b.x.view(0, b.length));
+         count += b.length;
+         free.push(&b);
+         return true;
+      });
+
+      for(std::size_t t = 0; t < threads.size(); ++t) {
+         threads[t].join();
+      }
+      if(error) std::rethrow_exception(error);
+      return count;
+   }
+
+   const versor_map<V, conformal_t>& versor() const {
+      return map;
+   }
+
+protected:
+   struct block
+   {
+      explicit block(std::size_t lanes)
+         :  x(lanes), p(lanes), length(0)
+      { }
+
+      euclidean_array x;   //points read, projected points written
+      conformal_array p;   //conformal points, transformed in place
+      std::size_t length;
+   };
+
+   void pin_stage(unsigned int id) const {
+#if defined(__linux__)
+      if(pin) {
+         cpu_set_t cores;
+         CPU_ZERO(&cores);
+         CPU_SET((first_core + id) % std::max(1u, std::thread::hardware_concurrency()), &cores);
+         pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cores);
+      }
+#else
+      (void)id;
+#endif
+   }
+
+   versor_map<V, conformal_t> map;
+   std::size_t block_lanes;
+   bool pin;
+   unsigned int first_core;
+   std::vector<std::unique_ptr<block>> blocks;
+};
+
+/// Source of points stored as consecutive x, y, z elements of type S in a plain file, read by one fread() per block.
+template<typename S = double>
+class raw_point_source
+{
+public:
+   explicit raw_point_source(const std::string& path_)
+      :  path(path_), file(std::fopen(path_.c_str(), "rb"))
+   {
+      if(!file) throw dataset_error(path, "cannot open");
+   }
+
+   ~raw_point_source() {
+      if(file) std::fclose(file);
+   }
+
+   raw_point_source(const raw_point_source&) = delete;
+   raw_point_source& operator=(const raw_point_source&) = delete;
+
+   template<typename CL, typename M, typename T>
+   std::size_t operator()(const multivector_array_view<CL, M, T>& x) {
+      static_assert(CL::size==3, "raw_point_source: view not of euclidean points");
+      buffer.resize(3*x.length());
+      const std::size_t n = std::fread(buffer.data(), 3*sizeof(S), x.length(), file);
+      if(n < x.length() && std::ferror(file)) throw dataset_error(path, "cannot read");
+      for(std::size_t i = 0; i < n; ++i) {
+         x.blade(0)[i] = buffer[3*i];
+         x.blade(1)[i] = buffer[3*i+1];
+         x.blade(2)[i] = buffer[3*i+2];
+      }
+      return n;
+   }
+
+protected:
+   std::string path;
+   std::FILE* file;
+   std::vector<S> buffer;
+};
+
+/// Sink of points stored as consecutive x, y, z elements of type S in a plain file, written by one fwrite() per block.
+template<typename S = double>
+class raw_point_sink
+{
+public:
+   explicit raw_point_sink(const std::string& path_)
+      :  path(path_), file(std::fopen(path_.c_str(), "wb"))
+   {
+      if(!file) throw dataset_error(path, "cannot create");
+   }
+
+   ~raw_point_sink() {
+      if(file) std::fclose(file);
+   }
+
+   raw_point_sink(const raw_point_sink&) = delete;
+   raw_point_sink& operator=(const raw_point_sink&) = delete;
+
+   template<typename CL, typename M, typename T>
+   void operator()(const multivector_array_view<CL, M, T>& x) {
+      static_assert(CL::size==3, "raw_point_sink: view not of euclidean points");
+      buffer.resize(3*x.length());
+      for(std::size_t i = 0; i < x.length(); ++i) {
+         buffer[3*i] = x.blade(0)[i];
+         buffer[3*i+1] = x.blade(1)[i];
+         buffer[3*i+2] = x.blade(2)[i];
+      }
+      if(std::fwrite(buffer.data(), 3*sizeof(S), x.length(), file) != x.length()) throw dataset_error(path, "cannot write");
+   }
+
+   void close() {
+      if(file && std::fclose(file) != 0) {
+         file = nullptr;
+         throw dataset_error(path, "cannot write");
+      }
+      file = nullptr;
+   }
+
+protected:
+   std::string path;
+   std::FILE* file;
+   std::vector<S> buffer;
+};
+
+/// Source of points from a dataset of multivectors MV (Euclidean points), copied from the mapping blade row by blade row.
+/**
+ * Rows of soa datasets are copied from the blade arrays of the mapped blocks, rows of aos datasets gathered with stride.
+ * Blades of the view not stored in the dataset are zero.
+ */
+template<class MV>
+class dataset_point_source
+{
+public:
+   typedef typename dataset_reader<MV>::storage_t storage_t;
+   static const conf_t size = MV::clist::size;
+
+   explicit dataset_point_source(const std::string& path)
+      :  reader(path), position(0)
+   { }
+
+   template<typename CL, typename M, typename T>
+   std::size_t operator()(const multivector_array_view<CL, M, T>& x) {
+      const std::size_t n = std::min(x.length(), reader.length() - position);
+      const std::array<std::uint32_t, CL::size> to = dataset_blade_list<CL>();
+      const std::array<std::uint32_t, size> from = dataset_blade_list<typename MV::clist>();
+      for(conf_t index = 0; index < CL::size; ++index) {
+         const conf_t s = std::find(from.begin(), from.end(), to[index]) - from.begin();
+         copy_row(x.blade(index), s, n);
+      }
+      position += n;
+      return n;
+   }
+
+protected:
+   //lanes [position, position+n) of blade s of the dataset into out
+   template<typename U>
+   void copy_row(U* out, conf_t s, std::size_t n) const {
+      if(s == size) {
+         std::fill(out, out + n, U());
+      }
+      else if(reader.layout() == dataset_aos) {
+         const storage_t* in = reinterpret_cast<const storage_t*>(reader.begin()) + position*size + s;
+         for(std::size_t i = 0; i < n; ++i) {
+            out[i] = in[i*size];
+         }
+      }
+      else {
+         const std::size_t lanes = reader.block_lanes();
+         for(std::size_t i = 0; i < n; ) {
+            const std::size_t b = (position + i)/lanes;
+            const std::size_t offset = (position + i)%lanes;
+            const typename dataset_reader<MV>::view_t block = reader.block(b);
+            const std::size_t m = std::min(n - i, block.length() - offset);
+            std::copy(block.blade(s) + offset, block.blade(s) + offset + m, out + i);
+            i += m;
+         }
+      }
+   }
+
+   dataset_reader<MV> reader;
+   std::size_t position;
+};
+
+/// Sink of points into a dataset of multivectors MV, full blocks of soa datasets written from the blade arrays.
+template<class MV>
+class dataset_point_sink
+{
+public:
+   explicit dataset_point_sink(const std::string& path, dataset_layout layout = dataset_soa, std::size_t block_lanes = 4096)
+      :  writer(path, layout, block_lanes)
+   { }
+
+   template<typename CL, typename M, typename T>
+   void operator()(const multivector_array_view<CL, M, T>& x) {
+      writer.write(x);
+   }
+
+   void close() {
+      writer.close();
+   }
+
+protected:
+   dataset_writer<MV> writer;
+};
+
+} //end namespace gaalet
+
+#endif
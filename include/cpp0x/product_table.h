@@ -0,0 +1,183 @@
+#ifndef __GAALET_PRODUCT_TABLE_H
+#define __GAALET_PRODUCT_TABLE_H
+
+#include "configuration_list.h"
+#include "multivector_element.h"
+#include "utility.h"
+
+#include <array>
+
+namespace gaalet
+{
+
+//flattened element multiplication of a product: result[result_index] (+)= left[left_index]*right[right_index]*sign
+struct product_table_entry
+{
+   conf_t result;
+   conf_t result_index;
+   conf_t left_index;
+   conf_t right_index;
+   int sign;
+   //first multiplication written to a result element (assignment instead of summation)
+   bool first;
+};
+
+template<conf_t R, conf_t RI, conf_t LI, conf_t RIGHTI, int S, bool F>
+struct product_table_element
+{
+   static const conf_t result = R;
+   static const conf_t result_index = RI;
+   static const conf_t left_index = LI;
+   static const conf_t right_index = RIGHTI;
+   static const int sign = S;
+   //first multiplication written to a result element (assignment instead of summation)
+   static const bool first = F;
+};
+
+template<class... E>
+struct product_table_list
+{
+   static const conf_t size = sizeof...(E);
+
+   static constexpr product_table_entry entries[sizeof...(E)] = { {E::result, E::result_index, E::left_index, E::right_index, E::sign, E::first}... };
+};
+template<class... E>
+constexpr product_table_entry product_table_list<E...>::entries[sizeof...(E)];
+
+template<>
+struct product_table_list<>
+{
+   static const conf_t size = 0;
+};
+
+template<class list, class E>
+struct append_product_table_element;
+template<class... L, class E>
+struct append_product_table_element<product_table_list<L...>, E>
+{
+   typedef product_table_list<L..., E> type;
+};
+
+//flatten multiplication_sum_list: elements are appended in reverse order, so that summation order equals the one of product_sum()
+template<typename msl, conf_t result, conf_t result_index, typename metric, typename LCL, typename RCL, typename list, bool end = (msl::size==0)>
+struct flatten_multiplication_sum_list
+{
+   typedef typename flatten_multiplication_sum_list<typename msl::tail, result, result_index, metric, LCL, RCL, list>::type tail_list;
+
+   typedef typename append_product_table_element<tail_list,
+              product_table_element<result, result_index,
+                                    search_element<msl::left, LCL>::index, search_element<msl::right, RCL>::index,
+                                    msl::reordering_sign
+                                    *((BitCount<metric::signature_bitmap&(msl::left&msl::right)>::value % 2) ? -1 : 1),
+                                    (msl::tail::size==0)>
+           >::type type;
+};
+template<typename msl, conf_t result, conf_t result_index, typename metric, typename LCL, typename RCL, typename list>
+struct flatten_multiplication_sum_list<msl, result, result_index, metric, LCL, RCL, list, true>
+{
+   typedef list type;
+};
+
+//flatten multiplication_element_list (layout shared by gp, ip and op)
+template<typename melist, typename metric, typename LCL, typename RCL, conf_t result_index = 0, typename list = product_table_list<>, bool end = (melist::size==0)>
+struct flatten_multiplication_element_list
+{
+   typedef typename flatten_multiplication_element_list<typename melist::tail, metric, LCL, RCL, result_index+1,
+              typename flatten_multiplication_sum_list<typename melist::head, melist::conf, result_index, metric, LCL, RCL, list>::type
+           >::type type;
+};
+template<typename melist, typename metric, typename LCL, typename RCL, conf_t result_index, typename list>
+struct flatten_multiplication_element_list<melist, metric, LCL, RCL, result_index, list, true>
+{
+   typedef list type;
+};
+
+
+//element multiplication of table entry E: straight-line multiply-add at compile-time indices and sign into local result row E::result_index
+template<class E>
+struct product_table_step
+{
+   template<typename A, class L, class R>
+   static void apply(A& acc, const L& l, const R& r) {
+      std::get<E::result_index>(acc) = E::first ? l.template get<E::left_index>()*r.template get<E::right_index>()*E::sign
+                                                : l.template get<E::left_index>()*r.template get<E::right_index>()*E::sign + std::get<E::result_index>(acc);
+   }
+};
+
+//table-driven evaluation: entries expanded in table order into local result rows (no aliasing of operands with destination)
+template<class list>
+struct product_table_evaluation;
+template<class... E>
+struct product_table_evaluation<product_table_list<E...>>
+{
+   template<typename A, class L, class R>
+   static void apply(A& acc, const L& l, const R& r) {
+      typedef int swallow[];
+      (void)swallow{0, (product_table_step<E>::apply(acc, l, r), 0)...};
+   }
+};
+
+//result row written to destination storage index, dropped if not part of destination
+template<conf_t index, conf_t size>
+struct product_table_store_row
+{
+   template<typename D, typename T>
+   static void apply(D& data, const T& t) {
+      data[index] = t;
+   }
+};
+template<conf_t size>
+struct product_table_store_row<size, size>
+{
+   template<typename D, typename T>
+   static void apply(D&, const T&) { }
+};
+
+//result rows of product configuration CL stored at their storage index in destination configuration DCL
+template<typename DCL, typename CL, class I>
+struct product_table_store;
+template<typename DCL, typename CL, conf_t... I>
+struct product_table_store<DCL, CL, index_list<I...>>
+{
+   template<typename D, typename A>
+   static void apply(D& data, const A& acc) {
+      typedef int swallow[];
+      (void)swallow{0, (product_table_store_row<search_element<get_element<I, CL>::value, DCL>::index, DCL::size>::apply(data, std::get<I>(acc)), 0)...};
+   }
+};
+
+//destination elements not written by any element multiplication
+template<typename DCL, typename CL, conf_t index = 0, bool end = (index==DCL::size)>
+struct product_table_null_elements
+{
+   template<typename element_t, typename D>
+   static void apply(D& data) {
+      if(search_element<get_element<index, DCL>::value, CL>::index==CL::size) data[index] = null_element<element_t>::value();
+      product_table_null_elements<DCL, CL, index+1>::template apply<element_t>(data);
+   }
+};
+template<typename DCL, typename CL, conf_t index>
+struct product_table_null_elements<DCL, CL, index, true>
+{
+   template<typename element_t, typename D>
+   static void apply(D&) { }
+};
+
+template<typename melist, typename metric, typename LCL, typename RCL>
+struct product_table : public flatten_multiplication_element_list<melist, metric, LCL, RCL>::type
+{
+   typedef typename flatten_multiplication_element_list<melist, metric, LCL, RCL>::type list;
+
+   //evaluation of product into multivector storage of configuration DCL, operands indexed by storage index
+   template<typename DCL, typename element_t, typename D, class L, class R>
+   static void evaluate(D& data, const L& l, const R& r) {
+      std::array<element_t, melist::clist::size> acc;
+      product_table_evaluation<list>::apply(acc, l, r);
+      product_table_null_elements<DCL, typename melist::clist>::template apply<element_t>(data);
+      product_table_store<DCL, typename melist::clist, typename make_index_list<melist::clist::size>::type>::apply(data, acc);
+   }
+};
+
+} //end namespace gaalet
+
+#endif
@@ -2,6 +2,7 @@
 #define __GAALET_REVERSE_H
 
 #include "utility.h"
+#include "materialization.h"
 
 namespace gaalet {
 
@@ -14,25 +15,71 @@ struct reverse : public expression<reverse<A>>
    
    typedef typename A::element_t element_t;
 
-   reverse(const A& a_)
+   constexpr reverse(const A& a_)
       :  a(a_)
    { }
 
    template<conf_t conf>
-   element_t element() const {
+   constexpr element_t element() const {
       return a.template element<conf>() * Power<-1, BitCount<conf>::value*(BitCount<conf>::value-1)/2>::value;
    }
 
+   //return element by index, index known at compile time (operand with storage only)
+   template<conf_t index>
+   constexpr element_t get() const {
+      return a.template get<index>() * Power<-1, BitCount<get_element<index, clist>::value>::value*(BitCount<get_element<index, clist>::value>::value-1)/2>::value;
+   }
+
+   void init() {
+      a.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return a.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      a.bind_lane(lane);
+   }
+
 protected:
-   const A& a;
+   typename expression_storage<A>::type a;
+};
+template<class A>
+struct is_cheap_expression<reverse<A>>
+{
+   static const bool value = is_cheap_expression<A>::value;
 };
+template<class A, class D, conf_t conf>
+struct alias_source<reverse<A>, D, conf>
+{
+   static const conf_t value = alias_source<A, D, conf>::value;
+};
+
+//cost model: sign folded
+template<class A, conf_t conf>
+struct element_cost<reverse<A>, conf>
+{
+   typedef typename element_cost<A, conf>::type type;
+};
+
+template<typename CL, typename M, typename T>
+struct has_storage<reverse<multivector<CL, M, T>>>
+{
+   static const bool value = true;
+};
+
+template<typename CL, typename M, typename T> constexpr
+const reverse<multivector<CL, M, T>>& storage_of(const reverse<multivector<CL, M, T>>& r) {
+   return r;
+}
 
 
 }  //end namespace gaalet
 
 /// \brief Reverse of a multivector.
 /// \ingroup ga_ops
-template <class A> inline
+template <class A> constexpr
 gaalet::reverse<A>
 operator~(const gaalet::expression<A>& a) {
    return gaalet::reverse<A>(a);
@@ -0,0 +1,421 @@
+#ifndef __GAALET_REVERSE_AD_H
+#define __GAALET_REVERSE_AD_H
+
+#include "forward_ad.h"
+
+#include <cmath>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace gaalet
+{
+
+namespace ad
+{
+
+/// Tape of reverse-mode automatic differentiation: elementary operations with the partial derivatives by their (up to two) operands.
+/**
+ * Entries live in an arena of fixed-size blocks, kept by clear(): a tape recording the same computation again reuses its memory.
+ */
+template<typename T>
+class tape
+{
+public:
+   //operand index of constants
+   static const std::size_t none = std::size_t(-1);
+
+   struct entry
+   {
+      std::size_t l;
+      std::size_t r;
+      T d_l;
+      T d_r;
+      T adjoint;
+   };
+
+   tape()
+      :  count(0)
+   { }
+
+   //operation with operands l, r and partial derivatives d_l, d_r, index of its result
+   std::size_t record(std::size_t l, const T& d_l, std::size_t r = none, const T& d_r = T(0)) {
+      if(count == blocks.size()*block_size) {
+         blocks.push_back(std::unique_ptr<entry[]>(new entry[block_size]));
+      }
+      entry& e = blocks[count/block_size][count%block_size];
+      e.l = l;
+      e.r = r;
+      e.d_l = d_l;
+      e.d_r = d_r;
+      return count++;
+   }
+
+   //independent variable: entry without operands
+   std::size_t variable() {
+      return record(none, T(0));
+   }
+
+   T& adjoint(std::size_t i) {
+      return blocks[i/block_size][i%block_size].adjoint;
+   }
+   const T& adjoint(std::size_t i) const {
+      return blocks[i/block_size][i%block_size].adjoint;
+   }
+
+   //adjoints zeroed before seeding results
+   void clear_adjoints() {
+      for(std::size_t i = 0; i < count; ++i) {
+         adjoint(i) = T(0);
+      }
+   }
+
+   //adjoints propagated from results to operands, in reverse order of recording
+   void sweep() {
+      for(std::size_t i = count; i-- > 0; ) {
+         const entry& e = blocks[i/block_size][i%block_size];
+         if(e.adjoint == T(0)) continue;
+         if(e.l != none) adjoint(e.l) += e.d_l*e.adjoint;
+         if(e.r != none) adjoint(e.r) += e.d_r*e.adjoint;
+      }
+   }
+
+   //entries dropped, memory kept for next recording
+   void clear() {
+      count = 0;
+   }
+
+   //number of recorded entries
+   std::size_t size() const {
+      return count;
+   }
+
+   //bytes of allocated entries
+   std::size_t memory() const {
+      return blocks.size()*block_size*sizeof(entry);
+   }
+
+protected:
+   static const std::size_t block_size = 4096;
+
+   std::vector<std::unique_ptr<entry[]>> blocks;
+   std::size_t count;
+};
+
+//tape of the calling thread recording all operations on rvar<T> elements
+template<typename T> inline
+tape<T>& active_tape() {
+   static thread_local tape<T> t;
+   return t;
+}
+
+/// Reverse-mode automatic differentiation element type: value of type T with index of its entry on the tape of the thread.
+/**
+ * Usable as element type of an algebra, e.g. algebra<signature<3,0>, ad::rvar<double>>: every elementary operation of an
+ * evaluation is recorded on active_tape<T>(), backward() propagates adjoints of results to all independent variables at once.
+ * Constants are not recorded.
+ */
+template<typename T>
+struct rvar
+{
+   typedef T value_type;
+
+   constexpr rvar()
+      :  value(0), index(tape<T>::none)
+   { }
+
+   constexpr rvar(const T& v)
+      :  value(v), index(tape<T>::none)
+   { }
+
+   constexpr rvar(const T& v, std::size_t index_)
+      :  value(v), index(index_)
+   { }
+
+   rvar& operator+=(const rvar& a) {
+      return *this = *this + a;
+   }
+   rvar& operator-=(const rvar& a) {
+      return *this = *this - a;
+   }
+   rvar& operator*=(const rvar& a) {
+      return *this = *this * a;
+   }
+   rvar& operator/=(const rvar& a) {
+      return *this = *this / a;
+   }
+
+   T value;
+   std::size_t index;
+};
+
+/// Independent variable of value v recorded on the tape of the thread.
+template<typename T> inline
+rvar<T> variable(const T& v) {
+   return rvar<T>(v, active_tape<T>().variable());
+}
+
+//value f(a) with derivative df by value of a: recorded unless a is constant
+template<typename T> inline
+rvar<T> chain(const rvar<T>& a, const T& f, const T& df) {
+   return (a.index == tape<T>::none) ? rvar<T>(f) : rvar<T>(f, active_tape<T>().record(a.index, df));
+}
+template<typename T> inline
+rvar<T> chain(const rvar<T>& l, const rvar<T>& r, const T& f, const T& d_l, const T& d_r) {
+   return (l.index == tape<T>::none && r.index == tape<T>::none) ? rvar<T>(f)
+                                                                 : rvar<T>(f, active_tape<T>().record(l.index, d_l, r.index, d_r));
+}
+
+//arithmetic
+template<typename T> inline
+rvar<T> operator+(const rvar<T>& l, const rvar<T>& r) {
+   return chain(l, r, l.value + r.value, T(1), T(1));
+}
+template<typename T> inline
+rvar<T> operator-(const rvar<T>& l, const rvar<T>& r) {
+   return chain(l, r, l.value - r.value, T(1), T(-1));
+}
+template<typename T> inline
+rvar<T> operator*(const rvar<T>& l, const rvar<T>& r) {
+   return chain(l, r, l.value*r.value, r.value, l.value);
+}
+template<typename T> inline
+rvar<T> operator/(const rvar<T>& l, const rvar<T>& r) {
+   const T inv_r = T(1)/r.value;
+   const T q = l.value*inv_r;
+   return chain(l, r, q, inv_r, -q*inv_r);
+}
+
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator+(const rvar<T>& l, S r) {
+   return chain(l, l.value + T(r), T(1));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator+(S l, const rvar<T>& r) {
+   return chain(r, T(l) + r.value, T(1));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator-(const rvar<T>& l, S r) {
+   return chain(l, l.value - T(r), T(1));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator-(S l, const rvar<T>& r) {
+   return chain(r, T(l) - r.value, T(-1));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator*(const rvar<T>& l, S r) {
+   return chain(l, l.value*T(r), T(r));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator*(S l, const rvar<T>& r) {
+   return chain(r, T(l)*r.value, T(l));
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator/(const rvar<T>& l, S r) {
+   const T inv_r = T(1)/T(r);
+   return chain(l, l.value*inv_r, inv_r);
+}
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+operator/(S l, const rvar<T>& r) {
+   const T q = T(l)/r.value;
+   return chain(r, q, -q/r.value);
+}
+
+template<typename T> inline
+rvar<T> operator-(const rvar<T>& a) {
+   return chain(a, -a.value, T(-1));
+}
+
+//comparison of values
+#define GAALET_RVAR_COMPARISON(op) \
+template<typename T> inline \
+bool operator op(const rvar<T>& l, const rvar<T>& r) { \
+   return l.value op r.value; \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(const rvar<T>& l, S r) { \
+   return l.value op T(r); \
+} \
+template<typename T, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, bool>::type \
+operator op(S l, const rvar<T>& r) { \
+   return T(l) op r.value; \
+}
+GAALET_RVAR_COMPARISON(==)
+GAALET_RVAR_COMPARISON(!=)
+GAALET_RVAR_COMPARISON(<)
+GAALET_RVAR_COMPARISON(<=)
+GAALET_RVAR_COMPARISON(>)
+GAALET_RVAR_COMPARISON(>=)
+#undef GAALET_RVAR_COMPARISON
+
+//functions: value y = f(x) and derivative by x
+#define GAALET_RVAR_FUNCTION(f, df) \
+template<typename T> inline \
+rvar<T> f(const rvar<T>& a) { \
+   const T x = a.value; \
+   const T y = std::f(x); \
+   return chain(a, y, T(df)); \
+}
+GAALET_RVAR_FUNCTION(sqrt, 0.5/y)
+GAALET_RVAR_FUNCTION(sin, std::cos(x))
+GAALET_RVAR_FUNCTION(cos, -std::sin(x))
+GAALET_RVAR_FUNCTION(tan, 1.0 + y*y)
+GAALET_RVAR_FUNCTION(asin, 1.0/std::sqrt(1.0 - x*x))
+GAALET_RVAR_FUNCTION(acos, -1.0/std::sqrt(1.0 - x*x))
+GAALET_RVAR_FUNCTION(atan, 1.0/(1.0 + x*x))
+GAALET_RVAR_FUNCTION(sinh, std::cosh(x))
+GAALET_RVAR_FUNCTION(cosh, std::sinh(x))
+GAALET_RVAR_FUNCTION(tanh, 1.0 - y*y)
+GAALET_RVAR_FUNCTION(exp, y)
+GAALET_RVAR_FUNCTION(log, 1.0/x)
+GAALET_RVAR_FUNCTION(fabs, (x < 0.0) ? -1.0 : 1.0)
+#undef GAALET_RVAR_FUNCTION
+
+template<typename T, typename S> inline
+typename std::enable_if<std::is_arithmetic<S>::value, rvar<T>>::type
+pow(const rvar<T>& a, S p) {
+   return chain(a, T(std::pow(a.value, T(p))), T(p*std::pow(a.value, T(p) - 1)));
+}
+
+//element functions of the multivector functions with their derivatives, also at the branch points (derivatives shared with fvar)
+template<typename T> inline
+void cosh_sinhc_sqrt(const rvar<T>& s, rvar<T>& c, rvar<T>& sc) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   c = chain(s, c_v, T(0.5*sc_v));
+   sc = chain(s, sc_v, sinhc_sqrt_derivative(s.value, c_v, sc_v));
+}
+
+template<typename T> inline
+rvar<T> cosh_sqrt(const rvar<T>& s) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   return chain(s, c_v, T(0.5*sc_v));
+}
+
+template<typename T> inline
+rvar<T> sinhc_sqrt(const rvar<T>& s) {
+   T c_v, sc_v;
+   gaalet::cosh_sinhc_sqrt(s.value, c_v, sc_v);
+   return chain(s, sc_v, sinhc_sqrt_derivative(s.value, c_v, sc_v));
+}
+
+template<typename T> inline
+rvar<T> atan2_div_sqrt(const rvar<T>& r, const rvar<T>& q) {
+   const T g = gaalet::atan2_div_sqrt(r.value, q.value);
+   T dg_dr, dg_dq;
+   atan2_div_sqrt_derivatives(r.value, q.value, g, dg_dr, dg_dq);
+   return chain(r, q, g, dg_dr, dg_dq);
+}
+
+template<class E, class TR, typename T>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const rvar<T>& a)
+{
+   os << a.value;
+   return os;
+}
+
+/// Adjoint of a: derivative of the seeded results by a after backward().
+template<typename T> inline
+T adjoint(const rvar<T>& a) {
+   return (a.index == tape<T>::none) ? T(0) : active_tape<T>().adjoint(a.index);
+}
+
+/// Reverse sweep from scalar result y: adjoints of all recorded variables are derivatives of y.
+template<typename T> inline
+void backward(const rvar<T>& y) {
+   tape<T>& t = active_tape<T>();
+   t.clear_adjoints();
+   if(y.index != tape<T>::none) {
+      t.adjoint(y.index) = T(1);
+   }
+   t.sweep();
+}
+
+/// Reverse sweep from multivector result y weighted by seed: adjoints are derivatives of the sum of seed[k]*y[k].
+template<typename CL, typename M, typename T> inline
+void backward(const multivector<CL, M, rvar<T>>& y, const multivector<CL, M, T>& seed)
+{
+   tape<T>& t = active_tape<T>();
+   t.clear_adjoints();
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      if(y[k].index != tape<T>::none) {
+         t.adjoint(y[k].index) += seed[k];
+      }
+   }
+   t.sweep();
+}
+
+/// Multivector of independent variables recorded on the tape of the thread.
+template<typename CL, typename M, typename T> inline
+multivector<CL, M, rvar<T>> independent(const multivector<CL, M, T>& m)
+{
+   multivector<CL, M, rvar<T>> v;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      v[k] = variable(m[k]);
+   }
+   return v;
+}
+
+/// Values of the elements of a multivector of rvar elements.
+template<typename CL, typename M, typename T> inline
+multivector<CL, M, T> values(const multivector<CL, M, rvar<T>>& m)
+{
+   multivector<CL, M, T> v;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      v[k] = m[k].value;
+   }
+   return v;
+}
+
+/// Adjoints of the elements of a multivector of rvar elements after backward(): gradient by these variables.
+template<typename CL, typename M, typename T> inline
+multivector<CL, M, T> gradient(const multivector<CL, M, rvar<T>>& m)
+{
+   multivector<CL, M, T> g;
+   for(unsigned int k = 0; k < CL::size; ++k) {
+      g[k] = adjoint(m[k]);
+   }
+   return g;
+}
+
+}  //end namespace ad
+
+//element type combination: rvar elements dominate plain scalars
+template<typename T, typename E>
+struct element_type_combination_traits<ad::rvar<T>, E>
+{
+   typedef ad::rvar<T> element_t;
+};
+template<typename E, typename T>
+struct element_type_combination_traits<E, ad::rvar<T>>
+{
+   typedef ad::rvar<T> element_t;
+};
+template<typename T>
+struct element_type_combination_traits<ad::rvar<T>, ad::rvar<T>>
+{
+   typedef ad::rvar<T> element_t;
+};
+
+template<typename T>
+struct null_element<ad::rvar<T>> {
+   static constexpr ad::rvar<T> value() {
+      return ad::rvar<T>();
+   }
+};
+
+} //end namespace gaalet
+
+#endif
@@ -0,0 +1,800 @@
+#ifndef __GAALET_SANDWICH_H
+#define __GAALET_SANDWICH_H
+
+#include "utility.h"
+#include "materialization.h"
+#include "geometric_product.h"
+#include "product_table.h"
+
+#include <type_traits>
+#include <array>
+
+namespace gaalet
+{
+
+namespace sw
+{
+
+//list of types
+template<class... T>
+struct type_list
+{
+   static const conf_t size = sizeof...(T);
+};
+
+template<class list, class E>
+struct append_type;
+template<class... T, class E>
+struct append_type<type_list<T...>, E>
+{
+   typedef type_list<T..., E> type;
+};
+
+template<class list, class E>
+struct prepend_type;
+template<class... T, class E>
+struct prepend_type<type_list<T...>, E>
+{
+   typedef type_list<E, T...> type;
+};
+
+//sign of element multiplication e_i*e_k*~e_j, zero if the multiplication vanishes in a degenerate metric
+template<typename metric>
+constexpr int term_sign_value(conf_t i, conf_t k, conf_t j) {
+   return ((metric::degenerate_bitmap&(i&k)) || (metric::degenerate_bitmap&((i^k)&j))) ? 0
+          : canonical_reordering_sign(i, k)
+            *((bit_count(metric::signature_bitmap&(i&k)) % 2) ? -1 : 1)
+            *canonical_reordering_sign(i^k, j)
+            *((bit_count(metric::signature_bitmap&((i^k)&j)) % 2) ? -1 : 1)
+            *power(-1, bit_count(j)*(bit_count(j)-1)/2);
+}
+
+template<conf_t I, conf_t K, conf_t J, typename metric>
+struct term_sign
+{
+   static const int value = term_sign_value<metric>(I, K, J);
+};
+
+//coefficient of v_i*v_j in the symmetric quadratic form: terms e_i*e_k*~e_j and e_j*e_k*~e_i are collected
+template<typename metric>
+constexpr int quadratic_coefficient_value(conf_t i, conf_t k, conf_t j) {
+   return (i==j) ? term_sign_value<metric>(i, k, j) : (term_sign_value<metric>(i, k, j) + term_sign_value<metric>(j, k, i));
+}
+
+template<conf_t I, conf_t K, conf_t J, typename metric>
+struct quadratic_coefficient
+{
+   static const int value = quadratic_coefficient_value<metric>(I, K, J);
+};
+
+//v_i*v_j*coefficient, indices are storage indices in configuration list of V
+template<conf_t I, conf_t J, conf_t II, conf_t JI, int C>
+struct quadratic_term
+{
+   static const conf_t left = I;
+   static const conf_t right = J;
+   static const conf_t left_index = II;
+   static const conf_t right_index = JI;
+   static const int coefficient = C;
+};
+
+//matrix element of the sandwich map: quadratic form in elements of V, multiplied by element K of X
+template<conf_t K, conf_t KI, class form>
+struct matrix_element
+{
+   static const conf_t conf = K;
+   static const conf_t index = KI;
+   typedef form terms;
+};
+
+//result element C: row of matrix elements
+template<conf_t C, class elements>
+struct matrix_row
+{
+   static const conf_t conf = C;
+   typedef elements columns;
+};
+
+//quadratic form of matrix element (C, K): pairs i<=j with i^k^j=C and non-vanishing coefficient
+// --- by recursion through configuration list of V
+template<conf_t C, conf_t K, typename VCL, typename metric, typename L = VCL, conf_t index = 0, typename list = type_list<>, bool end = (L::size==0)>
+struct quadratic_form_elements
+{
+   static const conf_t left = L::head;
+   static const conf_t right = L::head^K^C;
+   static const conf_t right_index = search_element<right, VCL>::index;
+   static const int coefficient = quadratic_coefficient<left, K, right, metric>::value;
+
+   typedef typename std::conditional<(right_index<VCL::size) && (right_index>=index) && (coefficient!=0),
+                                     typename append_type<list, quadratic_term<left, right, index, right_index, coefficient>>::type,
+                                     list>::type head_list;
+
+   typedef typename quadratic_form_elements<C, K, VCL, metric, typename L::tail, index+1, head_list>::type type;
+};
+template<conf_t C, conf_t K, typename VCL, typename metric, typename L, conf_t index, typename list>
+struct quadratic_form_elements<C, K, VCL, metric, L, index, list, true>
+{
+   typedef list type;
+};
+
+// --- flat configuration list of V: bitmap b of left elements of terms
+template<typename metric>
+constexpr conf_t quadratic_form_bits(conf_t c, conf_t k, conf_t v, conf_t b) {
+   return b ? (((bit_test(v, lowest_bit(b)^k^c) && (lowest_bit(b)^k^c)>=lowest_bit(b)
+                 && quadratic_coefficient_value<metric>(lowest_bit(b), k, lowest_bit(b)^k^c)!=0) ? (b & (~b+1)) : 0)
+               | quadratic_form_bits<metric>(c, k, v, b & (b-1))) : 0;
+}
+
+template<conf_t C, conf_t K, typename VCL, typename metric, conf_t B, bool end = (B==0)>
+struct quadratic_form_bitmap
+{
+   static const conf_t left = lowest_bit(B);
+   static const conf_t right = left^K^C;
+
+   typedef typename prepend_type<typename quadratic_form_bitmap<C, K, VCL, metric, (B & (B-1))>::type,
+                                 quadratic_term<left, right, bit_rank(VCL::bitmap, left), bit_rank(VCL::bitmap, right),
+                                                quadratic_coefficient<left, K, right, metric>::value>>::type type;
+};
+template<conf_t C, conf_t K, typename VCL, typename metric, conf_t B>
+struct quadratic_form_bitmap<C, K, VCL, metric, B, true>
+{
+   typedef type_list<> type;
+};
+
+template<conf_t C, conf_t K, typename VCL, typename metric, bool flat = (VCL::flat && C<64 && K<64)>
+struct build_quadratic_form
+{
+   typedef typename quadratic_form_bitmap<C, K, VCL, metric, quadratic_form_bits<metric>(C, K, VCL::bitmap, VCL::bitmap)>::type type;
+};
+template<conf_t C, conf_t K, typename VCL, typename metric>
+struct build_quadratic_form<C, K, VCL, metric, false>
+{
+   typedef typename quadratic_form_elements<C, K, VCL, metric>::type type;
+};
+
+//row of result element C: non-vanishing matrix elements over the elements of X
+// --- by recursion through configuration list of X
+template<conf_t C, typename VCL, typename XCL, typename metric, typename L = XCL, conf_t index = 0, typename list = type_list<>, bool end = (L::size==0)>
+struct matrix_row_elements
+{
+   typedef typename build_quadratic_form<C, L::head, VCL, metric>::type form;
+
+   typedef typename std::conditional<(form::size>0),
+                                     typename append_type<list, matrix_element<L::head, index, form>>::type,
+                                     list>::type head_list;
+
+   typedef typename matrix_row_elements<C, VCL, XCL, metric, typename L::tail, index+1, head_list>::type type;
+};
+template<conf_t C, typename VCL, typename XCL, typename metric, typename L, conf_t index, typename list>
+struct matrix_row_elements<C, VCL, XCL, metric, L, index, list, true>
+{
+   typedef list type;
+};
+
+// --- flat configuration lists: bitmap of elements of X with non-vanishing matrix element
+template<typename metric>
+constexpr conf_t matrix_row_bits(conf_t c, conf_t v, conf_t x) {
+   return x ? ((quadratic_form_bits<metric>(c, lowest_bit(x), v, v) ? (x & (~x+1)) : 0) | matrix_row_bits<metric>(c, v, x & (x-1))) : 0;
+}
+
+template<conf_t C, typename VCL, typename XCL, typename metric, conf_t B, bool end = (B==0)>
+struct matrix_row_bitmap
+{
+   typedef typename prepend_type<typename matrix_row_bitmap<C, VCL, XCL, metric, (B & (B-1))>::type,
+                                 matrix_element<lowest_bit(B), bit_rank(XCL::bitmap, lowest_bit(B)),
+                                                typename build_quadratic_form<C, lowest_bit(B), VCL, metric>::type>>::type type;
+};
+template<conf_t C, typename VCL, typename XCL, typename metric, conf_t B>
+struct matrix_row_bitmap<C, VCL, XCL, metric, B, true>
+{
+   typedef type_list<> type;
+};
+
+template<conf_t C, typename VCL, typename XCL, typename metric, bool flat = (VCL::flat && XCL::flat && C<64)>
+struct build_matrix_row
+{
+   typedef typename matrix_row_bitmap<C, VCL, XCL, metric, matrix_row_bits<metric>(C, VCL::bitmap, XCL::bitmap)>::type type;
+};
+template<conf_t C, typename VCL, typename XCL, typename metric>
+struct build_matrix_row<C, VCL, XCL, metric, false>
+{
+   typedef typename matrix_row_elements<C, VCL, XCL, metric>::type type;
+};
+
+//bitmap of grades of elements of bitmap b
+constexpr conf_t grade_set_bits(conf_t b) {
+   return b ? ((conf_t(1)<<bit_count(lowest_bit(b))) | grade_set_bits(b & (b-1))) : 0;
+}
+
+//bitmap of grades in a configuration list
+template<typename CL, bool flat = CL::flat>
+struct grade_bitmap
+{
+   static const conf_t value = grade_set_bits(CL::bitmap);
+};
+template<typename CL>
+struct grade_bitmap<CL, false>
+{
+   static const conf_t value = (conf_t(1)<<BitCount<CL::head>::value) | grade_bitmap<typename CL::tail>::value;
+};
+
+//rows of candidate result elements L, restricted to grades of X and non-vanishing rows
+// --- by recursion through candidate list
+template<typename VCL, typename XCL, typename metric, typename L, bool end = (L::size==0),
+         bool in_grade = ((grade_bitmap<XCL>::value>>BitCount<L::head>::value) & 1)>
+struct matrix_elements
+{
+   typedef matrix_elements<VCL, XCL, metric, typename L::tail> tail_matrix;
+
+   typedef typename build_matrix_row<L::head, VCL, XCL, metric>::type row;
+
+   typedef typename std::conditional<(row::size>0),
+                                     configuration_list<L::head, typename tail_matrix::clist>,
+                                     typename tail_matrix::clist>::type clist;
+   typedef typename std::conditional<(row::size>0),
+                                     typename prepend_type<typename tail_matrix::rows, matrix_row<L::head, row>>::type,
+                                     typename tail_matrix::rows>::type rows;
+};
+template<typename VCL, typename XCL, typename metric, typename L>
+struct matrix_elements<VCL, XCL, metric, L, false, false>
+{
+   typedef matrix_elements<VCL, XCL, metric, typename L::tail> tail_matrix;
+
+   typedef typename tail_matrix::clist clist;
+   typedef typename tail_matrix::rows rows;
+};
+template<typename VCL, typename XCL, typename metric, typename L, bool in_grade>
+struct matrix_elements<VCL, XCL, metric, L, true, in_grade>
+{
+   typedef cl_null clist;
+   typedef type_list<> rows;
+};
+
+// --- flat configuration lists: bitmap of candidates l with grade in grades of X and non-vanishing row
+template<typename metric>
+constexpr conf_t matrix_bits(conf_t v, conf_t x, conf_t l) {
+   return l ? (((((grade_set_bits(x)>>bit_count(lowest_bit(l))) & 1) && matrix_row_bits<metric>(lowest_bit(l), v, x)) ? (l & (~l+1)) : 0)
+               | matrix_bits<metric>(v, x, l & (l-1))) : 0;
+}
+
+template<typename VCL, typename XCL, typename metric, conf_t B, bool end = (B==0)>
+struct matrix_bitmap
+{
+   typedef typename prepend_type<typename matrix_bitmap<VCL, XCL, metric, (B & (B-1))>::rows,
+                                 matrix_row<lowest_bit(B), typename build_matrix_row<lowest_bit(B), VCL, XCL, metric>::type>>::type rows;
+};
+template<typename VCL, typename XCL, typename metric, conf_t B>
+struct matrix_bitmap<VCL, XCL, metric, B, true>
+{
+   typedef type_list<> rows;
+};
+
+template<typename VCL, typename XCL, typename metric, typename L, bool flat = (VCL::flat && XCL::flat && L::flat)>
+struct build_matrix
+{
+   static const conf_t bits = matrix_bits<metric>(VCL::bitmap, XCL::bitmap, L::bitmap);
+
+   typedef typename bitmap_clist<bits>::clist clist;
+   typedef typename matrix_bitmap<VCL, XCL, metric, bits>::rows rows;
+};
+template<typename VCL, typename XCL, typename metric, typename L>
+struct build_matrix<VCL, XCL, metric, L, false>
+{
+   typedef typename matrix_elements<VCL, XCL, metric, L>::clist clist;
+   typedef typename matrix_elements<VCL, XCL, metric, L>::rows rows;
+};
+
+//operand access by configuration (expressions) or by storage index (multivector storage)
+struct conf_access
+{
+   template<typename element_t, conf_t conf, conf_t index, class E>
+   static constexpr element_t read(const E& e) {
+      return e.template element<conf>();
+   }
+};
+struct index_access
+{
+   template<typename element_t, conf_t conf, conf_t index, class E>
+   static constexpr element_t read(const E& e) {
+      return e.template get<index>();
+   }
+};
+
+//sum of quadratic form
+template<class list>
+struct quadratic_sum;
+template<>
+struct quadratic_sum<type_list<>>
+{
+   template<typename element_t, class access, class V>
+   static constexpr element_t eval(const V&) {
+      return null_element<element_t>::value();
+   }
+};
+template<class T>
+struct quadratic_sum<type_list<T>>
+{
+   template<typename element_t, class access, class V>
+   static constexpr element_t eval(const V& v) {
+      return access::template read<element_t, T::left, T::left_index>(v)*access::template read<element_t, T::right, T::right_index>(v)*T::coefficient;
+   }
+};
+template<class T, class... TT>
+struct quadratic_sum<type_list<T, TT...>>
+{
+   template<typename element_t, class access, class V>
+   static constexpr element_t eval(const V& v) {
+      return access::template read<element_t, T::left, T::left_index>(v)*access::template read<element_t, T::right, T::right_index>(v)*T::coefficient
+             + quadratic_sum<type_list<TT...>>::template eval<element_t, access>(v);
+   }
+};
+
+//matrix element as quadratic form in elements of V
+struct quadratic_form_element
+{
+   template<typename element_t, class access, class R, class E, class V>
+   static constexpr element_t eval(const V& v) {
+      return quadratic_sum<typename E::terms>::template eval<element_t, access>(v);
+   }
+};
+
+//sum of matrix row R times elements of X, matrix elements evaluated by policy M from operand V
+template<class R, class M, class list = typename R::columns>
+struct row_sum;
+template<class R, class M, class E>
+struct row_sum<R, M, type_list<E>>
+{
+   template<typename element_t, class access, class V, class X>
+   static constexpr element_t eval(const V& v, const X& x) {
+      return access::template read<element_t, E::conf, E::index>(x)*M::template eval<element_t, access, R, E>(v);
+   }
+};
+template<class R, class M, class E, class... EE>
+struct row_sum<R, M, type_list<E, EE...>>
+{
+   template<typename element_t, class access, class V, class X>
+   static constexpr element_t eval(const V& v, const X& x) {
+      return access::template read<element_t, E::conf, E::index>(x)*M::template eval<element_t, access, R, E>(v)
+             + row_sum<R, M, type_list<EE...>>::template eval<element_t, access>(v, x);
+   }
+};
+
+//search row of result element
+template<conf_t conf, class rows, class M>
+struct search_row;
+template<conf_t conf, class M>
+struct search_row<conf, type_list<>, M>
+{
+   template<typename element_t, class access, class V, class X>
+   static constexpr element_t eval(const V&, const X&) {
+      return null_element<element_t>::value();
+   }
+};
+template<conf_t conf, class R, class... RR, class M>
+struct search_row<conf, type_list<R, RR...>, M>
+{
+   template<typename element_t, class access, class V, class X>
+   static constexpr element_t eval(const V& v, const X& x) {
+      return (conf==R::conf) ? row_sum<R, M>::template eval<element_t, access>(v, x)
+                             : search_row<conf, type_list<RR...>, M>::template eval<element_t, access>(v, x);
+   }
+};
+
+//number of quadratic terms of a row
+template<class list>
+struct term_count;
+template<>
+struct term_count<type_list<>>
+{
+   static const conf_t value = 0;
+};
+template<class E, class... EE>
+struct term_count<type_list<E, EE...>>
+{
+   static const conf_t value = E::terms::size + term_count<type_list<EE...>>::value;
+};
+
+//number of quadratic terms and matrix elements of all rows
+template<class rows>
+struct matrix_count;
+template<>
+struct matrix_count<type_list<>>
+{
+   static const conf_t terms = 0;
+   static const conf_t elements = 0;
+};
+template<class R, class... RR>
+struct matrix_count<type_list<R, RR...>>
+{
+   static const conf_t terms = term_count<typename R::columns>::value + matrix_count<type_list<RR...>>::terms;
+   static const conf_t elements = R::columns::size + matrix_count<type_list<RR...>>::elements;
+};
+
+//row evaluation into multivector storage of configuration DCL
+template<typename DCL, class R, class M, bool in_destination = (search_element<R::conf, DCL>::index<DCL::size)>
+struct row_step
+{
+   template<typename element_t, typename D, class V, class X>
+   static void apply(D& data, const V& v, const X& x) {
+      std::get<search_element<R::conf, DCL>::index>(data) = row_sum<R, M>::template eval<element_t, index_access>(v, x);
+   }
+};
+template<typename DCL, class R, class M>
+struct row_step<DCL, R, M, false>
+{
+   template<typename element_t, typename D, class V, class X>
+   static void apply(D&, const V&, const X&) { }
+};
+
+//evaluation of matrix rows times elements of X, matrix elements evaluated by policy M
+template<class matrix, class M>
+struct matrix_kernel
+{
+   typedef typename matrix::clist clist;
+   typedef typename matrix::rows rows;
+
+   template<conf_t conf, typename element_t, class V, class X>
+   static constexpr element_t element(const V& v, const X& x) {
+      return search_row<conf, rows, M>::template eval<element_t, conf_access>(v, x);
+   }
+
+   template<typename DCL, typename element_t, typename D, class V, class X>
+   static void evaluate(D& data, const V& v, const X& x) {
+      product_table_null_elements<DCL, clist>::template apply<element_t>(data);
+      evaluate_rows<DCL, element_t>(data, v, x, rows());
+   }
+
+protected:
+   template<typename DCL, typename element_t, typename D, class V, class X, class... R>
+   static void evaluate_rows(D& data, const V& v, const X& x, type_list<R...>) {
+      typedef int swallow[];
+      (void)swallow{0, (row_step<DCL, R, M>::template apply<element_t>(data, v, x), 0)...};
+   }
+};
+
+//cost model of matrix kernels: matrix element policy M
+template<class M, class E, class V>
+struct matrix_element_cost;
+
+//quadratic form: one multiplication per term, one more for coefficients other than plus or minus one
+template<class list, class V>
+struct quadratic_sum_cost;
+template<class V>
+struct quadratic_sum_cost<type_list<>, V>
+{
+   typedef operations<> type;
+};
+template<class T, class... TT, class V>
+struct quadratic_sum_cost<type_list<T, TT...>, V>
+{
+   typedef typename operations_sum<typename element_cost<V, T::left>::type, typename element_cost<V, T::right>::type,
+                                   operations<(sizeof...(TT)>0) ? 1 : 0, (T::coefficient==1 || T::coefficient==-1) ? 1 : 2>,
+                                   typename quadratic_sum_cost<type_list<TT...>, V>::type>::type type;
+};
+
+template<class E, class V>
+struct matrix_element_cost<quadratic_form_element, E, V>
+{
+   typedef typename quadratic_sum_cost<typename E::terms, V>::type type;
+};
+
+//row: matrix elements times elements of X, summed
+template<class list, class M, class V, class X>
+struct row_sum_cost;
+template<class M, class V, class X>
+struct row_sum_cost<type_list<>, M, V, X>
+{
+   typedef operations<> type;
+};
+template<class E, class... EE, class M, class V, class X>
+struct row_sum_cost<type_list<E, EE...>, M, V, X>
+{
+   typedef typename operations_sum<typename element_cost<X, E::conf>::type, typename matrix_element_cost<M, E, V>::type,
+                                   operations<(sizeof...(EE)>0) ? 1 : 0, 1>,
+                                   typename row_sum_cost<type_list<EE...>, M, V, X>::type>::type type;
+};
+
+//row of result element conf, none if not in rows
+template<conf_t conf, class rows, class M, class V, class X>
+struct search_row_cost;
+template<conf_t conf, class M, class V, class X>
+struct search_row_cost<conf, type_list<>, M, V, X>
+{
+   typedef operations<> type;
+};
+template<conf_t conf, class R, class... RR, class M, class V, class X>
+struct search_row_cost<conf, type_list<R, RR...>, M, V, X>
+{
+   typedef typename std::conditional<(conf==R::conf), row_sum_cost<typename R::columns, M, V, X>,
+                                     search_row_cost<conf, type_list<RR...>, M, V, X>>::type::type type;
+};
+
+//matrix element read from precomputed map
+struct map_element
+{
+   template<typename element_t, class access, class R, class E, class M>
+   static element_t eval(const M& m) {
+      return m.template coefficient<R::conf, E::conf>();
+   }
+};
+
+//cost model: precomputed matrix elements are loads
+template<class E, class M>
+struct matrix_element_cost<map_element, E, M>
+{
+   typedef operations<> type;
+};
+
+//position of matrix element (C, K) in storage of all non-vanishing matrix elements, rows in order
+template<conf_t K, class columns, conf_t offset>
+struct column_position;
+template<conf_t K, class E, class... EE, conf_t offset>
+struct column_position<K, type_list<E, EE...>, offset>
+{
+   static const conf_t value = std::conditional<(E::conf==K), std::integral_constant<conf_t, offset>,
+                                                column_position<K, type_list<EE...>, offset+1>>::type::value;
+};
+
+template<conf_t C, conf_t K, class rows, conf_t offset = 0>
+struct matrix_position;
+template<conf_t C, conf_t K, class R, class... RR, conf_t offset>
+struct matrix_position<C, K, type_list<R, RR...>, offset>
+{
+   static const conf_t value = std::conditional<(R::conf==C), column_position<K, typename R::columns, offset>,
+                                                matrix_position<C, K, type_list<RR...>, offset+R::columns::size>>::type::value;
+};
+
+//evaluation of quadratic forms of all matrix elements into storage, positions as by matrix_position
+template<class columns, conf_t offset>
+struct matrix_cache_row;
+template<conf_t offset>
+struct matrix_cache_row<type_list<>, offset>
+{
+   template<typename element_t, class access, typename D, class V>
+   static void apply(D&, const V&) { }
+};
+template<class E, class... EE, conf_t offset>
+struct matrix_cache_row<type_list<E, EE...>, offset>
+{
+   template<typename element_t, class access, typename D, class V>
+   static void apply(D& m, const V& v) {
+      std::get<offset>(m) = quadratic_sum<typename E::terms>::template eval<element_t, access>(v);
+      matrix_cache_row<type_list<EE...>, offset+1>::template apply<element_t, access>(m, v);
+   }
+};
+
+template<class rows, conf_t offset = 0>
+struct matrix_cache;
+template<conf_t offset>
+struct matrix_cache<type_list<>, offset>
+{
+   template<typename element_t, class access, typename D, class V>
+   static void apply(D&, const V&) { }
+};
+template<class R, class... RR, conf_t offset>
+struct matrix_cache<type_list<R, RR...>, offset>
+{
+   template<typename element_t, class access, typename D, class V>
+   static void apply(D& m, const V& v) {
+      matrix_cache_row<typename R::columns, offset>::template apply<element_t, access>(m, v);
+      matrix_cache<type_list<RR...>, offset+R::columns::size>::template apply<element_t, access>(m, v);
+   }
+};
+
+//cost model: quadratic forms of all matrix elements
+template<class columns, class V>
+struct matrix_cache_row_cost;
+template<class V>
+struct matrix_cache_row_cost<type_list<>, V>
+{
+   typedef operations<> type;
+};
+template<class E, class... EE, class V>
+struct matrix_cache_row_cost<type_list<E, EE...>, V>
+{
+   typedef typename operations_sum<typename matrix_element_cost<quadratic_form_element, E, V>::type,
+                                   typename matrix_cache_row_cost<type_list<EE...>, V>::type>::type type;
+};
+
+template<class rows, class V>
+struct matrix_cache_cost;
+template<class V>
+struct matrix_cache_cost<type_list<>, V>
+{
+   typedef operations<> type;
+};
+template<class R, class... RR, class V>
+struct matrix_cache_cost<type_list<R, RR...>, V>
+{
+   typedef typename operations_sum<typename matrix_cache_row_cost<typename R::columns, V>::type,
+                                   typename matrix_cache_cost<type_list<RR...>, V>::type>::type type;
+};
+
+//rows of sandwich map x -> v*x*~v over elements of X
+template<typename VCL, typename XCL, typename metric>
+struct sandwich_matrix
+{
+   typedef typename build_product_melist<gp::product<metric>, VCL, XCL>::melist::clist vx_clist;
+   typedef typename build_product_melist<gp::product<metric>, vx_clist, VCL>::melist::clist vxv_clist;
+
+   typedef typename build_matrix<VCL, XCL, metric, vxv_clist>::clist clist;
+   typedef typename build_matrix<VCL, XCL, metric, vxv_clist>::rows rows;
+
+   //number of quadratic terms v_i*v_j (matrix elements) and of multiplications x_k*m_ck (matrix-vector product)
+   static const conf_t terms = matrix_count<rows>::terms;
+   static const conf_t matrix_elements = matrix_count<rows>::elements;
+};
+
+//sandwich map with cached matrix: quadratic forms in elements of V evaluated once into storage of matrix elements
+template<typename VCL, typename XCL, typename metric>
+struct sandwich_kernel : public sandwich_matrix<VCL, XCL, metric>, public matrix_kernel<sandwich_matrix<VCL, XCL, metric>, map_element>
+{
+   typedef typename sandwich_matrix<VCL, XCL, metric>::clist clist;
+   typedef typename sandwich_matrix<VCL, XCL, metric>::rows rows;
+
+   template<typename element_t>
+   struct matrix_storage
+   {
+      typedef std::array<element_t, sandwich_matrix<VCL, XCL, metric>::matrix_elements> type;
+   };
+
+   template<typename element_t, typename D, class V>
+   static void evaluate_matrix(D& m, const V& v) {
+      matrix_cache<rows>::template apply<element_t, conf_access>(m, v);
+   }
+
+   template<conf_t C, conf_t K>
+   struct position
+   {
+      static const conf_t value = matrix_position<C, K, rows>::value;
+   };
+};
+
+//grades of a versor: all even or all odd
+constexpr bool single_parity_grades(conf_t grades) {
+   return !(grades & (~conf_t(0)/3)) || !(grades & ((~conf_t(0)/3)<<1));
+}
+
+//storage of operand V: read by every quadratic term, thus materialized if not cheap
+template<class E, bool materialize = !is_cheap_expression<E>::value>
+struct versor_storage
+{
+   typedef typename expression_storage<E>::type type;
+};
+template<class E>
+struct versor_storage<E, true>
+{
+   typedef materialization<E> type;
+};
+
+//storage of operand X: read once per result element, follows global materialization policy
+template<class E, conf_t rows, bool materialize = (GAALET_AUTO_MATERIALIZATION && !is_cheap_expression<E>::value && (rows>1))>
+struct operand_storage
+{
+   typedef typename expression_storage<E>::type type;
+};
+template<class E, conf_t rows>
+struct operand_storage<E, rows, true>
+{
+   typedef materialization<E> type;
+};
+
+} //end namespace sw
+
+template<class V, class X>
+struct sandwich : public expression<sandwich<V, X>>
+{
+   static_assert(sw::single_parity_grades(sw::grade_bitmap<typename V::clist>::value), "sw::apply(): v of even and odd grades not a versor");
+
+   typedef typename element_type_combination_traits<typename V::element_t, typename X::element_t>::element_t element_t;
+   typedef typename metric_combination_traits<typename V::metric, typename X::metric>::metric metric;
+
+   typedef sw::sandwich_kernel<typename V::clist, typename X::clist, metric> kernel;
+   typedef typename kernel::clist clist;
+
+   typedef typename sw::versor_storage<V>::type v_storage_t;
+   typedef typename sw::operand_storage<X, clist::size>::type x_storage_t;
+
+   sandwich(const V& v_, const X& x_)
+      :  v(v_), x(x_)
+   { }
+
+   template<conf_t conf>
+   element_t element() const {
+      return kernel::template element<conf, element_t>(*this, x);
+   }
+
+   //matrix elements evaluated once per initialization, read by every element of the result
+   void init() {
+      v.init();
+      x.init();
+      kernel::template evaluate_matrix<element_t>(m, v);
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return v.aliases(d) || x.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      v.bind_lane(lane);
+      x.bind_lane(lane);
+   }
+
+   //kernel evaluation, operand X with multivector storage only
+   template<typename DCL, typename T, typename D>
+   void evaluate(D& data) const {
+      kernel::template evaluate<DCL, T>(data, *this, storage_of(x));
+   }
+
+   template<conf_t C, conf_t K>
+   element_t coefficient() const {
+      return std::get<kernel::template position<C, K>::value>(m);
+   }
+
+protected:
+   v_storage_t v;
+   x_storage_t x;
+
+   typename kernel::template matrix_storage<element_t>::type m;
+};
+
+template<class V, class X>
+struct evaluation_kernel<sandwich<V, X>>
+{
+   typedef sandwich<V, X> E;
+
+   static const bool value = has_storage<typename std::remove_cv<typename std::remove_reference<typename E::x_storage_t>::type>::type>::value;
+};
+
+//cached matrix
+template<class V, class X>
+struct has_state<sandwich<V, X>>
+{
+   static const bool value = true;
+};
+
+//cost model: matrix row of result element as loads of cached matrix elements, quadratic forms in elements of V per initialization
+template<class V, class X, conf_t conf>
+struct element_cost<sandwich<V, X>, conf>
+{
+   typedef sandwich<V, X> E;
+
+   typedef typename sw::search_row_cost<conf, typename E::kernel::rows, sw::map_element, E, typename operand_type<typename E::x_storage_t>::type>::type type;
+};
+template<class V, class X>
+struct init_cost<sandwich<V, X>>
+{
+   typedef sandwich<V, X> E;
+   typedef typename operand_type<typename E::v_storage_t>::type v_t;
+
+   typedef typename operations_sum<typename init_cost<v_t>::type,
+                                   typename init_cost<typename operand_type<typename E::x_storage_t>::type>::type,
+                                   typename sw::matrix_cache_cost<typename E::kernel::rows, v_t>::type>::type type;
+};
+
+namespace sw
+{
+
+/// Sandwich product v*x*~v of a versor v and a multivector x.
+/**
+ * Evaluated as one linear map of x, whose matrix elements are symmetric quadratic forms in the elements of v.
+ * The matrix is evaluated once by initialization of the expression and read by every element of the result,
+ * so elements of the sandwich are loads and multiply-adds, also when read repeatedly as operand of a larger expression.
+ * For a map applied to many x, precompute it once by versor_map.
+ * Precondition: v is a versor (e.g. rotor, motor), v*~v a scalar. Only grades present in x are evaluated, which is
+ * the full sandwich for a versor only; v of both even and odd grades is rejected at compile time,
+ * for other non-versors the result is the part of v*x*~v in the grades of x.
+ * In namespace sw, not as global sandwich(), which would be ambiguous with sandwich() helpers of user code.
+ */
+/// \ingroup ga_ops
+template <class V, class X> inline
+sandwich<V, X>
+apply(const expression<V>& v, const expression<X>& x) {
+   return sandwich<V, X>(v, x);
+}
+
+} //end namespace sw
+
+} //end namespace gaalet
+
+#endif
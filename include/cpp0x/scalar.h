@@ -25,15 +25,37 @@ struct scalar : public expression<scalar<L, R>>
    template<conf_t conf>
    element_t element() const {
       //return e.template element<conf>();
-      return (conf==0x00) ? (::grade<0>(l*r).template element<conf>()) : 0.0; 
+      return (conf==0x00) ? (prepare(::grade<0>(l*r)).template element<conf>()) : 0.0; 
+   }
+
+   void init() {
+      l.init();
+      r.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return l.aliases(d) || r.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      l.bind_lane(lane);
+      r.bind_lane(lane);
    }
 
 protected:
-   const L& l;
-   const R& r;
+   typename expression_storage<L>::type l;
+   typename expression_storage<R>::type r;
    //const E& e;
 };
 
+//cost model: scalar part of l*r evaluated per element read
+template<class L, class R, conf_t conf>
+struct element_cost<scalar<L, R>, conf>
+{
+   typedef typename std::conditional<(conf==0x00), expression_cost<grade<0, geometric_product<L, R>>>, operations<>>::type cost;
+   typedef typename operations_sum<cost>::type type;
+};
+
 }  //end namespace gaalet
 
 
@@ -0,0 +1,266 @@
+#ifndef __GAALET_SIMD_H
+#define __GAALET_SIMD_H
+
+#include "configuration_list.h"
+#include "multivector_element.h"
+
+#include <cmath>
+#include <initializer_list>
+#include <ostream>
+#include <type_traits>
+
+//packed element operations by GCC vector extensions (SSE/AVX/AVX-512 depending on target), scalar loops otherwise
+#if defined(__GNUC__) && !defined(GAALET_NO_VECTOR_EXTENSIONS)
+#define GAALET_VECTOR_EXTENSIONS 1
+#else
+#define GAALET_VECTOR_EXTENSIONS 0
+#endif
+
+//packs wider than the enabled instruction set are split by the compiler
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wpsabi"
+#endif
+
+namespace gaalet
+{
+
+//packed element type and its lane-wise operations (own namespace for argument-dependent lookup of math functions, which are expression names in gaalet)
+namespace packed
+{
+
+//storage of N lanes of element type T
+template<typename T, unsigned int N, bool vector = GAALET_VECTOR_EXTENSIONS>
+struct simd_storage
+{
+   struct type
+   {
+      constexpr T operator[](unsigned int i) const {
+         return lane[i];
+      }
+      T& operator[](unsigned int i) {
+         return lane[i];
+      }
+
+      T lane[N];
+   };
+};
+#if GAALET_VECTOR_EXTENSIONS
+template<typename T, unsigned int N>
+struct simd_storage<T, N, true>
+{
+   //element alignment only: packs stored in containers without over-aligned allocation (c++0x) are loaded unaligned
+   typedef T type __attribute__((vector_size(sizeof(T)*N), aligned(sizeof(T))));
+};
+#endif
+
+/// Packed element type: N independent lanes evaluated by one instruction.
+/**
+ * Usable as element type of an algebra, e.g. algebra<signature<4,1>, simd<double, 4>>, mixing with plain scalar factors.
+ * Expressions with data-dependent branches in init() (e.g. exponential of bivectors) are not evaluable with packs.
+ */
+template<typename T, unsigned int N>
+struct simd
+{
+   typedef T value_type;
+   static const unsigned int lanes = N;
+
+   typedef typename simd_storage<T, N>::type storage_t;
+
+   //all lanes zero
+   constexpr simd()
+      :  v(broadcast(T(0), typename make_index_list<N>::type()))
+   { }
+
+   //scalar broadcast to all lanes
+   constexpr simd(const T& s)
+      :  v(broadcast(s, typename make_index_list<N>::type()))
+   { }
+
+   //lanes in order, missing lanes zero
+   constexpr simd(std::initializer_list<T> s)
+      :  v(list(s, typename make_index_list<N>::type()))
+   { }
+
+   constexpr T operator[](unsigned int i) const {
+      return v[i];
+   }
+   T& operator[](unsigned int i) {
+      return reinterpret_cast<T*>(&v)[i];
+   }
+
+   simd& operator+=(const simd& s) {
+      return *this = *this + s;
+   }
+   simd& operator-=(const simd& s) {
+      return *this = *this - s;
+   }
+   simd& operator*=(const simd& s) {
+      return *this = *this * s;
+   }
+   simd& operator/=(const simd& s) {
+      return *this = *this / s;
+   }
+
+   //lane-wise operation by function f
+   template<typename F>
+   simd apply(F f) const {
+      simd r;
+      for(unsigned int i = 0; i < N; ++i) {
+         r[i] = f(v[i]);
+      }
+      return r;
+   }
+
+   storage_t v;
+
+protected:
+   template<conf_t... I>
+   static constexpr storage_t broadcast(const T& s, index_list<I...>) {
+      return storage_t{ ((void)I, s)... };
+   }
+   template<conf_t... I>
+   static constexpr storage_t list(std::initializer_list<T> s, index_list<I...>) {
+      return storage_t{ ((I<s.size()) ? s.begin()[I] : T(0))... };
+   }
+};
+
+//arithmetic
+#if GAALET_VECTOR_EXTENSIONS
+template<typename T, unsigned int N> inline
+simd<T, N> simd_from(const typename simd<T, N>::storage_t& v) {
+   simd<T, N> r;
+   r.v = v;
+   return r;
+}
+
+template<typename T, unsigned int N> inline
+simd<T, N> operator+(const simd<T, N>& l, const simd<T, N>& r) {
+   return simd_from<T, N>(l.v + r.v);
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator-(const simd<T, N>& l, const simd<T, N>& r) {
+   return simd_from<T, N>(l.v - r.v);
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator*(const simd<T, N>& l, const simd<T, N>& r) {
+   return simd_from<T, N>(l.v * r.v);
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator/(const simd<T, N>& l, const simd<T, N>& r) {
+   return simd_from<T, N>(l.v / r.v);
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator-(const simd<T, N>& a) {
+   return simd_from<T, N>(-a.v);
+}
+#else
+template<typename T, unsigned int N> inline
+simd<T, N> operator+(const simd<T, N>& l, const simd<T, N>& r) {
+   simd<T, N> s;
+   for(unsigned int i = 0; i < N; ++i) s[i] = l[i] + r[i];
+   return s;
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator-(const simd<T, N>& l, const simd<T, N>& r) {
+   simd<T, N> s;
+   for(unsigned int i = 0; i < N; ++i) s[i] = l[i] - r[i];
+   return s;
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator*(const simd<T, N>& l, const simd<T, N>& r) {
+   simd<T, N> s;
+   for(unsigned int i = 0; i < N; ++i) s[i] = l[i] * r[i];
+   return s;
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator/(const simd<T, N>& l, const simd<T, N>& r) {
+   simd<T, N> s;
+   for(unsigned int i = 0; i < N; ++i) s[i] = l[i] / r[i];
+   return s;
+}
+template<typename T, unsigned int N> inline
+simd<T, N> operator-(const simd<T, N>& a) {
+   simd<T, N> s;
+   for(unsigned int i = 0; i < N; ++i) s[i] = -a[i];
+   return s;
+}
+#endif
+
+//mixing with plain scalars (factors, signs): scalar broadcast, scalars by value (static const sign members not odr-used)
+#define GAALET_SIMD_SCALAR_OPERATOR(op) \
+template<typename T, unsigned int N, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, simd<T, N>>::type \
+operator op(const simd<T, N>& l, S r) { \
+   return l op simd<T, N>(T(r)); \
+} \
+template<typename T, unsigned int N, typename S> inline \
+typename std::enable_if<std::is_arithmetic<S>::value, simd<T, N>>::type \
+operator op(S l, const simd<T, N>& r) { \
+   return simd<T, N>(T(l)) op r; \
+}
+GAALET_SIMD_SCALAR_OPERATOR(+)
+GAALET_SIMD_SCALAR_OPERATOR(-)
+GAALET_SIMD_SCALAR_OPERATOR(*)
+GAALET_SIMD_SCALAR_OPERATOR(/)
+#undef GAALET_SIMD_SCALAR_OPERATOR
+
+//lane-wise functions
+#define GAALET_SIMD_FUNCTION(f) \
+template<typename T, unsigned int N> inline \
+simd<T, N> f(const simd<T, N>& a) { \
+   return a.apply([](T x) { return std::f(x); }); \
+}
+GAALET_SIMD_FUNCTION(sqrt)
+GAALET_SIMD_FUNCTION(fabs)
+GAALET_SIMD_FUNCTION(exp)
+GAALET_SIMD_FUNCTION(log)
+GAALET_SIMD_FUNCTION(sin)
+GAALET_SIMD_FUNCTION(cos)
+GAALET_SIMD_FUNCTION(sinh)
+GAALET_SIMD_FUNCTION(cosh)
+GAALET_SIMD_FUNCTION(acos)
+#undef GAALET_SIMD_FUNCTION
+
+//lane-wise streaming
+template<class E, class TR, typename T, unsigned int N>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const simd<T, N>& s)
+{
+   os << '(';
+   for(unsigned int i = 0; i < N; ++i) {
+      os << ((i==0) ? "" : " ") << s[i];
+   }
+   os << ')';
+   return os;
+}
+
+}  //end namespace packed
+
+using packed::simd;
+
+//element type combination: packs dominate plain scalars
+template<typename T, unsigned int N, typename E>
+struct element_type_combination_traits<simd<T, N>, E>
+{
+   typedef simd<T, N> element_t;
+};
+template<typename E, typename T, unsigned int N>
+struct element_type_combination_traits<E, simd<T, N>>
+{
+   typedef simd<T, N> element_t;
+};
+template<typename T, unsigned int N>
+struct element_type_combination_traits<simd<T, N>, simd<T, N>>
+{
+   typedef simd<T, N> element_t;
+};
+
+template<typename T, unsigned int N>
+struct null_element<simd<T, N>> {
+   static constexpr simd<T, N> value() {
+      return simd<T, N>();
+   }
+};
+
+} //end namespace gaalet
+
+#endif
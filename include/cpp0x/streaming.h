@@ -7,25 +7,21 @@
 namespace gaalet
 {
 
-//expression streaming
+//expression streaming: elements and configurations by pack expansion over element indices (no recursion through list tails)
 template<typename G, typename clist>
 struct UnpackElementsToStream
 {
    template<class E, class T>
-   //static void unpack(std::basic_ostream<E, T>& os, const G& e) {
-   static void unpack(std::basic_ostream<E, T>& os, const gaalet::expression<G>& e_) {
-      const G& e(e_);
-      os << e.template element<clist::head>() << " ";
-      UnpackElementsToStream<G, typename clist::tail>::unpack(os, e_);
+   static void unpack(std::basic_ostream<E, T>& os, const gaalet::expression<G>& e) {
+      unpack(os, e, typename make_index_list<clist::size>::type());
    }
-};
 
-template<typename G>
-struct UnpackElementsToStream<G, gaalet::cl_null>
-{
-   template<class E, class T>
-   //static void unpack(std::basic_ostream<E, T>&, const G&) { }
-   static void unpack(std::basic_ostream<E, T>&, const gaalet::expression<G>&) { }
+   template<class E, class T, conf_t... I>
+   static void unpack(std::basic_ostream<E, T>& os, const gaalet::expression<G>& e_, index_list<I...>) {
+      const G& e(e_);
+      typedef int swallow[];
+      (void)swallow{0, ((os << e.template element<get_element<I, clist>::value>() << " "), 0)...};
+   }
 };
 
 template<typename clist>
@@ -33,16 +29,14 @@ struct UnpackConfigurationListToStream
 {
    template<class E, class T>
    static void unpack(std::basic_ostream<E, T>& os) {
-      os << clist::head << " ";
-      UnpackConfigurationListToStream<typename clist::tail>::unpack(os);
+      unpack(os, typename make_index_list<clist::size>::type());
    }
-};
 
-template<>
-struct UnpackConfigurationListToStream<gaalet::cl_null>
-{
-   template<class E, class T>
-   static void unpack(std::basic_ostream<E, T>&) { }
+   template<class E, class T, conf_t... I>
+   static void unpack(std::basic_ostream<E, T>& os, index_list<I...>) {
+      typedef int swallow[];
+      (void)swallow{0, ((os << get_element<I, clist>::value << " "), 0)...};
+   }
 };
 
 } //end namespace gaalet
@@ -57,8 +51,11 @@ std::basic_ostream<E, T>& operator<<(std::basic_ostream<E, T>& os, const gaalet:
    //const G& e(e_);
    //auto mv = eval(e_);
 
+   //elements of a prepared copy, scalar factors of the expression computed once
+   const G p(gaalet::prepare(e));
+
    os << "[ " << std::dec;
-      gaalet::UnpackElementsToStream<G, typename G::clist>::unpack(os, e);
+      gaalet::UnpackElementsToStream<G, typename G::clist>::unpack(os, p);
    os << "] { " << std::hex;
       gaalet::UnpackConfigurationListToStream<typename G::clist>::unpack(os);
    os << '}';
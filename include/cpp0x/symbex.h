@@ -1,159 +1,486 @@
 #ifndef __GAALET_SYMBOL_H
 #define __GAALET_SYMBOL_H
 
-#include "string"
-#include "sstream"
+#include <string>
+#include <sstream>
+#include <ostream>
+#include <cstdlib>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <functional>
+#include <unordered_set>
+#include <type_traits>
 
 namespace gaalet
 {
 
+//operations of symbolic expression nodes
+enum symbex_op {
+   symbex_constant,
+   symbex_symbol,
+   symbex_neg,
+   symbex_add,
+   symbex_sub,
+   symbex_mul,
+   symbex_div,
+   symbex_sin,
+   symbex_cos,
+   symbex_tan,
+   symbex_sqrt,
+   symbex_exp,
+   symbex_log
+};
+
+///node of a symbolic expression DAG: unique per operation and operands (hash-consed), owned by symbex_pool()
+struct symbex_node
+{
+   symbex_op op;
+   double value;              //constant
+   const std::string* name;   //symbol, interned
+   const symbex_node* l;      //operand of unary operations and functions, left operand
+   const symbex_node* r;      //right operand
+
+   std::size_t id;            //creation order
+   std::size_t hash;
+};
+
+/// Node table of symbolic expressions: arena of nodes, interned by operation and operands.
+/**
+ * Nodes live until the end of the program, equal subterms are shared and compared by address.
+ * Not thread-safe: symbolic expressions are built by one thread at a time.
+ */
+class symbex_table
+{
+public:
+   symbex_table()
+      :  count(0)
+   { }
+
+   const symbex_node* constant(double v) {
+      symbex_node key = make_key(symbex_constant, nullptr, nullptr);
+      key.value = (v==0.0) ? 0.0 : v;   //no negative zero
+      key.hash = std::hash<double>()(key.value);
+      return intern(key);
+   }
+
+   const symbex_node* symbol(const std::string& name) {
+      symbex_node key = make_key(symbex_symbol, nullptr, nullptr);
+      key.name = &*names.insert(name).first;
+      key.hash = std::hash<const void*>()(key.name);
+      return intern(key);
+   }
+
+   const symbex_node* node(symbex_op op, const symbex_node* l, const symbex_node* r = nullptr) {
+      symbex_node key = make_key(op, l, r);
+      key.hash = (std::hash<const void*>()(l)*31 + std::hash<const void*>()(r))*31 + op;
+      return intern(key);
+   }
+
+   //number of distinct nodes
+   std::size_t size() const {
+      return count;
+   }
+
+protected:
+   static symbex_node make_key(symbex_op op, const symbex_node* l, const symbex_node* r) {
+      symbex_node key = { op, 0.0, nullptr, l, r, 0, 0 };
+      return key;
+   }
+
+   const symbex_node* intern(const symbex_node& key) {
+      auto n = nodes.find(&key);
+      if(n!=nodes.end()) {
+         return *n;
+      }
+
+      if(count%block_size==0) {
+         blocks.push_back(std::unique_ptr<symbex_node[]>(new symbex_node[block_size]));
+      }
+      symbex_node* node = &blocks.back()[count%block_size];
+      *node = key;
+      node->id = count++;
+      nodes.insert(node);
+      return node;
+   }
+
+   struct node_hash {
+      std::size_t operator()(const symbex_node* n) const {
+         return n->hash;
+      }
+   };
+   struct node_equal {
+      bool operator()(const symbex_node* a, const symbex_node* b) const {
+         return a->op==b->op && a->value==b->value && a->name==b->name && a->l==b->l && a->r==b->r;
+      }
+   };
+
+   static const std::size_t block_size = 4096;
+
+   std::vector<std::unique_ptr<symbex_node[]>> blocks;
+   std::size_t count;
+   std::unordered_set<const symbex_node*, node_hash, node_equal> nodes;
+   std::unordered_set<std::string> names;
+};
+
+//node table of all symbolic expressions
+inline
+symbex_table& symbex_pool() {
+   static symbex_table table;
+   return table;
+}
+
 ///symbex: symbolic expression
+/**
+ * Handle of an interned node of symbolic expressions, copied by address.
+ * Operations simplify locally (x*0, x*1, x+0, -(-x), constant folding, negative factors pulled out as negation), strings are produced by streaming only.
+ */
 struct symbex {
+   //symbol of given name, constant if name is a number
    symbex(const std::string& expr_ = "0")
-      :  expr(expr_)
+      :  n(parse(expr_))
+   { }
+
+   symbex(const char expr_[])
+      :  n(parse(expr_))
+   { }
+
+   template<typename S>
+   symbex(S value_, typename std::enable_if<std::is_arithmetic<S>::value>::type* = 0)
+      :  n(symbex_pool().constant(value_))
    { }
 
-   //template<typename A>
-   //symbex(const A& expr_)
-   symbex(const double& expr_)
-   {
-      std::stringstream as;
-      as << expr_;
-      expr = as.str();
+   explicit symbex(const symbex_node* n_)
+      :  n(n_)
+   { }
+
+   const symbex_node* node() const {
+      return n;
    }
 
-   //template<typename A>
-   //symbex(const A& expr_)
-   symbex(const char expr_[])
-   {
-      std::stringstream as;
-      as << expr_;
-      expr = as.str();
+   bool is_constant() const {
+      return n->op==symbex_constant;
+   }
+   bool is_constant(double v) const {
+      return n->op==symbex_constant && n->value==v;
+   }
+   double value() const {
+      return n->value;
+   }
+
+   std::string str() const;
+
+protected:
+   static const symbex_node* parse(const std::string& expr) {
+      const char* begin = expr.c_str();
+      char* end;
+      double v = std::strtod(begin, &end);
+      if(end!=begin && *end=='\0') {
+         return symbex_pool().constant(v);
+      }
+      return symbex_pool().symbol(expr);
    }
 
-   std::string expr;
+   const symbex_node* n;
 };
 
 template<>
 struct null_element<symbex> {
    static symbex value() {
-      return symbex("0");
+      return symbex(0.0);
    }
 };
 
-} //end namespace gaalet
+//streaming: operands parenthesized by precedence
+inline
+int symbex_precedence(const symbex_node* n) {
+   switch(n->op) {
+      case symbex_add:
+      case symbex_sub:
+         return 1;
+      case symbex_mul:
+      case symbex_div:
+         return 2;
+      case symbex_neg:
+         return 3;
+      case symbex_constant:
+         return (n->value<0.0) ? 3 : 4;
+      default:
+         return 4;
+   }
+}
 
-std::ostream& operator<<(std::ostream& os, const gaalet::symbex& s)
+inline
+const char* symbex_operator(symbex_op op) {
+   switch(op) {
+      case symbex_add: return "+";
+      case symbex_sub: return "-";
+      case symbex_mul: return "*";
+      case symbex_div: return "/";
+      case symbex_sin: return "sin";
+      case symbex_cos: return "cos";
+      case symbex_tan: return "tan";
+      case symbex_sqrt: return "sqrt";
+      case symbex_exp: return "exp";
+      case symbex_log: return "log";
+      default: return "";
+   }
+}
+
+//names of nodes written in place of their terms (indexed by node id, empty: term written), e.g. temporaries of generated code
+typedef std::vector<std::string> symbex_names;
+
+inline
+bool symbex_named(const symbex_node* n, const symbex_names& names) {
+   return n->id<names.size() && !names[n->id].empty();
+}
+
+template<class E, class TR>
+void write_symbex(std::basic_ostream<E, TR>& os, const symbex_node* n, const symbex_names& names, bool qualified = false, bool parentheses = false);
+
+//operand of a node: name or term
+template<class E, class TR>
+void write_symbex_operand(std::basic_ostream<E, TR>& os, const symbex_node* n, const symbex_names& names, bool qualified, bool parentheses)
 {
-   os << s.expr;
-   return os;
+   if(symbex_named(n, names)) {
+      os << names[n->id];
+   }
+   else {
+      write_symbex(os, n, names, qualified, parentheses);
+   }
 }
 
-/// \brief Unary plus.
-/// \ingroup symbex_ops
-gaalet::symbex
-operator+(const gaalet::symbex& l) {
-   return gaalet::symbex("(+" + l.expr + ")");
+//term of a node, operands named by names, functions qualified by std:: if qualified
+template<class E, class TR>
+void write_symbex(std::basic_ostream<E, TR>& os, const symbex_node* n, const symbex_names& names, bool qualified, bool parentheses)
+{
+   if(parentheses) {
+      os << "(";
+   }
+
+   const int p = symbex_precedence(n);
+   switch(n->op) {
+      case symbex_constant:
+         os << n->value;
+         break;
+      case symbex_symbol:
+         os << *n->name;
+         break;
+      case symbex_neg:
+         os << "-";
+         write_symbex_operand(os, n->l, names, qualified, !symbex_named(n->l, names) && symbex_precedence(n->l)<3);
+         break;
+      case symbex_add:
+      case symbex_sub:
+      case symbex_mul:
+      case symbex_div:
+         {
+            const int lp = symbex_named(n->l, names) ? 4 : symbex_precedence(n->l);
+            const int rp = symbex_named(n->r, names) ? 4 : symbex_precedence(n->r);
+            write_symbex_operand(os, n->l, names, qualified, lp<p);
+            os << symbex_operator(n->op);
+            write_symbex_operand(os, n->r, names, qualified, rp<=p || rp==3);
+         }
+         break;
+      default:
+         os << (qualified ? "std::" : "") << symbex_operator(n->op) << "(";
+         write_symbex_operand(os, n->l, names, qualified, false);
+         os << ")";
+   }
+
+   if(parentheses) {
+      os << ")";
+   }
 }
 
-/// \brief Unary minus.
-/// \ingroup symbex_ops
-gaalet::symbex
-operator-(const gaalet::symbex& l) {
-   return gaalet::symbex("(-" + l.expr + ")");
+template<class E, class TR>
+std::basic_ostream<E, TR>& operator<<(std::basic_ostream<E, TR>& os, const symbex& s)
+{
+   write_symbex(os, s.node(), symbex_names());
+   return os;
 }
 
-/// \brief Addition of two symbex operands.
-/// \ingroup symbex_ops
-gaalet::symbex
-operator+(const gaalet::symbex& l, const gaalet::symbex& r) {
-   return gaalet::symbex("(" + l.expr + "+" + r.expr + ")");
+inline
+std::string symbex::str() const {
+   std::ostringstream os;
+   os << *this;
+   return os.str();
+}
+
+//construction of nodes, operands of commutative operations ordered: constants first, then by creation
+inline
+symbex make_symbex(symbex_op op, const symbex& l, const symbex& r) {
+   return symbex(symbex_pool().node(op, l.node(), r.node()));
+}
+inline
+symbex make_symbex_commutative(symbex_op op, const symbex& l, const symbex& r) {
+   const bool swap = r.is_constant() || (!l.is_constant() && r.node()->id<l.node()->id);
+   return swap ? make_symbex(op, r, l) : make_symbex(op, l, r);
+}
+inline
+symbex make_symbex(symbex_op op, const symbex& a) {
+   return symbex(symbex_pool().node(op, a.node()));
 }
 
 /// \brief Subtraction of two symbex operands.
 /// \ingroup symbex_ops
-gaalet::symbex
-operator-(const gaalet::symbex& l, const gaalet::symbex& r) {
-   return gaalet::symbex("(" + l.expr + "-" + r.expr + ")");
+inline
+symbex operator-(const symbex& l, const symbex& r);
+
+/// \brief Multiplication of two symbex operands, including scalar factors.
+/// \ingroup symbex_ops
+inline
+symbex operator*(const symbex& l, const symbex& r);
+
+/// \brief Unary plus.
+/// \ingroup symbex_ops
+inline
+symbex operator+(const symbex& a) {
+   return a;
 }
 
-/// \brief Multiplication of two symbex operands.
+/// \brief Unary minus.
 /// \ingroup symbex_ops
-gaalet::symbex
-operator*(const gaalet::symbex& l, const gaalet::symbex& r) {
-   return gaalet::symbex(l.expr + "*" + r.expr);
+inline
+symbex operator-(const symbex& a) {
+   if(a.is_constant()) {
+      return symbex(-a.value());
+   }
+   else if(a.node()->op==symbex_neg) {
+      return symbex(a.node()->l);
+   }
+   return make_symbex(symbex_neg, a);
 }
 
-/// \brief Multiplication of a double and a symbex operand.
+/// \brief Addition of two symbex operands.
 /// \ingroup symbex_ops
-gaalet::symbex
-operator*(const double& l, const gaalet::symbex& r) {
-   if(l == 1.0) {
-      return gaalet::symbex(r.expr);
+inline
+symbex operator+(const symbex& l, const symbex& r) {
+   if(l.is_constant() && r.is_constant()) {
+      return symbex(l.value() + r.value());
    }
-   else if(l == -1.0) {
-      return gaalet::symbex("(-" + r.expr+")");
+   else if(l.is_constant(0.0)) {
+      return r;
    }
-   else if(l == 0.0) {
-      return gaalet::symbex("");
+   else if(r.is_constant(0.0)) {
+      return l;
    }
-   else {
-      std::stringstream ls;
-      ls << l;
-
-      return gaalet::symbex(ls.str() + "*" + r.expr);
+   else if(r.node()->op==symbex_neg) {
+      return l - symbex(r.node()->l);
+   }
+   else if(l.node()->op==symbex_neg) {
+      return r - symbex(l.node()->l);
+   }
+   else if(l.is_constant() && l.value()<0.0) {
+      return r - (-l);
+   }
+   else if(r.is_constant() && r.value()<0.0) {
+      return l - (-r);
    }
+   return make_symbex_commutative(symbex_add, l, r);
 }
 
-/// \brief Multiplication of a symbex operand and a double.
-/// \ingroup symbex_ops
-gaalet::symbex
-operator*(const gaalet::symbex& l, const double& r) {
-   if(r == 1.0) {
-      return gaalet::symbex(l.expr);
+inline
+symbex operator-(const symbex& l, const symbex& r) {
+   if(l.is_constant() && r.is_constant()) {
+      return symbex(l.value() - r.value());
    }
-   else if(r == -1.0) {
-      return gaalet::symbex("(-" + l.expr+")");
+   else if(r.is_constant(0.0)) {
+      return l;
    }
-   else if(r == 0.0) {
-      return gaalet::symbex("");
+   else if(l.is_constant(0.0)) {
+      return -r;
    }
-   else {
-      std::stringstream rs;
-      rs << r;
-
-      return gaalet::symbex(l.expr + "*" + rs.str());
+   else if(l.node()==r.node()) {
+      return symbex(0.0);
+   }
+   else if(r.node()->op==symbex_neg) {
+      return l + symbex(r.node()->l);
    }
+   else if(l.node()->op==symbex_neg || (l.is_constant() && l.value()<0.0)) {
+      return -(-l + r);
+   }
+   return make_symbex(symbex_sub, l, r);
 }
 
-
-/// \brief Division of a symbex operand by another symbex operand.
-/// \ingroup symbex_ops
-gaalet::symbex
-operator/(const gaalet::symbex& l, const gaalet::symbex& r) {
-   return gaalet::symbex(l.expr + "/" + r.expr);
+inline
+symbex operator*(const symbex& l, const symbex& r) {
+   if(l.is_constant() && r.is_constant()) {
+      return symbex(l.value()*r.value());
+   }
+   else if(l.is_constant(0.0) || r.is_constant(0.0)) {
+      return symbex(0.0);
+   }
+   else if(l.is_constant(1.0)) {
+      return r;
+   }
+   else if(r.is_constant(1.0)) {
+      return l;
+   }
+   else if(l.is_constant(-1.0)) {
+      return -r;
+   }
+   else if(r.is_constant(-1.0)) {
+      return -l;
+   }
+   else if(l.node()->op==symbex_neg || (l.is_constant() && l.value()<0.0)) {
+      return -(-l*r);
+   }
+   else if(r.node()->op==symbex_neg || (r.is_constant() && r.value()<0.0)) {
+      return -(l*-r);
+   }
+   else if(r.is_constant()) {
+      return r*l;
+   }
+   else if(l.is_constant() && r.node()->op==symbex_mul && r.node()->l->op==symbex_constant) {
+      return symbex(l.value()*r.node()->l->value)*symbex(r.node()->r);
+   }
+   return make_symbex_commutative(symbex_mul, l, r);
 }
 
-
-/// \brief Sine of symbex operand.
+/// \brief Division of a symbex operand by another symbex operand.
 /// \ingroup symbex_ops
-gaalet::symbex
-sin(const gaalet::symbex& a) {
-   return gaalet::symbex("sin(" + a.expr + ")");
+inline
+symbex operator/(const symbex& l, const symbex& r) {
+   if(l.is_constant() && r.is_constant()) {
+      return symbex(l.value()/r.value());
+   }
+   else if(l.is_constant(0.0)) {
+      return l;
+   }
+   else if(r.is_constant(1.0)) {
+      return l;
+   }
+   else if(r.is_constant(-1.0)) {
+      return -l;
+   }
+   else if(l.node()->op==symbex_neg || (l.is_constant() && l.value()<0.0)) {
+      return -(-l/r);
+   }
+   else if(r.node()->op==symbex_neg || (r.is_constant() && r.value()<0.0)) {
+      return -(l/-r);
+   }
+   return make_symbex(symbex_div, l, r);
 }
 
-/// \brief Cosine of symbex operand.
+/// \brief Sine, cosine, tangent, square root, exponential and natural logarithm of symbex operand, folded for constant arguments.
 /// \ingroup symbex_ops
-gaalet::symbex
-cos(const gaalet::symbex& a) {
-   return gaalet::symbex("cos(" + a.expr + ")");
+#define GAALET_SYMBEX_FUNCTION(f) \
+inline \
+symbex f(const symbex& a) { \
+   if(a.is_constant()) { \
+      return symbex(std::f(a.value())); \
+   } \
+   return make_symbex(symbex_##f, a); \
 }
+GAALET_SYMBEX_FUNCTION(sin)
+GAALET_SYMBEX_FUNCTION(cos)
+GAALET_SYMBEX_FUNCTION(tan)
+GAALET_SYMBEX_FUNCTION(sqrt)
+GAALET_SYMBEX_FUNCTION(exp)
+GAALET_SYMBEX_FUNCTION(log)
+#undef GAALET_SYMBEX_FUNCTION
 
-/// \brief Square root of symbex operand.
-/// \ingroup symbex_ops
-gaalet::symbex
-sqrt(const gaalet::symbex& a) {
-   return gaalet::symbex("sqrt(" + a.expr + ")");
-}
+} //end namespace gaalet
 
 #endif
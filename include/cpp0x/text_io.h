@@ -0,0 +1,474 @@
+#ifndef __GAALET_TEXT_IO_H
+#define __GAALET_TEXT_IO_H
+
+#include "algebra.h"
+#include "multivector_array.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
+
+//bulk text interchange of batches of multivectors: one multivector per line, elements separated by whitespace or commas
+//   rows formatted into block buffers and written by one stream call per block, parsed from one buffer of the whole input
+//   shortest round-trip formatting and general parsing by std::to_chars/std::from_chars where available (C++17), snprintf/strtod otherwise
+//   fixed formatting (digits after point) and parsing of up to 19 significant digits in integer arithmetic, exact cases without library calls
+
+//size of block buffer of writer in bytes
+#ifndef GAALET_TEXT_BLOCK
+#define GAALET_TEXT_BLOCK 65536
+#endif
+
+namespace gaalet
+{
+
+enum text_header
+{
+   text_header_none = 0,   //no header line, columns in order of configuration list
+   text_header_index = 1,  //"# 1 2 4 8 10": blade bitmaps, hexadecimal as printed by operator<<
+   text_header_basis = 2   //"# e1 e2 e1^e2": basis blades, scalar as 1
+};
+
+struct text_format
+{
+   text_format(char separator_ = ' ', text_header header_ = text_header_index, int digits_ = -1, bool skip_zero_ = false)
+      :  separator(separator_), header(header_), digits(digits_), skip_zero(skip_zero_)
+   { }
+
+   char separator;      //between elements of a line (parser accepts any of ' ', '\t', ',', ';')
+   text_header header;
+   int digits;          //<0: shortest round trip, >=0: fixed number of digits after point (at most 17)
+   bool skip_zero;      //columns structurally zero (not in configuration list of batch) omitted instead of written as 0
+};
+
+/// Error parsing text input.
+struct text_error : public std::runtime_error
+{
+   text_error(std::size_t line, const std::string& what)
+      :  std::runtime_error("gaalet text line " + std::to_string(line) + ": " + what)
+   { }
+};
+
+//formatting and parsing of elements: fast paths exact for mantissas below 2^mantissa_bits and powers of ten up to exact_power
+template<typename T>
+struct text_element;
+template<>
+struct text_element<double>
+{
+   static const int mantissa_bits = 53;
+   static const int exact_power = 22;
+   static const int round_trip_digits = 17;
+
+   static double from_library(const char* s, char** end) {
+      return std::strtod(s, end);
+   }
+};
+template<>
+struct text_element<float>
+{
+   static const int mantissa_bits = 24;
+   static const int exact_power = 10;
+   static const int round_trip_digits = 9;
+
+   static float from_library(const char* s, char** end) {
+      return std::strtof(s, end);
+   }
+};
+
+//powers of ten exactly representable in double
+inline const double* text_powers_of_ten()
+{
+   static const double p[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                               1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+   return p;
+}
+
+//decimal digits of v written backwards from end, returns first digit
+inline char* format_text_digits(char* end, std::uint64_t v, int min_digits = 1)
+{
+   static const char pairs[] =
+      "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+      "8081828384858687888990919293949596979899";
+   char* p = end;
+   while(v >= 100) {
+      const unsigned int r = v%100;
+      v /= 100;
+      *--p = pairs[2*r+1];
+      *--p = pairs[2*r];
+   }
+   if(v >= 10) {
+      *--p = pairs[2*v+1];
+      *--p = pairs[2*v];
+   }
+   else {
+      *--p = char('0' + v);
+   }
+   while(end - p < min_digits) *--p = '0';
+   return p;
+}
+
+//shortest round-trip representation of x at p, returns end (at most 32 characters)
+template<typename T>
+char* format_text_element(char* p, const T& x)
+{
+#if defined(__cpp_lib_to_chars)
+   return std::to_chars(p, p + 32, x).ptr;
+#else
+   return p + std::snprintf(p, 32, "%.*g", text_element<T>::round_trip_digits, double(x));
+#endif
+}
+
+//x with digits after point (x*10^digits rounded to integer), general format if out of range of integer arithmetic
+template<typename T>
+char* format_text_element(char* p, const T& x, int digits)
+{
+   const double s = std::fabs(double(x))*text_powers_of_ten()[digits];
+   if(!(s < 9007199254740992.0)) {
+      return format_text_element(p, x);
+   }
+   const std::uint64_t v = std::uint64_t(s + 0.5);
+   if(x < 0 && v > 0) *p++ = '-';
+
+   char buffer[24];
+   char* const end = buffer + sizeof(buffer);
+   char* first;
+   if(digits > 0) {
+      const std::uint64_t scale = std::uint64_t(text_powers_of_ten()[digits]);
+      first = format_text_digits(end, v%scale, digits);
+      *--first = '.';
+      first = format_text_digits(first, v/scale);
+   }
+   else {
+      first = format_text_digits(end, v);
+   }
+   std::memcpy(p, first, end - first);
+   return p + (end - first);
+}
+
+inline bool is_text_separator(char c)
+{
+   return c==' ' || c=='\t' || c==',' || c==';';
+}
+
+//element at p (end of token at separator, line end or end), returns end of element or nullptr if none
+//   mantissas of up to 19 significant digits with exactly representable powers of ten: one multiplication or division, correctly rounded
+//   other numbers (long mantissas, large exponents, inf, nan): library conversion of token
+template<typename T>
+const char* parse_text_element(const char* p, const char* end, T& x)
+{
+   const char* const first = p;
+   const bool negative = (p < end && *p=='-');
+   if(p < end && (*p=='-' || *p=='+')) ++p;
+
+   std::uint64_t m = 0;
+   int significant = 0, exponent = 0;
+   bool any = false;
+   for(; p < end && unsigned(*p - '0') < 10; ++p) {
+      any = true;
+      if(significant < 19) {
+         m = m*10 + unsigned(*p - '0');
+         if(m > 0) ++significant;
+      }
+      else {
+         ++exponent;
+         significant = 20;
+      }
+   }
+   if(p < end && *p=='.') {
+      for(++p; p < end && unsigned(*p - '0') < 10; ++p) {
+         any = true;
+         if(significant < 19) {
+            m = m*10 + unsigned(*p - '0');
+            --exponent;
+            if(m > 0) ++significant;
+         }
+         else if(*p != '0') {
+            significant = 20;
+         }
+      }
+   }
+   if(any && p < end && (*p=='e' || *p=='E')) {
+      const char* e = p + 1;
+      const bool negative_exponent = (e < end && *e=='-');
+      if(e < end && (*e=='-' || *e=='+')) ++e;
+      if(e < end && unsigned(*e - '0') < 10) {
+         int n = 0;
+         for(; e < end && unsigned(*e - '0') < 10; ++e) {
+            if(n < 100000) n = n*10 + (*e - '0');
+         }
+         exponent += negative_exponent ? -n : n;
+         p = e;
+      }
+   }
+
+   const bool delimited = (p==end || is_text_separator(*p) || *p=='\n' || *p=='\r');
+   if(any && delimited && significant <= 19 && m <= (std::uint64_t(1) << text_element<T>::mantissa_bits)
+         && exponent >= -text_element<T>::exact_power && exponent <= text_element<T>::exact_power) {
+      const T v = T(m);
+      const T scale = T(text_powers_of_ten()[exponent < 0 ? -exponent : exponent]);
+      x = (exponent < 0) ? v/scale : v*scale;
+      if(negative) x = -x;
+      return p;
+   }
+
+   //library conversion of token: std::from_chars where available (C++17), of copy with terminator otherwise
+   const char* token_end = first;
+   while(token_end < end && !is_text_separator(*token_end) && *token_end!='\n' && *token_end!='\r') ++token_end;
+#if defined(__cpp_lib_to_chars)
+   const char* number = (first < token_end && *first=='+') ? first + 1 : first;
+   const std::from_chars_result converted = std::from_chars(number, token_end, x);
+   return (token_end > number && converted.ec==std::errc() && converted.ptr==token_end) ? token_end : nullptr;
+#else
+   char token[64];
+   if(token_end==first || token_end - first >= std::ptrdiff_t(sizeof(token))) return nullptr;
+   std::memcpy(token, first, token_end - first);
+   token[token_end - first] = '\0';
+   char* converted;
+   x = text_element<T>::from_library(token, &converted);
+   return (converted==token + (token_end - first)) ? token_end : nullptr;
+#endif
+}
+
+//label of blade in header line
+inline char* format_text_label(char* p, conf_t blade, text_header header)
+{
+   if(header==text_header_index) {
+      return p + std::sprintf(p, "%x", unsigned(blade));
+   }
+   if(blade==0) {
+      *p++ = '1';
+      return p;
+   }
+   bool first = true;
+   for(unsigned int k = 0; k < 8*sizeof(conf_t); ++k) {
+      if(blade & (conf_t(1) << k)) {
+         p += std::sprintf(p, first ? "e%u" : "^e%u", k + 1);
+         first = false;
+      }
+   }
+   return p;
+}
+
+//blade of header label [p, end) ("1", "e1^e2" or hexadecimal bitmap), returns false if no label
+inline bool parse_text_label(const char* p, const char* end, conf_t& blade)
+{
+   blade = 0;
+   if(p < end && *p=='e') {
+      while(p < end) {
+         if(*p++ != 'e') return false;
+         unsigned int k = 0;
+         const char* digits = p;
+         for(; p < end && unsigned(*p - '0') < 10; ++p) k = k*10 + (*p - '0');
+         if(p==digits || k==0 || k > 8*sizeof(conf_t)) return false;
+         blade |= conf_t(1) << (k - 1);
+         if(p < end && *p++ != '^') return false;
+      }
+      return true;
+   }
+   if(p==end) return false;
+   for(; p < end; ++p) {
+      const char c = *p;
+      const int d = (unsigned(c - '0') < 10) ? c - '0' : (c >= 'a' && c <= 'f') ? c - 'a' + 10 : (c >= 'A' && c <= 'F') ? c - 'A' + 10 : -1;
+      if(d < 0) return false;
+      blade = blade*16 + d;
+   }
+   return true;
+}
+
+//blades of configuration list CL
+template<typename CL, conf_t... I>
+std::array<conf_t, CL::size> make_text_blades(index_list<I...>)
+{
+   return std::array<conf_t, CL::size>{{ conf_t(get_element<I, CL>::value)... }};
+}
+
+//index of each element of configuration list COLS in configuration list CL, CL::size if structurally zero
+template<typename COLS, typename CL, conf_t... I>
+std::array<conf_t, COLS::size> make_text_columns(index_list<I...>)
+{
+   return std::array<conf_t, COLS::size>{{ conf_t(search_element<get_element<I, COLS>::value, CL>::index)... }};
+}
+
+/// Writes batch a as text to os, one multivector per line with columns of configuration list COLS (default: of a).
+/**
+ * Columns of COLS not in the configuration list of a are structurally zero: written as 0, or omitted with format.skip_zero.
+ * Lines are formatted into a block buffer of GAALET_TEXT_BLOCK bytes, written by one os.write() per block.
+ */
+template<typename C = void, typename CL, typename M, typename T, class R>
+void write_text(std::basic_ostream<char, R>& os, const multivector_array_view<CL, M, T>& a, const text_format& format = text_format())
+{
+   typedef typename std::conditional<std::is_void<C>::value, CL, C>::type COLS;
+   typedef typename element_precision<T>::storage_t storage_t;
+   const std::array<conf_t, COLS::size> columns = make_text_columns<COLS, CL>(typename make_index_list<COLS::size>::type());
+   const std::array<conf_t, COLS::size> labels = make_text_blades<COLS>(typename make_index_list<COLS::size>::type());
+   const int digits = (format.digits > 17) ? 17 : format.digits;
+
+   //longest line: 32 characters per element (and label), separators and line end
+   const std::size_t line = COLS::size*33 + 4;
+   std::vector<char> buffer(std::max<std::size_t>(GAALET_TEXT_BLOCK, 2*line));
+   char* const begin = &buffer[0];
+   char* const limit = begin + buffer.size() - line;
+   char* p = begin;
+
+   if(format.header != text_header_none) {
+      *p++ = '#';
+      bool first = true;
+      for(conf_t c = 0; c < COLS::size; ++c) {
+         if(columns[c]==CL::size && format.skip_zero) continue;
+         *p++ = first ? ' ' : format.separator;
+         p = format_text_label(p, labels[c], format.header);
+         first = false;
+      }
+      *p++ = '\n';
+   }
+
+   std::array<const storage_t*, COLS::size> blades;
+   for(conf_t c = 0; c < COLS::size; ++c) {
+      blades[c] = (columns[c] < CL::size) ? a.blade(columns[c]) : nullptr;
+   }
+
+   for(std::size_t i = 0; i < a.length(); ++i) {
+      bool first = true;
+      for(conf_t c = 0; c < COLS::size; ++c) {
+         if(blades[c]==nullptr && format.skip_zero) continue;
+         if(!first) *p++ = format.separator;
+         first = false;
+         if(blades[c]==nullptr) {
+            *p++ = '0';
+         }
+         else if(digits < 0) {
+            p = format_text_element(p, blades[c][i]);
+         }
+         else {
+            p = format_text_element(p, blades[c][i], digits);
+         }
+      }
+      *p++ = '\n';
+      if(p > limit) {
+         os.write(begin, p - begin);
+         p = begin;
+      }
+   }
+   os.write(begin, p - begin);
+}
+
+/// Parses text [begin, end) into batch a, resized to the number of lines with elements.
+/**
+ * A header line ("# " followed by labels) maps columns to blades, blades of a missing in the header are zero;
+ * columns of blades not in the configuration list of a must be zero. Without header, columns are in order of the
+ * configuration list. Empty lines and further lines starting with '#' are skipped. Returns number of multivectors.
+ */
+template<typename CL, typename M, typename T>
+std::size_t parse_text(const char* begin, const char* end, multivector_array<CL, M, T>& a)
+{
+   typedef typename element_precision<T>::storage_t storage_t;
+   //column map from header, default order of configuration list
+   std::vector<conf_t> columns(CL::size);
+   for(conf_t index = 0; index < CL::size; ++index) columns[index] = index;
+   const std::array<conf_t, CL::size> blade_list = make_text_blades<CL>(typename make_index_list<CL::size>::type());
+
+   std::size_t line = 1, lines = 0;
+   const char* p = begin;
+   while(p < end && (*p=='\n' || *p=='\r')) {
+      if(*p=='\n') ++line;
+      ++p;
+   }
+   if(p < end && *p=='#') {
+      columns.clear();
+      const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+      if(!eol) eol = end;
+      for(++p; p < eol; ) {
+         while(p < eol && (is_text_separator(*p) || *p=='\r')) ++p;
+         if(p==eol) break;
+         const char* label = p;
+         while(p < eol && !is_text_separator(*p) && *p!='\r') ++p;
+         conf_t blade;
+         if(!parse_text_label(label, p, blade)) throw text_error(line, "invalid blade label " + std::string(label, p));
+         columns.push_back(std::find(blade_list.begin(), blade_list.end(), blade) - blade_list.begin());
+      }
+      p = eol;
+   }
+
+   //lines with elements
+   for(const char* q = p; q < end; ) {
+      const char* eol = static_cast<const char*>(std::memchr(q, '\n', end - q));
+      if(!eol) eol = end;
+      const char* r = q;
+      while(r < eol && (is_text_separator(*r) || *r=='\r')) ++r;
+      if(r < eol && *r != '#') ++lines;
+      q = eol + 1;
+   }
+   a.resize(lines);
+
+   std::vector<storage_t*> blades(columns.size());
+   for(std::size_t c = 0; c < columns.size(); ++c) {
+      blades[c] = (columns[c] < CL::size) ? a.blade(columns[c]) : nullptr;
+   }
+
+   std::size_t i = 0;
+   while(p < end) {
+      if(*p=='\n') {
+         ++line;
+         ++p;
+         continue;
+      }
+      while(p < end && (is_text_separator(*p) || *p=='\r')) ++p;
+      if(p==end) break;
+      if(*p=='\n') continue;
+      if(*p=='#') {
+         const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+         p = eol ? eol : end;
+         continue;
+      }
+      for(std::size_t c = 0; c < columns.size(); ++c) {
+         while(p < end && is_text_separator(*p)) ++p;
+         storage_t x;
+         const char* q = parse_text_element(p, end, x);
+         if(!q) throw text_error(line, "expected " + std::to_string(columns.size()) + " elements");
+         if(blades[c]) {
+            blades[c][i] = x;
+         }
+         else if(x != storage_t()) {
+            throw text_error(line, "element of blade not in multivector");
+         }
+         p = q;
+      }
+      while(p < end && (is_text_separator(*p) || *p=='\r')) ++p;
+      if(p < end && *p != '\n') throw text_error(line, "expected " + std::to_string(columns.size()) + " elements");
+      ++i;
+   }
+   return lines;
+}
+
+/// Parses text from is into batch a, input read in blocks into one buffer.
+template<typename CL, typename M, typename T, class R>
+std::size_t read_text(std::basic_istream<char, R>& is, multivector_array<CL, M, T>& a)
+{
+   std::vector<char> buffer;
+   std::size_t n = 0;
+   do {
+      buffer.resize(n + GAALET_TEXT_BLOCK);
+      is.read(&buffer[n], GAALET_TEXT_BLOCK);
+      n += is.gcount();
+   } while(is);
+   return parse_text(buffer.data(), buffer.data() + n, a);
+}
+
+} //end namespace gaalet
+
+#endif
@@ -3,51 +3,37 @@
 
 namespace gaalet {
 
-/// Routine (developed by MIT-members?) for fast counting of number of bits in a multivector element bitmap (equals grade of element)
+/// Number of bits in a multivector element bitmap (equals grade of element)
 template<conf_t u>
 struct BitCount
 {
-    //only for 32bit. For 64-bit numbers, we would have to add triples of octal digits and use modulus 1023. FIX IT!!!
-   static const conf_t value = (((u - ((u >> 1) & 033333333333) - ((u >> 2) & 011111111111))
-                                    + ((u - ((u >> 1) & 033333333333) - ((u >> 2) & 011111111111)) >> 3)) & 030707070707) % 63;
+   static const conf_t value = bit_count(u);
 };
 
-/// Template implementation of Dorst's canonical reordering for basis-nth-vector multiplication (represented by bitmaps)
-template<conf_t sum, conf_t b, conf_t a>
-struct CanonicalReorderingSum
-{
-   static const conf_t value = CanonicalReorderingSum<(sum + BitCount<(a&b)>::value), b, (a>>1)>::value;
-};
+/// Dorst's canonical reordering for basis-nth-vector multiplication (represented by bitmaps)
+constexpr conf_t canonical_reordering_sum(conf_t a, conf_t b) {
+   return a ? bit_count(a & b) + canonical_reordering_sum(a>>1, b) : 0;
+}
 
-template<conf_t sum, conf_t b>
-struct CanonicalReorderingSum<sum, b, 0>
-{
-   static const conf_t value = sum;
-};
+constexpr int canonical_reordering_sign(conf_t a, conf_t b) {
+   return ((canonical_reordering_sum(a>>1, b) & 1) == 0) ? 1 : -1;
+}
 
 template<conf_t a, conf_t b>
 struct CanonicalReorderingSign
 {
-   static const int value = ((CanonicalReorderingSum<0, b, (a>>1)>::value & 1) == 0) ? 1 : -1;
+   static const int value = canonical_reordering_sign(a, b);
 };
 
 //Power
+constexpr int power(int v, conf_t n) {
+   return n ? v*power(v, n-1) : 1;
+}
+
 template <int V, conf_t N>
 struct Power
 {
-   static const int value = V*Power<V, N-1>::value;
-};
-
-template <int V>
-struct Power<V, 1>
-{
-   static const int value = V;
-};
-
-template <int V>
-struct Power<V, 0>
-{
-   static const int value = 1;
+   static const int value = power(V, N);
 };
 
 
@@ -0,0 +1,288 @@
+#ifndef __GAALET_VERSOR_MAP_H
+#define __GAALET_VERSOR_MAP_H
+
+#include "sandwich.h"
+#include "reverse.h"
+
+#include <cmath>
+
+namespace gaalet
+{
+
+namespace sw
+{
+
+//blades of grade G in an algebra of dimension N
+template<conf_t G, conf_t N, conf_t count = (conf_t(1)<<N), typename list = cl_null>
+struct grade_clist
+{
+   typedef typename grade_clist<G, N, count-1,
+                                typename std::conditional<(BitCount<count-1>::value==G), configuration_list<count-1, list>, list>::type
+                               >::clist clist;
+};
+template<conf_t G, conf_t N, typename list>
+struct grade_clist<G, N, 0, list>
+{
+   typedef list clist;
+};
+
+//bitmap of grades of target types
+template<class... T>
+struct target_grades;
+template<>
+struct target_grades<>
+{
+   static const conf_t value = 0;
+};
+template<class T, class... TT>
+struct target_grades<T, TT...>
+{
+   static const conf_t value = grade_bitmap<typename T::clist>::value | target_grades<TT...>::value;
+};
+
+//evaluation of dense matrix elements of grade configuration list CL: m_ck = quadratic form (c, k) in elements of v, scaled by s
+template<typename VCL, typename metric, typename CL, conf_t index = 0, bool end = (index==CL::size*CL::size)>
+struct grade_matrix_evaluation
+{
+   template<typename element_t, typename D, class V>
+   static void eval(D& data, const V& v, const element_t& s) {
+      typedef typename build_quadratic_form<get_element<index/CL::size, CL>::value, get_element<index%CL::size, CL>::value, VCL, metric>::type form;
+      std::get<index>(data) = quadratic_sum<form>::template eval<element_t, index_access>(v)*s;
+      grade_matrix_evaluation<VCL, metric, CL, index+1>::template eval<element_t>(data, v, s);
+   }
+};
+template<typename VCL, typename metric, typename CL, conf_t index>
+struct grade_matrix_evaluation<VCL, metric, CL, index, true>
+{
+   template<typename element_t, typename D, class V>
+   static void eval(D&, const V&, const element_t&) { }
+};
+
+//dense matrix of sandwich map on grade G (row-major, rows and columns in order of grade configuration list)
+template<typename VCL, typename metric, typename element_t, conf_t G, bool active>
+struct grade_matrix
+{
+   typedef typename grade_clist<G, metric::dimension>::clist clist;
+   static const conf_t size = clist::size;
+
+   template<class V>
+   void assign(const V& v, const element_t& s) {
+      grade_matrix_evaluation<VCL, metric, clist>::template eval<element_t>(data, v, s);
+   }
+
+   //return matrix element by row and column configuration
+   template<conf_t C, conf_t K>
+   const element_t& get() const {
+      return std::get<search_element<C, clist>::index*size + search_element<K, clist>::index>(data);
+   }
+
+   //return matrix element by row and column index, indices known at runtime
+   const element_t& operator()(const conf_t& row, const conf_t& column) const {
+      return data[row*size + column];
+   }
+
+protected:
+   std::array<element_t, size*size> data;
+};
+//grade not present in target types
+template<typename VCL, typename metric, typename element_t, conf_t G>
+struct grade_matrix<VCL, metric, element_t, G, false>
+{
+   typedef typename grade_clist<G, metric::dimension>::clist clist;
+   static const conf_t size = 0;
+
+   template<class V>
+   void assign(const V&, const element_t&) { }
+};
+
+//matrices of grades 0 to dimension
+template<typename VCL, typename metric, typename element_t, conf_t grades, conf_t G = 0, bool end = (G>metric::dimension)>
+struct grade_matrices : public grade_matrices<VCL, metric, element_t, grades, G+1>
+{
+   typedef grade_matrix<VCL, metric, element_t, G, ((grades>>G) & 1)> matrix_t;
+
+   template<class V>
+   void assign(const V& v, const element_t& s) {
+      matrix.assign(v, s);
+      grade_matrices<VCL, metric, element_t, grades, G+1>::assign(v, s);
+   }
+
+   matrix_t matrix;
+};
+template<typename VCL, typename metric, typename element_t, conf_t grades, conf_t G>
+struct grade_matrices<VCL, metric, element_t, grades, G, true>
+{
+   template<class V>
+   void assign(const V&, const element_t&) { }
+};
+
+} //end namespace sw
+
+
+template<class M, class X>
+struct versor_application;
+
+/// Precomputed map x -> v*x*v^{-1} of a versor v.
+/**
+ * The map induced on every grade present in the target types T is stored as a dense matrix (all grades if no target type is given).
+ * Applying the map is a matrix-vector product of fixed size.
+ */
+template<class V, class... T>
+struct versor_map
+{
+   typedef typename V::metric metric;
+
+   typedef typename V::element_t element_t;
+
+   typedef multivector<typename V::clist, metric, element_t> versor_t;
+
+   static const conf_t grades = (sizeof...(T)==0) ? ((conf_t(2)<<metric::dimension)-1) : sw::target_grades<T...>::value;
+
+   typedef sw::grade_matrices<typename V::clist, metric, element_t, grades> matrices_t;
+
+   template<class E>
+   versor_map(const expression<E>& v_) {
+      assign(v_);
+   }
+
+   //precomputation of map, reverse, inverse and norm
+   template<class E>
+   void assign(const expression<E>& v_) {
+      v = v_;
+      r = ~v;
+      element_t n = ((~v)*v).template element<0x00>();
+      element_t s = 1.0/n;
+      i = r*s;
+      using std::sqrt;
+      using std::fabs;
+      norm_value = sqrt(fabs(n));
+      matrices.assign(v, s);
+   }
+
+   const versor_t& versor() const {
+      return v;
+   }
+   const versor_t& reverse() const {
+      return r;
+   }
+   const versor_t& inverse() const {
+      return i;
+   }
+   const element_t& norm() const {
+      return norm_value;
+   }
+
+   //dense matrix of grade G
+   template<conf_t G>
+   const sw::grade_matrix<typename V::clist, metric, element_t, G, true>& matrix() const {
+      static_assert((grades>>G) & 1, "versor_map::matrix<G>(): grade not precomputed");
+      return static_cast<const sw::grade_matrices<typename V::clist, metric, element_t, grades, G>&>(matrices).matrix;
+   }
+
+   //matrix element of result element C and operand element K
+   template<conf_t C, conf_t K>
+   const element_t& coefficient() const {
+      static_assert(BitCount<C>::value==BitCount<K>::value, "versor_map::coefficient<C, K>(): elements of different grade");
+      return matrix<BitCount<C>::value>().template get<C, K>();
+   }
+
+   //application as expression
+   template<class X>
+   versor_application<versor_map, X> operator()(const expression<X>& x) const {
+      return versor_application<versor_map, X>(*this, x);
+   }
+
+   //application to a batch of multivectors
+   template<class InputIt, class OutputIt>
+   OutputIt apply(InputIt first, InputIt last, OutputIt out) const {
+      for(; first!=last; ++first, ++out) {
+         *out = (*this)(*first);
+      }
+      return out;
+   }
+
+protected:
+   versor_t v;
+   versor_t r;
+   versor_t i;
+   element_t norm_value;
+
+   matrices_t matrices;
+};
+
+template<class M, class X>
+struct versor_application : public expression<versor_application<M, X>>
+{
+   static_assert((M::grades & sw::grade_bitmap<typename X::clist>::value)==sw::grade_bitmap<typename X::clist>::value,
+                 "versor_map: grade of operand not precomputed");
+
+   typedef typename element_type_combination_traits<typename M::element_t, typename X::element_t>::element_t element_t;
+   typedef typename metric_combination_traits<typename M::metric, typename X::metric>::metric metric;
+
+   typedef sw::matrix_kernel<sw::sandwich_matrix<typename M::versor_t::clist, typename X::clist, metric>, sw::map_element> kernel;
+   typedef typename kernel::clist clist;
+
+   typedef typename sw::operand_storage<X, clist::size>::type x_storage_t;
+
+   versor_application(const M& m_, const X& x_)
+      :  m(m_), x(x_)
+   { }
+
+   template<conf_t conf>
+   element_t element() const {
+      return kernel::template element<conf, element_t>(m, x);
+   }
+
+   void init() {
+      x.init();
+   }
+
+   constexpr bool aliases(const void* d) const {
+      return x.aliases(d);
+   }
+
+   void bind_lane(std::size_t lane) {
+      x.bind_lane(lane);
+   }
+
+   //kernel evaluation, operand with multivector storage only
+   template<typename DCL, typename T, typename D>
+   void evaluate(D& data) const {
+      kernel::template evaluate<DCL, T>(data, m, storage_of(x));
+   }
+
+protected:
+   const M& m;
+   x_storage_t x;
+};
+
+template<class M, class X>
+struct evaluation_kernel<versor_application<M, X>>
+{
+   static const bool value = has_storage<typename std::remove_cv<typename std::remove_reference<typename versor_application<M, X>::x_storage_t>::type>::type>::value;
+};
+
+//state of operand storage
+template<class M, class X>
+struct has_state<versor_application<M, X>>
+{
+   static const bool value = has_state<typename std::remove_cv<typename std::remove_reference<typename versor_application<M, X>::x_storage_t>::type>::type>::value;
+};
+
+//cost model: matrix row of result element times elements of operand
+template<class M, class X, conf_t conf>
+struct element_cost<versor_application<M, X>, conf>
+{
+   typedef versor_application<M, X> E;
+
+   typedef typename sw::search_row_cost<conf, typename E::kernel::rows, sw::map_element, M, typename operand_type<typename E::x_storage_t>::type>::type type;
+};
+template<class M, class X>
+struct init_cost<versor_application<M, X>>
+{
+   typedef typename init_cost<typename operand_type<typename versor_application<M, X>::x_storage_t>::type>::type type;
+};
+
+} //end namespace gaalet
+
+#endif